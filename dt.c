@@ -31,6 +31,73 @@
  *
  * Modification History:
  *
+ * October 16th, 2026 by Robin T. Miller
+ *      Print %json keepalives without the message prefix.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Initialize the pattern file map lock with the other global locks.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Remove the unused subprocess command line (slices are threads).
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add tsfile= and tsinterval= options, for the job time series.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add hfile= option, for crash persistent history files, and the
+ * showhistory= command to decode them.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add enable=asynclog, for asynchronous thread log writes.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add enable=bufhuge, and release the thread aligned buffer cache
+ * when threads exit.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Map the showfslba offsets in batches, using the range translation.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Allow read/write and random/sequential percentages with AIO.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Allow SCSI I/O with AIO on Linux, via the asynchronous SCSI engine.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Allow NVMe I/O with AIO via the io_uring engine, which issues the
+ * NVMe commands as passthrough (see dturing.c).
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add enable=pfmap and enable=pfhuge, and share the mapped pattern
+ * file with cloned threads rather than copying it.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add rdist= option, for skewed random access distributions.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add stats=json, for the JSON statistics records.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Clear and free the per thread latency histograms.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add iochunk= option, records claimed per thread without the I/O lock.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add enable/disable=iotformula option, to verify IOT data by formula.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add enable/disable=aiounordered option, for AIO completion order.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add enable=uring and uring_flags= options for the io_uring engine.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Initialize the CRC-32 engine (slice-by-8 tables) at startup.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add enable/disable=simd option, for the vector pattern fill engine.
+ *
  * October 29th, by Robin T. Miller
  *      Adding parsing of latency options.
  * 
@@ -396,6 +463,8 @@ pthread_attr_t *tdattrp = &detached_thread_attrs;
 pthread_attr_t joinable_thread_attrs;
 pthread_attr_t *tjattrp = &joinable_thread_attrs;
 pthread_mutex_t print_lock;		/* Printing lock (sync output). */
+pthread_mutex_t log_ring_lock;		/* The log ring list lock.	*/
+pthread_mutex_t pfile_map_lock;		/* The pattern file map lock.	*/
 pthread_t ParentThread;			/* The parents' thread.		*/
 pthread_t iotuneThread;			/* The IO tuning thread.	*/
 pthread_t MonitorThread;		/* The monitoring thread.	*/
@@ -920,6 +989,8 @@ main(int argc, char **argv)
     (void)init_pthread_attributes(dip);
     (void)initialize_jobs_data(dip);
     initialize_workloads_data();
+    simd_initialize();
+    crc32_initialize();
 
     status = ProcessStartupScripts(dip);
 
@@ -2723,6 +2794,9 @@ create_thread_log(dinfo_t *dip)
 	    dinfo_t *odip = dip->di_output_dinfo;
 	    odip->di_ofp = odip->di_efp = fp;
 	}
+	if (dip->di_async_log == True) {
+	    (void)log_ring_create(dip);
+	}
     }
     return(status);
 }
@@ -2755,8 +2829,9 @@ do_show_fsmap(dinfo_t *dip)
     } else if (dip->di_fsmap_type == FSMAP_TYPE_LBA_RANGE) {
         Offset_t offset = dip->di_file_position;
         large_t data_limit = dip->di_data_limit;
-	uint64_t lba = NO_LBA;
+	uint64_t lbas[FSMAP_LBA_BATCH];
         hbool_t firstTime = True;
+	int count, index;
 
 	if (dip->di_record_limit != INFINITY) {
 	    data_limit = (dip->di_record_limit * dip->di_block_size);
@@ -2765,20 +2840,23 @@ do_show_fsmap(dinfo_t *dip)
             data_limit += offset;
 	}
 	for (; ((large_t)offset < data_limit) ;) {
-	    lba = os_map_offset_to_lba(dip, dip->di_fd, dip->di_dsize, offset);
-	    if (dip->di_fsmap == NULL) {
+	    count = (int)MIN(howmany((data_limit - offset), dip->di_block_size), FSMAP_LBA_BATCH);
+	    if (os_map_range_to_lba(dip, dip->di_fd, dip->di_dsize, offset,
+				    (uint32_t)dip->di_block_size, lbas, count) == FAILURE) {
         	break;
 	    }
 	    if (firstTime) {
 		firstTime = False;
 		Printf(dip, "%14s %14s\n", "File Offset", "Physical LBA");
 	    }
-	    if (lba == NO_LBA) {
-		Printf(dip, "%14llu %14s\n", offset, "<not mapped>");
-	    } else {
-		Printf(dip, "%14llu %14llu\n", offset, lba);
+	    for (index = 0; index < count; index++) {
+		if (lbas[index] == NO_LBA) {
+		    Printf(dip, "%14llu %14s\n", offset, "<not mapped>");
+		} else {
+		    Printf(dip, "%14llu %14llu\n", offset, lbas[index]);
+		}
+		offset += dip->di_block_size;
 	    }
-            offset += dip->di_block_size;
 	}
     }
     status = (*dip->di_funcs->tf_close)(dip);
@@ -3439,6 +3517,14 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	    }
 	    continue;
 	}
+#if defined(AIO) && defined(URING)
+	if (match (&string, "uring_flags=")) {
+	    if (parse_uring_flags(dip, string) == FAILURE) {
+		return ( HandleExit(dip, FAILURE) );
+	    }
+	    continue;
+	}
+#endif /* defined(AIO) && defined(URING) */
 	if (match (&string, "alarm=")) {
 	    dip->di_alarmtime = time_value(dip, string);
 	    continue;
@@ -3782,6 +3868,19 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	    }
 	    continue;
 	}
+	if ( match(&string, "hfile=") || match(&string, "history_file=") ) {
+	    if (dip->di_history_file) {
+		FreeStr(dip, dip->di_history_file);
+		dip->di_history_file = NULL;
+	    }
+	    if (*string) {
+		dip->di_history_file = strdup(string);
+		if (dip->di_history_size == 0) {
+		    dip->di_history_size = DEFAULT_HISTORY_FILE_ENTRIES;
+		}
+	    }
+	    continue;
+	}
 	if (match (&string, "lba=")) {
 	    dip->di_lbdata_flag = True;
 	    dip->di_lbdata_addr = number(dip, string, ANY_RADIX, &status, True);
@@ -4229,6 +4328,16 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	    }
 	    continue;
 	}
+	if (match (&string, "rdist=")) {
+	    status = parse_random_distribution(dip, string);
+	    if (status == FAILURE) {
+		return ( HandleExit(dip, status) );
+	    }
+	    if (dip->di_rdist.rd_type != RDIST_UNIFORM) {
+		dip->di_io_type = RANDOM_IO;
+	    }
+	    continue;
+	}
 	if (match (&string, "rlimit=")) {
 	    dip->di_io_type = RANDOM_IO;
 	    dip->di_rdata_limit = large_number(dip, string, ANY_RADIX, &status, True);
@@ -4259,10 +4368,28 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		goto eloop;
 	    if (*string == '\0')
 		continue;
+#if defined(AIO)
+	    if (match(&string, "aiounordered")) {
+		dip->di_aio_flag = True;
+		dip->di_aio_unordered = True;
+		goto eloop;
+	    }
+#endif /* defined(AIO) */
 	    if (match(&string, "aio")) {
 		dip->di_aio_flag = True;
 		goto eloop;
 	    }
+#if defined(AIO) && defined(URING)
+	    if (match(&string, "uring")) {
+		dip->di_aio_flag = True;
+		dip->di_uring_flag = True;
+		goto eloop;
+	    }
+#endif /* defined(AIO) && defined(URING) */
+	    if (match(&string, "asynclog")) {
+		dip->di_async_log = True;
+		goto eloop;
+	    }
 	    if (match(&string, "async")) {
 		dip->di_async_job = True;
 		goto eloop;
@@ -4349,6 +4476,10 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		dip->di_image_copy = True;
 		goto eloop;
 	    }
+	    if (match(&string, "iotformula")) {
+		dip->di_iot_formula = True;
+		goto eloop;
+	    }
 	    if (match(&string, "iolock")) {
 		dip->di_iolock = True;
 		dip->di_fileperthread = False;
@@ -4671,6 +4802,22 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		sighup_flag = True;
 		goto eloop;
 	    }
+	    if (match(&string, "simd")) {
+		dip->di_simd_flag = True;
+		goto eloop;
+	    }
+	    if (match(&string, "bufhuge")) {
+		dip->di_bufhuge_flag = True;
+		goto eloop;
+	    }
+	    if (match(&string, "pfhuge")) {
+		dip->di_pfhuge_flag = True;
+		goto eloop;
+	    }
+	    if (match(&string, "pfmap")) {
+		dip->di_pfmap_flag = True;
+		goto eloop;
+	    }
 	    /* Windows specific, but parse for inclusion in workloads for all OS's. */
 	    if (match(&string, "prealloc")) {
 		dip->di_prealloc_flag = True;
@@ -4735,10 +4882,26 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		goto dloop;
 	    if (*string == '\0')
 		continue;
+#if defined(AIO)
+	    if (match(&string, "aiounordered")) {
+		dip->di_aio_unordered = False;
+		goto dloop;
+	    }
+#endif /* defined(AIO) */
 	    if (match(&string, "aio")) {
 		dip->di_aio_flag = False;
 		goto dloop;
 	    }
+#if defined(AIO) && defined(URING)
+	    if (match(&string, "uring")) {
+		dip->di_uring_flag = False;
+		goto dloop;
+	    }
+#endif /* defined(AIO) && defined(URING) */
+	    if (match(&string, "asynclog")) {
+		dip->di_async_log = False;
+		goto dloop;
+	    }
 	    if (match(&string, "async")) {
 		dip->di_async_job = False;
 		goto dloop;
@@ -5115,6 +5278,26 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		dip->di_spad_check = False;
 		goto dloop;
 	    }
+	    if (match(&string, "simd")) {
+		dip->di_simd_flag = False;
+		goto dloop;
+	    }
+	    if (match(&string, "bufhuge")) {
+		dip->di_bufhuge_flag = False;
+		goto dloop;
+	    }
+	    if (match(&string, "pfhuge")) {
+		dip->di_pfhuge_flag = False;
+		goto dloop;
+	    }
+	    if (match(&string, "pfmap")) {
+		dip->di_pfmap_flag = False;
+		goto dloop;
+	    }
+	    if (match(&string, "iotformula")) {
+		dip->di_iot_formula = False;
+		goto dloop;
+	    }
 //#if defined(WIN32)
 	    /* Windows specific, but parse for inclusion in workloads for all OS's. */
 	    if (match(&string, "prealloc")) {
@@ -5396,6 +5579,23 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	    }
 	    continue;
         }
+	if (match (&string, "tsfile=")) {
+	    if (dip->di_ts_file) {
+		FreeStr(dip, dip->di_ts_file);
+		dip->di_ts_file = NULL;
+	    }
+	    if (*string) {
+		dip->di_ts_file = strdup(string);
+	    }
+	    continue;
+	}
+	if (match (&string, "tsinterval=")) {
+	    dip->di_ts_interval = (uint32_t)number(dip, string, ANY_RADIX, &status, True);
+	    if (status == FAILURE) {
+		return ( HandleExit(dip, status) );
+	    }
+	    continue;
+	}
 	if ( match(&string, "jlog=") || match(&string, "job_log=") ) {
 	    if (dip->di_job_log) {
 		FreeStr(dip, dip->di_job_log);
@@ -5550,6 +5750,13 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	   }
 	   continue;
 	}
+	if (match (&string, "iochunk=")) {
+	    dip->di_iochunk = (u_int)number(dip, string, ANY_RADIX, &status, True);
+	    if (status == FAILURE) {
+		return ( HandleExit(dip, status) );
+	    }
+	    continue;
+	}
 	if (match (&string, "iodir=")) {
 	    /* Note: iodir={reverse|vary} are special forms of random I/O! */
 	    if (match (&string, "for")) {
@@ -6119,12 +6326,14 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 		dip->di_stats_level = STATS_BRIEF;
 	    } else if (match (&string, "full")) {
 		dip->di_stats_level = STATS_FULL;
+	    } else if (match (&string, "json")) {
+		dip->di_stats_level = STATS_JSON;
 	    } else if (match (&string, "none")) {
 		dip->di_pstats_flag = dip->di_stats_flag = dip->di_job_stats_flag = False;
 		dip->di_stats_level = STATS_NONE;
 		dip->di_verbose_flag = False; /* To overcome compatability check in report_pass()! */
 	    } else {
-		Eprintf(dip, "Valid stat levels are: 'brief', 'full', or 'none'\n");
+		Eprintf(dip, "Valid stat levels are: 'brief', 'full', 'json', or 'none'\n");
 		return ( HandleExit(dip, FAILURE) );
 	    }
 	    continue;
@@ -6631,6 +6840,10 @@ parse_args(dinfo_t *dip, int argc, char **argv)
 	    dip->di_fsmap_type = FSMAP_TYPE_MAP_EXTENTS;
             continue;
 	}
+	if (match (&string, "showhistory=")) {
+	    status = show_history_file(dip, string);
+	    return ( HandleExit(dip, status) );
+	}
 	if (match (&string, "showtime=")) {
 	    char time_buffer[TIME_BUFFER_SIZE];
 	    time_t time_value = (time_t)number(dip, string, ANY_RADIX, &status, True);
@@ -7306,7 +7519,7 @@ keepalive_alarm(dinfo_t *dip)
 	 ((current_time - dip->di_last_keepalive) >= dip->di_keepalive_time) ) {
 	dip->di_last_keepalive = current_time;
         (void)FmtKeepAlive(dip, dip->di_keepalive, buffer);
-	LogMsg(dip, dip->di_ofp, logLevelLog, 0, "%s\n", buffer);
+	LogMsg(dip, dip->di_ofp, logLevelLog, KeepAliveFlags(dip->di_keepalive), "%s\n", buffer);
     }
 
     /*
@@ -7590,6 +7803,7 @@ finish_exiting(dinfo_t *dip, int exit_status)
 	    Printf(dip, "Program is exiting with status %d...\n", exit_status);
 	}
     }
+    log_ring_flush_all();
     if (dip->di_log_file && dip->di_log_opened) {
 	(void)fclose(dip->di_efp);
     }
@@ -7608,6 +7822,7 @@ handle_thread_exit(dinfo_t *dip)
     if (debug_flag || tDebugFlag) {
 	Printf(dip, "Thread "OS_TID_FMT" is exiting...\n", (os_tid_t)pthread_self() );
     }
+    free_palign_cache(dip);
     pthread_exit(dip);
     return;
 }
@@ -8019,6 +8234,12 @@ init_pthread_attributes(dinfo_t *dip)
     if ( (status = pthread_mutex_init(&print_lock, NULL)) != SUCCESS) {
 	tPerror(NULL, status, "pthread_mutex_init() of print lock failed!");
     }
+    if ( (status = pthread_mutex_init(&log_ring_lock, NULL)) != SUCCESS) {
+	tPerror(NULL, status, "pthread_mutex_init() of log ring lock failed!");
+    }
+    if ( (status = pthread_mutex_init(&pfile_map_lock, NULL)) != SUCCESS) {
+	tPerror(NULL, status, "pthread_mutex_init() of pattern file map lock failed!");
+    }
     return (status);
 }
 
@@ -8663,6 +8884,9 @@ init_device_defaults(dinfo_t *dip)
     dip->di_ofp = ofp; // = stdout;
     dip->di_async_job = False;
     dip->di_btag_flag = False;
+    dip->di_simd_flag = True;
+    dip->di_pfmap_flag = True;
+    dip->di_iot_formula = True;
     dip->di_data_limit = INFINITY;
     dip->di_max_limit = 0;
     dip->di_min_limit = 0;
@@ -8754,6 +8978,7 @@ init_device_defaults(dinfo_t *dip)
 #if defined(AIO)
     /* Asynchronous I/O */
     dip->di_aio_bufs = AIO_BUFS;
+    dip->di_uring_flags = URING_DEFAULT_FLAGS;
 #endif /* !defined(AIO) */
     dip->di_aio_flag = False;
     dip->di_align_offset = 0;
@@ -9042,6 +9267,12 @@ cleanup_device(dinfo_t *dip, hbool_t master)
     if (dip->di_pattern_buffer) {
 	reset_pattern(dip);
     }
+    if (dip->di_fill_engine) {
+	free_fill_engine(dip);
+    }
+    if (dip->di_read_histogram || dip->di_write_histogram) {
+	free_latency_histograms(dip);
+    }
     if ((master == False) && dip->di_stderr_buffer) {
 	Free(dip, dip->di_stderr_buffer);
 	dip->di_stderr_buffer = NULL;
@@ -9069,10 +9300,6 @@ cleanup_device(dinfo_t *dip, hbool_t master)
 	FreeStr(dip, dip->di_cmd_line);
 	dip->di_cmd_line = NULL;
     }
-    if (dip->di_dtcmd) {
-	FreeStr(dip, dip->di_dtcmd);
-	dip->di_dtcmd = NULL;
-    }
     if (dip->di_prefix_string) {
 	FreeStr(dip, dip->di_prefix_string);
 	dip->di_prefix_string = NULL;
@@ -9183,11 +9410,16 @@ cleanup_device(dinfo_t *dip, hbool_t master)
 	FreeStr(dip, dip->di_job_log);
 	dip->di_job_log = NULL;
     }
+    if (dip->di_ts_file) {
+	FreeStr(dip, dip->di_ts_file);
+	dip->di_ts_file = NULL;
+    }
     /* 
      * Note: Done last, since may be writing to master log file. 
      */
     if (dip->di_log_file) {
 	if (dip->di_log_opened == True) {
+	    log_ring_close(dip);
 	    if ( fclose(dip->di_efp) != SUCCESS) {
 		Perror(dip, "fclose() of %s failed...\n", dip->di_log_file);
 	    }
@@ -9258,6 +9490,7 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
 	cdip->di_ofp = stdout;
 	cdip->di_efp = stderr;
     }
+    cdip->di_log_ring = NULL;
     if (dip->di_array) {
 	cdip->di_array = strdup(dip->di_array);
     }
@@ -9297,6 +9530,9 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
     if (dip->di_job_log) {
 	cdip->di_job_log = strdup(dip->di_job_log);
     }
+    if (dip->di_ts_file) {
+	cdip->di_ts_file = strdup(dip->di_ts_file);
+    }
     if (dip->di_log_dir) {
 	cdip->di_log_dir = strdup(dip->di_log_dir);
     }
@@ -9318,7 +9554,11 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
 	cdip->di_msg_buffer = (char *)Malloc(dip, dip->di_log_bufsize);
     }
 #endif /* 0 */
-    if (dip->di_pattern_buffer) {
+    if (dip->di_pattern_mapped) {
+	/* The pattern file mapping is read-only, so share it. */
+	hold_pattern_file(dip, dip->di_pattern_buffer);
+	setup_pattern(cdip, dip->di_pattern_buffer, dip->di_pattern_bufsize, True);
+    } else if (dip->di_pattern_buffer) {
 	uint8_t *buffer = malloc_palign(dip, dip->di_pattern_bufsize, 0);
 	memcpy(buffer, dip->di_pattern_buffer, dip->di_pattern_bufsize);
 	setup_pattern(cdip, buffer, dip->di_pattern_bufsize, True);
@@ -9332,6 +9572,12 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
 	/* Note: This gets allocated after threads start! */
 	cdip->di_btag = NULL;
     }
+    /* Note: The fill engine is per thread, and allocated when first used. */
+    cdip->di_fill_engine = NULL;
+    /* Note: The latency histograms are per thread too (allocated when used). */
+    cdip->di_read_histogram = cdip->di_write_histogram = NULL;
+    /* Note: The hot set coverage is per thread too. */
+    cdip->di_rdist.rd_samples = cdip->di_rdist.rd_hot_hits = 0;
     if (dip->di_base_buffer) {
 	/* These will get allocated during initialization. */
 	cdip->di_base_buffer = cdip->di_data_buffer = NULL;
@@ -9339,6 +9585,12 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
 #if defined(AIO)
 	    /* New AIO buffers please! */
 	    cdip->di_acbs = NULL;
+	    cdip->di_uring = NULL;
+	    cdip->di_aio_list = NULL;
+	    cdip->di_aio_wmap = NULL;
+# if defined(SCSI)
+	    cdip->di_scsi_aio = NULL;
+# endif /* defined(SCSI) */
 #endif /* defined(AIO) */
 	    /* Note: For AIO, this allocates data buffers! */
 	    status = (*cdip->di_funcs->tf_initialize)(cdip);
@@ -9350,9 +9602,6 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
     if (dip->di_cmd_line) {
 	cdip->di_cmd_line = strdup(dip->di_cmd_line);
     }
-    if (dip->di_dtcmd) {
-	cdip->di_dtcmd = strdup(dip->di_dtcmd);
-    }
     if (dip->di_prefix_string) {
 	cdip->di_prefix_string = strdup(dip->di_prefix_string);
     }
@@ -9419,6 +9668,11 @@ clone_device(dinfo_t *dip, hbool_t master, hbool_t new_context)
     /*
      * History Data: 
      */ 
+    cdip->di_history_map = NULL;
+    cdip->di_history_map_size = 0;
+    if (dip->di_history_file) {
+	cdip->di_history_file = strdup(dip->di_history_file);
+    }
     if (dip->di_history_size) {
 	SetupHistoryData(cdip);
     }
@@ -9573,10 +9827,10 @@ do_datatest_validate(dinfo_t *dip)
 	    dip->di_output_file = NULL;
 	    dip->di_read_percentage = 0;
 	}
-	if ( ((dip->di_aio_flag == True) || (dip->di_mmap_flag == True)) &&
+	if ( (dip->di_mmap_flag == True) &&
 	      (dip->di_read_percentage || dip->di_random_percentage ||
 	       dip->di_random_rpercentage || dip->di_random_wpercentage) ) {
-	    Wprintf(dip, "Percentage options are NOT support with AIO/MMAP I/O, so disabling!\n");
+	    Wprintf(dip, "Percentage options are NOT support with MMAP I/O, so disabling!\n");
 	    dip->di_read_percentage = 0;
 	    dip->di_random_percentage = 0;
 	    dip->di_random_rpercentage = 0;
@@ -9584,6 +9838,10 @@ do_datatest_validate(dinfo_t *dip)
 	}
 	if (dip->di_read_percentage || dip->di_random_wpercentage) {
 	    dip->di_raw_flag = True; /* Force read/write access! */
+	} else if ( (dip->di_aio_flag == True) &&
+		    (dip->di_random_percentage || dip->di_random_rpercentage) ) {
+	    /* The AIO read pass does not replay the percentages, so verify as we go. */
+	    dip->di_raw_flag = True;
 	}
 	if (dip->di_read_percentage || dip->di_random_percentage ||
 	    dip->di_random_rpercentage || dip->di_random_wpercentage) {
@@ -10005,10 +10263,31 @@ do_common_device_setup(dinfo_t *dip)
 	Eprintf(dip, "NVMe/SCSI operations are disabled, so pass-thru I/O is NOT possible!\n");
 	return(FAILURE);
     }
-    if ( (dip->di_aio_flag == True) &&
-	 ( (dip->di_nvme_io_flag == True) || (dip->di_scsi_io_flag == True) ) ) {
-	Eprintf(dip, "NVMe/SCSI I/O and Asynchronous I/O (AIO) is NOT supported!\n");
+    if ( (dip->di_aio_flag == True) && (dip->di_scsi_io_flag == True) ) {
+#if defined(AIO) && defined(__linux__)
+	/* SCSI commands are queued via the sg driver (see dtscsi.c). */
+# if defined(URING)
+	if (dip->di_uring_flag == True) {
+	    Wprintf(dip, "The io_uring engine is NOT used with SCSI I/O, disabling!\n");
+	    dip->di_uring_flag = False;
+	}
+# endif /* defined(URING) */
+#else /* !(defined(AIO) && defined(__linux__)) */
+	Eprintf(dip, "SCSI I/O and Asynchronous I/O (AIO) is NOT supported!\n");
+	return(FAILURE);
+#endif /* defined(AIO) && defined(__linux__) */
+    }
+    if ( (dip->di_aio_flag == True) && (dip->di_nvme_io_flag == True) ) {
+#if defined(AIO) && defined(URING)
+	/* NVMe passthrough is done by the io_uring engine (see dturing.c). */
+	if (dip->di_uring_flag == False) {
+	    Eprintf(dip, "NVMe I/O with Asynchronous I/O (AIO) requires the io_uring engine (enable=uring)!\n");
+	    return(FAILURE);
+	}
+#else /* !(defined(AIO) && defined(URING)) */
+	Eprintf(dip, "NVMe I/O and Asynchronous I/O (AIO) is NOT supported!\n");
 	return(FAILURE);
+#endif /* defined(AIO) && defined(URING) */
     }
     if (dip->di_tscsi_dsf) {
 	(void)init_scsi_trigger(dip, dip->di_tscsi_dsf, &dip->di_tsgp);
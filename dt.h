@@ -111,6 +111,35 @@
  */
 #define TIMESTAMP       1
 
+/*
+ * Vector (SIMD) Support: (see dtsimd.c)
+ *
+ * Note: The vector kernels are selected at runtime via CPU detection, so
+ * no special compile options are required. Define NOSIMD to disable them.
+ */
+#if !defined(NOSIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define SIMD_X86	1
+#endif /* !defined(NOSIMD) && defined(__GNUC__) && x86 */
+
+#define SIMD_ENVNAME		"DT_SIMD"	/* Restrict the SIMD type.	*/
+#define SIMD_PATTERN_SPAN	32		/* Widest vector store (bytes).	*/
+#define SIMD_CRC_MINIMUM	64		/* Minimum CRC fold size (bytes). */
+
+typedef enum simd_type {SIMD_NONE = 0, SIMD_SSE2 = 1, SIMD_AVX2 = 2} simd_type_t;
+
+/*
+ * Linux io_uring AIO Engine Flags: (see dturing.c)
+ */
+#define URING_FIXED_BUFS	0x01		/* Register the AIO buffers.	*/
+#define URING_FIXED_FILES	0x02		/* Register the file descriptor. */
+#define URING_SQPOLL		0x04		/* Submission queue polling.	*/
+#define URING_DEFAULT_FLAGS	(URING_FIXED_BUFS | URING_FIXED_FILES)
+
+/*
+ * Asynchronous SCSI I/O: (see dtscsi.c)
+ */
+#define SCSI_AIO_MAX_QUEUE	16		/* The sg driver queue limit.	*/
+
 /* TODO: Cleanup this junk! Really still needed? */
 #if !defined(HZ)
 /* now included above! */
@@ -250,6 +279,11 @@
 #define ScriptExtension          ".dt"
 
 #define AIO_BUFS	8			/* Default number AIO buffers.	*/
+#if defined(WIN32)
+#  define AIO_NotQed	INVALID_HANDLE_VALUE
+#else /* !defined(WIN32) */
+#  define AIO_NotQed	-1			/* AIO request not queued flag.	*/
+#endif /* defined(WIN32) */
 #define IOT_SEED	0x01010101		/* Default seed for IOT pattern	*/
 #define RETRY_DELAY	5			/* Default retry delay (secs).	*/
 #define RETRY_ENTRIES	25			/* The number of retry errors.	*/
@@ -400,6 +434,28 @@ typedef enum {
 #  define LOG_BUFSIZE	DEF_LOG_BUFSIZE	/* The log file buffer size.	*/
 #endif /* defined(BUFSIZ) */
 
+/*
+ * Asynchronous Log Ring:
+ *
+ * With enable=asynclog, messages for a thread log are copied into a ring
+ * owned by that thread, and a background writer drains all rings. Only the
+ * owning thread adds messages (head), while drains are serialized by the
+ * ring lock (tail), so adding messages never blocks on the writer. When the
+ * ring is full, or an error is logged, the thread drains its ring itself.
+ */
+#define LOG_RING_SIZE		(256 * KBYTE_SIZE) /* Ring size (power of 2).	*/
+#define LOG_RING_INTERVAL	50		/* Writer interval (msecs).	*/
+
+typedef struct log_ring {
+    struct log_ring *lr_next;		/* The next ring on writer list.*/
+    FILE	*lr_fp;			/* The thread log file stream.	*/
+    char	*lr_buffer;		/* The ring message buffer.	*/
+    size_t	lr_size;		/* The ring buffer size.	*/
+    volatile uint64_t lr_head;		/* The producer byte position.	*/
+    volatile uint64_t lr_tail;		/* The consumer byte position.	*/
+    pthread_mutex_t lr_lock;		/* Serializes ring draining.	*/
+} log_ring_t;
+
 #if defined(SCSI)
 #  include "libscsi.h"
 #  include "inquiry.h"
@@ -480,6 +536,7 @@ typedef enum fsmap_type {
     FSMAP_TYPE_LBA_RANGE = 1,
     FSMAP_TYPE_MAP_EXTENTS
 } fsmap_type_t;
+#define FSMAP_LBA_BATCH	256	/* Offsets mapped per range lookup. */
 
 /*
  * History Information:
@@ -497,6 +554,29 @@ typedef struct history {
 
 #define DEFAULT_HISTORY_BUFFERS		1
 #define DEFAULT_HISTORY_DATA_SIZE	32
+#define DEFAULT_HISTORY_FILE_ENTRIES	65536	/* With a history file.	*/
+
+/*
+ * Pattern Fill Engine:
+ *
+ * The pattern is replicated into a span, so any pattern phase can be copied
+ * with large copies (or vector stores), rather than a byte at a time. When
+ * btags and/or a prefix string are enabled, each lbdata block is built once
+ * as a template (btag hole, prefix, pattern), then stamped into the buffer.
+ * Note: The per block fields (btag, lbdata, timestamp) are updated later.
+ */
+#define FILL_SPAN_SIZE		4096		/* Replicated pattern span size.*/
+
+typedef struct fill_engine {
+    size_t	fe_pattern_size;		/* The pattern size (period).	*/
+    uint8_t	*fe_span;			/* The replicated pattern span.	*/
+    size_t	fe_span_size;			/* The span allocation size.	*/
+    uint8_t	*fe_template;			/* The lbdata block template.	*/
+    size_t	fe_template_size;		/* The template size (lbdata).	*/
+    size_t	fe_template_phase;		/* The template pattern phase.	*/
+    size_t	fe_hole_size;			/* The btag hole size.		*/
+    size_t	fe_prefix_size;			/* The prefix size (template).	*/
+} fill_engine_t;
 
 /*
  * The operation type is used with no-progress option to report operation.
@@ -515,6 +595,48 @@ typedef struct optiming {
 /* Note: This table *must* be kept in sync with the above definitions! */
 extern optiming_t optiming_table[];
 
+/*
+ * Latency Histogram: (see dtlatency.c)
+ *
+ * Log-linear buckets, in microseconds, where values below 2 * sub-buckets
+ * are exact, then each power of two is split into sub-buckets, so the
+ * bucket width is always less than 1/32 (3.1%) of the value recorded.
+ */
+#define LATENCY_SUB_BITS	5
+#define LATENCY_SUB_BUCKETS	(1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS		((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+typedef struct latency_histogram {
+    uint64_t	lh_count;			/* The latency samples.	    */
+    uint64_t	lh_max_latency;			/* The maximum latency.	    */
+    uint64_t	lh_buckets[LATENCY_BUCKETS];	/* The latency buckets.	    */
+} latency_histogram_t;
+
+#define LATENCY_PERCENTILES	5	/* The percentiles reported.	*/
+
+#define DEFAULT_TS_INTERVAL	1000	/* Time series interval (ms).	*/
+
+/*
+ * Random Access Distributions: (see dtdist.c)
+ */
+typedef enum rdist_type {
+    RDIST_UNIFORM, RDIST_ZIPF, RDIST_PARETO, RDIST_HOTCOLD, RDIST_NORMAL
+} rdist_type_t;
+
+typedef struct random_dist {
+    rdist_type_t rd_type;		/* The distribution type.	    */
+    double	rd_param;		/* theta, h, hot %, or stddev %.    */
+    double	rd_hot_io;		/* The hotcold I/O percentage.	    */
+    /* Per range constants (recomputed when the range changes). */
+    uint64_t	rd_items;		/* The items (blocks) in range.	    */
+    uint64_t	rd_hot_begin;		/* The first hot set item.	    */
+    uint64_t	rd_hot_items;		/* The hot set items.		    */
+    double	rd_hx1, rd_hxn, rd_s;	/* The sampling constants.	    */
+    /* Hot set coverage statistics. */
+    uint64_t	rd_samples;		/* The indexes selected.	    */
+    uint64_t	rd_hot_hits;		/* The indexes in the hot set.	    */
+} random_dist_t;
+
 extern char *miscompare_op;
 
 /*
@@ -534,7 +656,7 @@ extern char *miscompare_op;
         } 
 
 typedef enum sleep_resolution {SLEEP_DEFAULT, SLEEP_SECS, SLEEP_MSECS, SLEEP_USECS} sleepres_t;
-typedef enum statslevel {STATS_BRIEF, STATS_FULL, STATS_NONE} statslevel_t;
+typedef enum statslevel {STATS_BRIEF, STATS_FULL, STATS_NONE, STATS_JSON} statslevel_t;
 typedef enum stats_value {ST_BYTES, ST_BLOCKS, ST_FILES, ST_RECORDS, ST_OFFSET} stats_value_t;
 
 typedef enum trigger_control {
@@ -700,19 +822,6 @@ typedef struct dtype {
 
 #define PROC_ALLOC (sizeof(pid_t) * 3)	/* Extra allocation for PID.	*/
 
-/*
- * Definitions for Multiple Processes:
- */
-typedef struct dt_procs {
-	pid_t	dt_pid;			/* The child process ID.	*/
-	int	dt_status;		/* The child exit status.	*/
-	hbool_t	dt_active;		/* The process active flag.	*/
-	char	*dt_device;		/* The process target device.	*/
-#if defined(WIN32)
-	PROCESS_INFORMATION *dt_pip;	/* Process information.		*/
-#endif /* defined(WIN32) */
-} dt_procs_t;
-
 /*
  * Slice Range Definition:
  */
@@ -762,6 +871,8 @@ typedef struct dinfo {
 	os_ino_t di_inode;		/* The file system i-node number*/
 	char	*di_error_file;		/* File name to write errors.	*/
 	hbool_t	di_log_opened;		/* Flag to tell log file open.	*/
+	hbool_t	di_async_log;		/* Asynchronous thread logging.	*/
+	log_ring_t *di_log_ring;	/* The thread log message ring.	*/
 	hbool_t	di_script_verify;	/* Flag to control script echo. */
 	hbool_t	di_stdin_flag;		/* Flag reading from stdin.	*/
 	hbool_t	di_stdout_flag;		/* Flag writing to stdout.	*/
@@ -812,6 +923,9 @@ typedef struct dinfo {
 	vbool_t	di_fsfull_restart;	/* Restart writes on FS full.	*/
 	hbool_t	di_flushing;		/* The file is being flushed.	*/
 	hbool_t di_iolock;		/* The I/O lock control flag.	*/
+	u_int	di_iochunk;		/* Records claimed per thread.	*/
+	large_t	di_iochunk_next;	/* Next claimed data position.	*/
+	large_t	di_iochunk_end;		/* End of the claimed data.	*/
 	u_int32	di_dsize;		/* The device block size.	*/
 	u_int32	di_rdsize;		/* The real device block size.	*/
         u_int   di_qdepth;              /* The device queue depth.      */
@@ -1012,6 +1126,9 @@ typedef struct dinfo {
 	int	di_history_index;	/* Index to next history entry.	*/
 	int	di_history_data_size;	/* Request data size to save.	*/
 	history_t *di_history;		/* Array of history entries.	*/
+	char	*di_history_file;	/* The history file name.	*/
+	void	*di_history_map;	/* The mapped history file.	*/
+	size_t	di_history_map_size;	/* The history file map size.	*/
 	/*
 	 * Data Pattern Related Information:
 	 */
@@ -1022,6 +1139,10 @@ typedef struct dinfo {
 	lbdata_t di_lbdata_size;	/* Logical block data size.	*/
 	lbdata_t di_iot_seed;		/* The default IOT seed value.	*/
 	lbdata_t di_iot_seed_per_pass;	/* The per pass IOT seed value.	*/
+	hbool_t	di_iot_formula;		/* Verify IOT data by formula.	*/
+	hbool_t	di_iot_deferred;	/* Expected IOT data deferred.	*/
+	lbdata_t di_iot_deferred_lba;	/* The deferred starting lba.	*/
+	size_t	di_iot_deferred_count;	/* The deferred byte count.	*/
         /*
          * I/O Latency Information:
          */
@@ -1040,6 +1161,15 @@ typedef struct dinfo {
         uint64_t di_write_latency_ios;  /* The write latency I/O's.     */
         uint64_t di_max_write_latency;  /* Maximum write latency.       */
         uint64_t di_min_write_latency;  /* Minimum write latency.       */
+        latency_histogram_t *di_read_histogram;  /* Read latencies.     */
+        latency_histogram_t *di_write_histogram; /* Write latencies.    */
+        uint64_t di_io_read_bytes;      /* Total bytes read (all passes).*/
+        uint64_t di_io_write_bytes;     /* Total bytes written.         */
+	/*
+	 * Time Series Information: (see dtseries.c)
+	 */
+	char	*di_ts_file;		/* The time series file name.	*/
+	uint32_t di_ts_interval;	/* The sample interval (ms).	*/
 
 	/*
 	 * No-progress (noprog) Information:
@@ -1069,6 +1199,12 @@ typedef struct dinfo {
 	int	di_pattern_strsize;	/* The pattern string size.	*/
 	int	di_pattern_index;	/* The pass pattern index.	*/
 	hbool_t	di_pattern_in_buffer;	/* Full pattern is in buffer.	*/
+	hbool_t	di_simd_flag;		/* Vector (SIMD) kernels flag.	*/
+	hbool_t	di_pfmap_flag;		/* Map pattern files shared.	*/
+	hbool_t	di_pfhuge_flag;		/* Pattern file huge pages.	*/
+	hbool_t	di_bufhuge_flag;	/* Data buffer huge pages.	*/
+	hbool_t	di_pattern_mapped;	/* Pattern buffer is mapped.	*/
+	fill_engine_t *di_fill_engine;	/* The pattern fill engine.	*/
 	/*
 	 * Prefix String Data (initial and formatted): 
 	 */
@@ -1143,8 +1279,6 @@ typedef struct dinfo {
 	struct tms di_etimes;		/* The end time.		*/
 	struct timeval di_gtod;		/* Current GTOD information.	*/
 	struct timeval di_ptod;		/* Previous GTOD information.	*/
-	pid_t	di_child_pid;		/* For the child process ID.	*/
-	int	di_child_status;	/* For child exit status.	*/
 
 #if defined(AIO)
 	/*
@@ -1168,8 +1302,21 @@ typedef struct dinfo {
 	u_long	di_aio_record_adjust;	/* # of tape record to adjust.	*/
 	
 	struct aiocb	*di_acbs;	/* Pointer to AIO control blocks. */
+	struct timeval	*di_aio_times;	/* The AIO request start times.   */
 	void		**di_aiobufs;	/* Pointer to base buffer addrs.  */
 	struct aiocb	*di_current_acb;/* Current acb for error reports. */
+	hbool_t		di_uring_flag;	/* Use the io_uring AIO engine.	  */
+	uint32_t	di_uring_flags;	/* The io_uring control flags.	  */
+	struct uring_info *di_uring;	/* The io_uring information.	  */
+	hbool_t		di_aio_unordered; /* Process AIO in completion order. */
+	hbool_t		di_aio_anyorder;  /* Unordered processing this pass.  */
+	struct aiocb	**di_aio_list;	/* The aio_suspend() request list. */
+	optype_t	*di_aio_optypes;  /* The AIO request operation types. */
+	hbool_t		*di_aio_vreads;	  /* Mixed reads which are verified.  */
+	hbool_t		di_aio_mixed;	  /* Mixed percentages this pass.     */
+	hbool_t		di_aio_mixed_verify; /* Verify the mixed read data.   */
+	uint8_t		*di_aio_wmap;	  /* Mixed I/O written block bitmap.  */
+	large_t		di_aio_wmap_blocks; /* The written bitmap blocks.     */
 	
 #else /* !defined(AIO) */
 	int	di_aio_bufs;		/* The number of AIO buffers.	*/
@@ -1280,6 +1427,7 @@ typedef struct dinfo {
 	u_long	di_skip_count;		/* # of input records to skip.	*/
 	u_long	di_seek_count;		/* # of output records to seek.	*/
 	Offset_t di_random_align;	/* Random I/O offset alignment.	*/
+	random_dist_t di_rdist;		/* Random access distribution.	*/
 	large_t	di_total_bytes;		/* Total bytes transferred.	*/
 	large_t di_total_bytes_read;	/* Total bytes read.		*/
 	large_t di_total_bytes_written;	/* Total bytes written.		*/
@@ -1380,18 +1528,9 @@ typedef struct dinfo {
 	/*
 	 * Multiple Process Information: 
 	 */
-	hbool_t	di_aborted_processes;	/* Processes have been aborted.	*/
-	char	*di_dtcmd;		/* Command line for subprocs.	*/
-#if defined(WIN32)
-	HANDLE	di_proc_handles[MAXIMUM_WAIT_OBJECTS]; /* for subprocs.	*/
-#endif /* defined(WIN32) */
 	pid_t	di_process_id;		/* The current process ID.	*/
-	struct dt_procs *di_ptable;	/* Multiple process table.	*/
 	int	di_num_devs;		/* Number of devices specified.	*/
 	int	di_num_procs;		/* Number of procs to create.	*/
-	int	di_cur_proc;		/* The current process number.	*/
-	int	di_max_procs;		/* Maximum processes started.	*/
-	int	di_procs_active;	/* Number of active processes.	*/
 	int	di_slices;		/* Number of slices to create.	*/
 	int	di_slice_number;	/* Slice number to operate on.	*/
         Offset_t di_slice_offset;       /* The starting slice offset.   */
@@ -1442,6 +1581,7 @@ typedef struct dinfo {
 	scsi_generic_t *di_sgp;		/* The SCSI generic data.       */
 	scsi_generic_t *di_sgpio;	/* The SCSI I/O generic data.   */
 	scsi_generic_t *di_tsgp;	/* The trigger SCSI generic.    */
+	struct scsi_aio_info *di_scsi_aio; /* The SCSI AIO information. */
 	unsigned int di_scsi_timeout;	/* The SCSI CDB timeout value.	*/
 	uint32_t di_scsi_recovery_delay; /* The SCSI recovery delay.	*/
 	uint32_t di_scsi_recovery_limit; /* The SCSI recovery limit.	*/
@@ -1518,6 +1658,8 @@ typedef struct dinfo {
 	large_t	di_fs_space_free;	/* The file system free space.	*/
 	large_t di_fs_total_space;	/* The total file system space.	*/
 	void	*di_fsmap;	    	/* The file system map info.	*/
+	large_t	di_fsmap_fsize;		/* The file size when mapped.	*/
+	hbool_t	di_fsmap_refreshed;	/* Map refreshed after a miss.	*/
         fsmap_type_t di_fsmap_type;     /* Show file system map type.   */
 	/*
 	 * File system trim Parameters:
@@ -1581,6 +1723,7 @@ typedef struct job_info {
     pthread_mutex_t ji_print_lock;	/* The job print lock.		*/
     pthread_mutex_t ji_thread_lock;	/* The thread wait lock.	*/
     threads_info_t *ji_tinfo;		/* The thread(s) information.	*/
+    struct time_series *ji_time_series;	/* The time series recorder.	*/
     void        *ji_opaque;     	/* Test specific opaque data.   */
 } job_info_t;
 
@@ -1588,6 +1731,10 @@ typedef struct job_info {
 
 /*
  * Shared data for jobs with multiple threads (not slices). 
+ *
+ * Note: For forward sequential and random I/O (without percentages), the
+ * bytes and records are claimed with atomic adds, rather than the I/O lock.
+ * The bytes read or written is then the sequential cursor (see iochunk=).
  */
 typedef struct io_global_data {
     pthread_mutex_t io_lock;
@@ -1599,8 +1746,8 @@ typedef struct io_global_data {
     v_large         io_bytes_read;
     v_large         io_bytes_written;
     vu_long         io_error_count;
-    vu_long         io_records_read;
-    vu_long         io_records_written;
+    v_large         io_records_read;
+    v_large         io_records_written;
     Offset_t        io_starting_offset;
     volatile Offset_t io_sequential_offset;
 } io_global_data_t;
@@ -1801,6 +1948,8 @@ extern int MakeArgList(char **argv, char *s);
 
 extern pthread_attr_t *tdattrp, *tjattrp;
 extern pthread_mutex_t print_lock;
+extern pthread_mutex_t log_ring_lock;
+extern pthread_mutex_t pfile_map_lock;
 extern int create_thread_log(dinfo_t *dip);
 extern int create_master_log(dinfo_t *dip, char *log_name);
 extern int create_detached_thread(dinfo_t *dip, void *(*func)(void *));
@@ -1865,6 +2014,22 @@ extern void dtaio_free_buffers(dinfo_t *dip);
 
 #endif /* defined(AIO) */
 
+/* dturing.c */
+
+#if defined(AIO) && defined(URING)
+
+extern int parse_uring_flags(dinfo_t *dip, char *string);
+extern int dturing_initialize(dinfo_t *dip);
+extern void dturing_cleanup(dinfo_t *dip);
+extern int dturing_close_file(dinfo_t *dip);
+extern int dturing_queue(dinfo_t *dip, struct aiocb *acbp, test_mode_t mode);
+extern int dturing_wait(dinfo_t *dip, struct aiocb *acbp);
+extern int dturing_wait_any(dinfo_t *dip, int start);
+extern ssize_t dturing_return(dinfo_t *dip, struct aiocb *acbp);
+extern int dturing_cancel(dinfo_t *dip);
+
+#endif /* defined(AIO) && defined(URING) */
+
 /* dtbtag.c */
 extern btag_t *initialize_btag(dinfo_t *dip, uint8_t opaque_type);
 extern void report_btag(dinfo_t *dip, btag_t *ebtag, btag_t *rbtag, hbool_t raw_flag);
@@ -1881,11 +2046,20 @@ extern int verify_buffer_btags(dinfo_t *dip, void *buffer, size_t record_size, b
 
 extern void btag_internal_test(dinfo_t *dip);
 extern uint32_t	crc32(uint32_t crc, void *buffer, unsigned int length);
+extern void crc32_initialize(void);
 extern int parse_btag_verify_flags(dinfo_t *dip, char *string);
 extern void show_btag_verify_flags(dinfo_t *dip);
 extern void show_btag_verify_flags_set(dinfo_t *dip, uint32_t verify_flags);
 extern int verify_btag_options(dinfo_t *dip);
 
+/* dtdist.c */
+extern uint64_t random_distribution_index(dinfo_t *dip, uint64_t items);
+extern int parse_random_distribution(dinfo_t *dip, char *string);
+extern char *format_random_distribution(dinfo_t *dip, char *buffer);
+extern double random_distribution_hot_io(random_dist_t *rdp);
+extern void report_random_distribution(dinfo_t *dip, random_dist_t *rdp);
+extern void merge_random_distribution(random_dist_t *drdp, random_dist_t *srdp);
+
 /* dtfs.c */
 extern hbool_t isFsFullOk(struct dinfo *dip, char *op, char *path);
 extern char *make_dir_filename(struct dinfo *dip, char *dirpath);
@@ -1948,6 +2122,7 @@ extern void set_unbuffered_mode(dinfo_t *dip);
 
 /* dtfmt.c */
 extern size_t FmtKeepAlive(struct dinfo *dip, char *keepalivefmt, char *buffer);
+extern int KeepAliveFlags(char *keepalivefmt);
 extern int FmtPrefix(struct dinfo *dip, char *prefix, int psize);
 extern char *FmtString(dinfo_t *dip, char *format, hbool_t filepath_flag);
 /* Consolidated into one function now. */
@@ -1981,6 +2156,7 @@ extern void save_history_data(	struct dinfo	*dip,
 				void		*buffer,
 				size_t		rsize,
 				ssize_t		tsize);
+extern int show_history_file(dinfo_t *dip, char *file);
 
 /* dtinfo.c */
 extern struct dtype *setup_device_type(char *str);
@@ -1996,6 +2172,8 @@ extern u_int32 init_iotdata(	dinfo_t		*dip,
                                 size_t		bcount,
                                 u_int32		lba,
                                 u_int32		lbsize );
+extern hbool_t verify_iotdata(dinfo_t *dip, u_char *buffer, size_t bcount);
+extern void expand_iotdata(dinfo_t *dip);
 extern void process_iot_data(dinfo_t *dip, u_char *pbuffer, u_char *vbuffer, size_t bcount, hbool_t raw_flag);
 extern void analyze_iot_data(dinfo_t *dip, u_char *pbuffer, u_char *vbuffer, size_t bcount, hbool_t raw_flag);
 extern void display_iot_data(dinfo_t *dip, u_char *pbuffer, u_char *vbuffer, size_t bcount, hbool_t raw_flag);
@@ -2017,6 +2195,9 @@ extern int acquire_job_thread_lock(dinfo_t *dip, job_info_t *job);
 extern int release_job_thread_lock(dinfo_t *dip, job_info_t *job);
 extern int dt_acquire_iolock(dinfo_t *dip, io_global_data_t *iogp);
 extern int dt_release_iolock(dinfo_t *dip, io_global_data_t *iogp);
+extern hbool_t dt_claim_iorange(dinfo_t *dip, io_global_data_t *iogp, v_large *io_bytes,
+				v_large *io_records, size_t dsize, large_t data_limit,
+				size_t *bsize, u_long *record);
 extern job_info_t *find_job_by_id(dinfo_t *dip, uint32_t job_id, hbool_t lock_jobs);
 extern job_info_t *find_job_by_tag(dinfo_t *dip, char *tag, hbool_t lock_jobs);
 extern job_info_t *find_jobs_by_tag(dinfo_t *dip, char *tag, job_info_t *pjob, hbool_t lock_jobs);
@@ -2142,6 +2323,7 @@ extern void *Realloc(dinfo_t *dip, void *bp, size_t bytes);
 
 extern void *malloc_palign(dinfo_t *dip, size_t bytes, int offset);
 extern void free_palign(dinfo_t *dip, void *pa_addr);
+extern void free_palign_cache(dinfo_t *dip);
 
 /* dtmmap.c */
 
@@ -2166,12 +2348,6 @@ extern double genrand64_real2(dinfo_t *dip);
 extern double genrand64_real3(dinfo_t *dip);
 
 /* dtprocs.c */
-extern void abort_procs(dinfo_t *dip);
-extern void await_procs(dinfo_t *dip);
-extern pid_t fork_process(dinfo_t *dip);
-extern pid_t start_devs(dinfo_t *dip);
-extern pid_t start_procs(dinfo_t *dip);
-extern pid_t start_slices(dinfo_t *dip);
 extern int init_slice(struct dinfo *dip, int slice);
 
 /* dtread.c */
@@ -2215,6 +2391,15 @@ extern ssize_t scsiWriteData(dinfo_t *dip, void *buffer, size_t bytes, Offset_t
 extern void dtReportScsiError(dinfo_t *dip, scsi_generic_t *sgp);
 extern int get_standard_scsi_information(dinfo_t *dip, scsi_generic_t *sgp);
 extern void strip_trailing_spaces(char *bp);
+#if defined(AIO) && defined(__linux__)
+extern int dtscsi_aio_initialize(dinfo_t *dip);
+extern void dtscsi_aio_cleanup(dinfo_t *dip);
+extern int dtscsi_aio_queue(dinfo_t *dip, struct aiocb *acbp, test_mode_t mode);
+extern int dtscsi_aio_wait(dinfo_t *dip, struct aiocb *acbp);
+extern int dtscsi_aio_wait_any(dinfo_t *dip, int start);
+extern ssize_t dtscsi_aio_return(dinfo_t *dip, struct aiocb *acbp);
+extern int dtscsi_aio_cancel(dinfo_t *dip);
+#endif /* defined(AIO) && defined(__linux__) */
 
 /* Note: Without NVME support, stubs exist for these functions. */
 extern void report_standard_nvme_information(dinfo_t *dip);
@@ -2237,6 +2422,38 @@ extern void dt_nvme_show_status(dinfo_t *dip, char *op, int status);
 
 #endif /* defined(SCSI) */
 
+/* dtlatency.c */
+extern double latency_percentiles[LATENCY_PERCENTILES];
+extern char *latency_percentile_names[LATENCY_PERCENTILES];
+extern void update_latency_stats(dinfo_t *dip, optype_t optype, uint64_t latency, ssize_t count);
+extern void record_latency(dinfo_t *dip, optype_t optype, uint64_t latency);
+extern int merge_latency_histogram(dinfo_t *dip, latency_histogram_t **dhpp, latency_histogram_t *shp);
+extern uint64_t latency_percentile(latency_histogram_t *rhp, latency_histogram_t *whp, double percentile);
+extern void report_latency_percentiles(dinfo_t *dip, char *text, latency_histogram_t *rhp, latency_histogram_t *whp);
+extern size_t format_latency_json(char *buffer, char *name, uint64_t ios, uint64_t latency,
+				  uint64_t min_latency, uint64_t max_latency,
+				  latency_histogram_t *rhp, latency_histogram_t *whp);
+extern size_t format_latency_csv_header(char *buffer);
+extern size_t format_latency_csv(char *buffer, latency_histogram_t *rhp, latency_histogram_t *whp);
+extern void free_latency_histograms(dinfo_t *dip);
+
+/* dtseries.c */
+extern int create_time_series(dinfo_t *dip, job_info_t *job);
+extern int start_time_series(dinfo_t *dip, job_info_t *job);
+extern void stop_time_series(dinfo_t *dip, job_info_t *job);
+
+/* dtsimd.c */
+extern simd_type_t simd_type;
+extern hbool_t simd_crc32_flag;
+extern void simd_initialize(void);
+extern char *simd_type_name(simd_type_t type);
+extern void simd_fill_periodic(dinfo_t *dip, uint8_t *bptr, size_t count, uint8_t *pattern);
+extern hbool_t simd_compare_buffers(dinfo_t *dip, uint8_t *aptr, uint8_t *bptr, size_t count);
+extern hbool_t simd_compare_periodic(dinfo_t *dip, uint8_t *bptr, size_t count, uint8_t *pattern);
+extern uint32_t simd_fill_sequence(dinfo_t *dip, uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+extern hbool_t simd_compare_sequence(dinfo_t *dip, uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+extern uint32_t simd_crc32_fold(uint32_t crc, uint8_t *bptr, size_t count);
+
 /* dtstats.c */
 extern void accumulate_stats(dinfo_t *dip);
 extern void gather_stats(struct dinfo *dip);
@@ -2244,6 +2461,8 @@ extern void gather_totals(struct dinfo *dip);
 extern void init_stats(struct dinfo *dip);
 extern void report_pass(struct dinfo *dip, enum stats stats_type);
 extern void report_stats(struct dinfo *dip, enum stats stats_type);
+extern void report_json_stats(dinfo_t *dip, stats_t stats_type);
+extern size_t FmtJsonStats(dinfo_t *dip, char *buffer, char *record, hbool_t pass_stats, hbool_t active);
 extern void report_file_system_information(dinfo_t *dip, hbool_t print_header, hbool_t acquire_free_space);
 extern void report_os_information(dinfo_t *dip, hbool_t print_header);
 extern void report_scsi_summary(dinfo_t *dip, hbool_t print_header);
@@ -2284,6 +2503,8 @@ extern uint64_t	timer_diffsecs(struct timeval *start, struct timeval *end);
 extern uint64_t	timer_now(struct timeval *timer);
 
 extern size_t copy_prefix( dinfo_t *dip, u_char *buffer, size_t bcount );
+extern void free_fill_engine(dinfo_t *dip);
+extern hbool_t compare_buffer(dinfo_t *dip, void *buffer, size_t byte_count, lbdata_t *lba);
 extern void fill_buffer(	dinfo_t		*dip,
 				void		*buffer,
 				size_t		byte_count,
@@ -2348,6 +2569,9 @@ extern void format_time(dinfo_t *dip, clock_t ticks);
 extern int FormatElapstedTime(char *buffer, clock_t ticks);
 
 extern int process_pfile(dinfo_t *dip, char *file);
+extern uint8_t *map_pattern_file(dinfo_t *dip, char *file, size_t size);
+extern void hold_pattern_file(dinfo_t *dip, uint8_t *buffer);
+extern void unmap_pattern_file(dinfo_t *dip, uint8_t *buffer);
 extern void process_iotune(dinfo_t *dip, char *file);
 extern void copy_pattern(u_int32 pattern, u_char *buffer);
 extern void reset_pattern(dinfo_t *dip);
@@ -2566,6 +2790,10 @@ extern void eLflush(dinfo_t *dip);
 extern int Sprintf(char *bufptr, char *msg, ...);
 extern int vSprintf(char *bufptr, const char *msg, va_list ap);
 
+extern int log_ring_create(dinfo_t *dip);
+extern void log_ring_close(dinfo_t *dip);
+extern void log_ring_flush_all(void);
+
 extern void DumpFieldsOffset(dinfo_t *dip, uint8_t *bptr, int length);
 extern void PrintFields(dinfo_t *dip, u_char *bptr, int length);
 extern void PrintHAFields(dinfo_t *dip, unsigned char *bptr, int length);
@@ -2784,6 +3012,8 @@ extern void *os_get_file_map(dinfo_t *dip, HANDLE fd);
 extern void os_free_file_map(dinfo_t *dip);
 extern int os_report_file_map(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset, int64_t length);
 extern uint64_t os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset);
+extern int os_map_range_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset,
+			       uint32_t step, uint64_t *lbas, int count);
 
 /* dtunix.c and dtwin.c */
 extern void ReportOpenInformation(dinfo_t *dip, char *FileName, char *Operation,
@@ -32,6 +32,38 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Only update the latency (and time series) statistics when processing
+ * read/write completions, not for cancelled or restarted requests.
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Pass the bytes transferred to update_latency_stats() for time series.
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Add read/write and random/sequential percentages to AIO writes.
+ * Each queued request selects its own operation and I/O type, and reads
+ * of blocks already written this pass are verified when the expected
+ * data can be derived from the offset alone.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the asynchronous SCSI I/O engine (see dtscsi.c), selected when
+ * SCSI I/O is enabled with AIO.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Record the AIO latencies (queued to reaped), for latency percentiles.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add unordered (completion order) AIO processing via the option
+ * enable=aiounordered. Whichever request completes first is processed
+ * (verified, accounted for) and its control block is reused for the next
+ * request, so one slow request no longer stalls all of the others. Tapes,
+ * and reads whose expected data depends on record order, remain ordered.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the Linux io_uring engine (see dturing.c), selected via the
+ * enable=uring option. The AIO queue, wait, return, and cancel operations
+ * now go through small wrappers, so all of the AIO processing is shared.
+ * 
  * September 20th, 2023 by Robin T. Miller
  *      For all random access devices, limit the data read to what was
  * written. Previously this was enabled only for file systems, but it's
@@ -99,12 +131,21 @@ static int dtaio_wait_reads(struct dinfo *dip);
 static int dtaio_wait_writes(struct dinfo *dip);
 static int dtaio_process_read(struct dinfo *dip, struct aiocb *acbp);
 static int dtaio_process_write(struct dinfo *dip, struct aiocb *acbp);
-
-#if defined(WIN32)
-#  define AIO_NotQed	INVALID_HANDLE_VALUE
-#else /* !defined(WIN32) */
-#  define AIO_NotQed	-1		/* AIO request not queued flag.	*/
-#endif /* defined(WIN32) */
+static int dtaio_process_request(struct dinfo *dip, struct aiocb *acbp);
+static test_mode_t dtaio_request_mode(struct dinfo *dip, struct aiocb *acbp);
+static int dtaio_mixed_setup(struct dinfo *dip, large_t data_limit);
+static hbool_t dtaio_mixed_written(struct dinfo *dip, Offset_t offset, size_t bytes);
+static void dtaio_mixed_update(struct dinfo *dip, Offset_t offset, size_t bytes);
+static hbool_t dtaio_mixed_overlap(struct dinfo *dip, struct aiocb *acbp, optype_t optype);
+static int dtaio_mixed_verify(struct dinfo *dip, struct aiocb *acbp, ssize_t count);
+#if !defined(WIN32)
+static int dtaio_queue_read(struct dinfo *dip, struct aiocb *acbp);
+static int dtaio_queue_write(struct dinfo *dip, struct aiocb *acbp);
+static ssize_t dtaio_return(struct dinfo *dip, struct aiocb *acbp);
+static void dtaio_update_latency(struct dinfo *dip, struct aiocb *acbp, ssize_t count);
+static struct aiocb *dtaio_wait_any(struct dinfo *dip);
+static hbool_t dtaio_set_anyorder(struct dinfo *dip, large_t data_limit);
+#endif /* !defined(WIN32) */
 
 /*
  * Declare the POSIX Asynchronous I/O test functions.
@@ -123,6 +164,235 @@ struct dtfuncs aio_funcs = {
     /*	tf_startup,		tf_cleanup,		tf_validate_opts  */
 	nofunc,			nofunc,			validate_opts
 };
+
+#if !defined(WIN32)
+/*
+ * These functions select the POSIX AIO or io_uring engine (if enabled).
+ */
+static int
+dtaio_queue_read(struct dinfo *dip, struct aiocb *acbp)
+{
+    highresolutiontime(&dip->di_aio_times[acbp - dip->di_acbs], NULL);
+#if defined(URING)
+    if (dip->di_uring) {
+	return( dturing_queue(dip, acbp, READ_MODE) );
+    }
+#endif /* defined(URING) */
+#if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	return( dtscsi_aio_queue(dip, acbp, READ_MODE) );
+    }
+#endif /* defined(SCSI) && defined(__linux__) */
+#if defined(_AIO_AIX_SOURCE)
+    return( aio_read(acbp->aio_fildes, acbp) );
+#else /* !defined(_AIO_AIX_SOURCE) */
+    return( aio_read(acbp) );
+#endif /* defined(_AIO_AIX_SOURCE) */
+}
+
+static int
+dtaio_queue_write(struct dinfo *dip, struct aiocb *acbp)
+{
+    highresolutiontime(&dip->di_aio_times[acbp - dip->di_acbs], NULL);
+#if defined(URING)
+    if (dip->di_uring) {
+	return( dturing_queue(dip, acbp, WRITE_MODE) );
+    }
+#endif /* defined(URING) */
+#if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	return( dtscsi_aio_queue(dip, acbp, WRITE_MODE) );
+    }
+#endif /* defined(SCSI) && defined(__linux__) */
+#if defined(_AIO_AIX_SOURCE)
+    return( aio_write(acbp->aio_fildes, acbp) );
+#else /* !defined(_AIO_AIX_SOURCE) */
+    return( aio_write(acbp) );
+#endif /* defined(_AIO_AIX_SOURCE) */
+}
+
+static ssize_t
+dtaio_return(struct dinfo *dip, struct aiocb *acbp)
+{
+    ssize_t count;
+
+#if defined(URING)
+    if (dip->di_uring) {
+	count = dturing_return(dip, acbp);
+    } else
+#endif /* defined(URING) */
+#if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	count = dtscsi_aio_return(dip, acbp);
+    } else
+#endif /* defined(SCSI) && defined(__linux__) */
+	count = aio_return(acbp);
+    return(count);
+}
+
+/*
+ * dtaio_update_latency() - Update the Latency for a Completed Request.
+ *
+ * Note: The latency is from queuing the request until it is reaped, so
+ * with ordered processing, this includes waiting on older requests.
+ * Only called when processing completions, not for cancelled requests.
+ */
+static void
+dtaio_update_latency(struct dinfo *dip, struct aiocb *acbp, ssize_t count)
+{
+    struct timeval end_time;
+
+    highresolutiontime(&end_time, NULL);
+    update_latency_stats(dip, (dtaio_request_mode(dip, acbp) == READ_MODE) ? READ_OP : WRITE_OP,
+			 timer_diff(&dip->di_aio_times[acbp - dip->di_acbs], &end_time), count);
+    return;
+}
+
+/*
+ * dtaio_wait_any() - Wait for Any Outstanding AIO Request to Complete.
+ *
+ * Description:
+ *	This is used for unordered (completion order) processing. The search
+ * starts at the current AIO index, which is the oldest request, so slower
+ * requests are not starved. The request returned has completed, so the
+ * process functions won't block in dtaio_wait().
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *
+ * Return Value:
+ *	Returns the completed AIO control block, or NULL on failure.
+ */
+static struct aiocb *
+dtaio_wait_any(struct dinfo *dip)
+{
+    struct aiocb *acbp;
+    int count, index, entries;
+
+    ENABLE_NOPROG(dip, AIOWAIT_OP);
+# if defined(URING)
+    if (dip->di_uring) {
+	if ( (index = dturing_wait_any(dip, dip->di_aio_index)) == FAILURE) {
+	    if (!terminating_flag) {
+		ReportErrorInfo(dip, dip->di_dname, os_get_error(), "dturing_wait_any", OTHER_OP, True);
+	    }
+	    acbp = NULL;
+	} else {
+	    acbp = &dip->di_acbs[index];
+	}
+	DISABLE_NOPROG(dip);
+	return (acbp);
+    }
+# endif /* defined(URING) */
+# if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	if ( (index = dtscsi_aio_wait_any(dip, dip->di_aio_index)) == FAILURE) {
+	    if (!terminating_flag) {
+		ReportErrorInfo(dip, dip->di_dname, os_get_error(), "dtscsi_aio_wait_any", OTHER_OP, True);
+	    }
+	    acbp = NULL;
+	} else {
+	    acbp = &dip->di_acbs[index];
+	}
+	DISABLE_NOPROG(dip);
+	return (acbp);
+    }
+# endif /* defined(SCSI) && defined(__linux__) */
+    do {
+	/*
+	 * Look for a completed request, while building the suspend list.
+	 */
+	entries = 0;
+	for (count = 0, index = dip->di_aio_index; count < dip->di_aio_bufs; count++) {
+	    acbp = &dip->di_acbs[index];
+	    if (++index == dip->di_aio_bufs) index = 0;
+	    if (acbp->aio_fildes == AIO_NotQed) continue;
+	    if (aio_error(acbp) != EINPROGRESS) {
+		DISABLE_NOPROG(dip);
+		return (acbp);
+	    }
+	    dip->di_aio_list[entries++] = acbp;
+	}
+	if (entries == 0) {
+	    acbp = NULL;	/* Nothing outstanding, should NOT happen! */
+	    break;
+	}
+# if defined(POSIX_4D11)
+#  if defined(_AIO_AIX_SOURCE)
+	if (aio_suspend(entries, dip->di_aio_list) == FAILURE) {
+#  else /* !defined(_AIO_AIX_SOURCE) */
+	if (aio_suspend(entries, (const struct aiocb **)dip->di_aio_list) == FAILURE) {
+#  endif /* defined(_AIO_AIX_SOURCE) */
+# else /* Beyond draft 11... */
+	if (aio_suspend((const struct aiocb **)dip->di_aio_list, entries, NULL) == FAILURE) {
+# endif /* defined(POSIX_4D11) */
+	    if (errno != EINTR) {
+		ReportErrorInfo(dip, dip->di_dname, os_get_error(), "aio_suspend", SUSPEND_OP, True);
+		acbp = NULL;
+		break;
+	    }
+	}
+    } while (True);
+    DISABLE_NOPROG(dip);
+    return (acbp);
+}
+
+/*
+ * dtaio_set_anyorder() - Determine if Unordered Processing is Possible.
+ *
+ * Description:
+ *	Writes may always complete in any order, since each buffer is filled
+ * when queued. For reads, the pattern is verified as a continuous stream,
+ * so completion order only works when each record starts with the same
+ * pattern position, or when the expected data is derived from the offset
+ * (IOT pattern) or the block tags.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	data_limit = The data limit for this pass.
+ *
+ * Return Value:
+ *	Returns True if unordered processing is enabled for this pass.
+ */
+static hbool_t
+dtaio_set_anyorder(struct dinfo *dip, large_t data_limit)
+{
+    size_t psize = dip->di_pattern_bufsize;
+    hbool_t anyorder = True;
+
+    dip->di_aio_anyorder = False;
+    if ( (dip->di_aio_unordered == False) || (dip->di_io_mode != TEST_MODE) ||
+	 (dip->di_io_dir == REVERSE) || (dip->di_slices && dip->di_step_offset) ) {
+	return (False);
+    }
+    if ( (dip->di_mode == READ_MODE) && dip->di_compare_flag &&
+	 (dip->di_iot_pattern == False) && (dip->di_btag_flag == False) ) {
+	if (dip->di_prefix_string) {
+	    anyorder = False;
+	} else if (psize > 1) {
+	    if (dip->di_min_size) {
+		anyorder = ( (dip->di_variable_flag == False) &&
+			     ((dip->di_min_size % psize) == 0) &&
+			     ((dip->di_incr_count % psize) == 0) );
+	    } else {
+		anyorder = ((dip->di_block_size % psize) == 0);
+	    }
+	    if ( anyorder && (data_limit % psize) ) {
+		anyorder = False;	/* Partial record at the end. */
+	    }
+	}
+	if ( (anyorder == False) && (dip->di_pass_count == 0) ) {
+	    Wprintf(dip, "The read pattern depends on record order, using ordered AIO processing!\n");
+	}
+    }
+    if ( (anyorder == True) && dip->di_btag && (dip->di_mode == READ_MODE) ) {
+	/* The record number reflects the queuing order, not the completion order. */
+	dip->di_btag_vflags &= ~BTAGV_RECORD_NUMBER;
+    }
+    dip->di_aio_anyorder = anyorder;
+    return (anyorder);
+}
+#endif /* !defined(WIN32) */
 
 /************************************************************************
  *									*
@@ -154,6 +424,9 @@ dtaio_close_file (struct dinfo *dip)
 	(void) dtaio_cancel (dip);
 	status = dtaio_waitall (dip, False);
     }
+#if defined(URING)
+    (void)dturing_close_file(dip);
+#endif /* defined(URING) */
     dip->di_closing = False;
     return (close_file (dip));
 }
@@ -174,6 +447,14 @@ dtaio_initialize (struct dinfo *dip)
 	dip->di_aio_bufs = 1;
 	size = (sizeof(struct aiocb) * dip->di_aio_bufs);
     }
+#if defined(SCSI) && defined(__linux__)
+    if ( (dip->di_scsi_io_flag == True) && (dip->di_aio_bufs > SCSI_AIO_MAX_QUEUE) ) {
+	Wprintf(dip, "The sg driver queues at most %d commands per device, limiting AIO's to %d!\n",
+		SCSI_AIO_MAX_QUEUE, SCSI_AIO_MAX_QUEUE);
+	dip->di_aio_bufs = SCSI_AIO_MAX_QUEUE;
+	size = (sizeof(struct aiocb) * dip->di_aio_bufs);
+    }
+#endif /* defined(SCSI) && defined(__linux__) */
 
     dip->di_aio_index = 0;
     dip->di_aio_offset = (Offset_t) 0;
@@ -181,6 +462,9 @@ dtaio_initialize (struct dinfo *dip)
 	size_t psize = (dip->di_aio_bufs * sizeof(u_char *));
 	dip->di_acbs = (struct aiocb *)Malloc(dip, size);
 	dip->di_aiobufs = (void **)Malloc(dip, psize);
+	dip->di_aio_times = (struct timeval *)Malloc(dip, (dip->di_aio_bufs * sizeof(struct timeval)));
+	dip->di_aio_optypes = (optype_t *)Malloc(dip, (dip->di_aio_bufs * sizeof(optype_t)));
+	dip->di_aio_vreads = (hbool_t *)Malloc(dip, (dip->di_aio_bufs * sizeof(hbool_t)));
     }
     for (index = 0, acbp = dip->di_acbs; index < dip->di_aio_bufs; index++, acbp++) {
 	if (acbp->aio_buf == NULL) {
@@ -222,12 +506,49 @@ dtaio_initialize (struct dinfo *dip)
 	    dip->di_base_buffer = dip->di_data_buffer = (u_char *)acbp->aio_buf;
 	}
     }
+    dip->di_aio_anyorder = False;
+    if (dip->di_aio_unordered == True) {
+#if defined(WIN32)
+	Wprintf(dip, "Unordered AIO processing is NOT supported on Windows, using ordered!\n");
+	dip->di_aio_unordered = False;
+#else /* !defined(WIN32) */
+	if (dip->di_random_access == False) {
+	    Wprintf(dip, "Unordered AIO processing requires a random access device, using ordered!\n");
+	    dip->di_aio_unordered = False;
+	} else if (dip->di_aio_list == NULL) {
+	    dip->di_aio_list = Malloc(dip, (dip->di_aio_bufs * sizeof(struct aiocb *)));
+	    if (dip->di_aio_list == NULL) return(FAILURE);
+	}
+#endif /* defined(WIN32) */
+    }
+#if defined(URING)
+    if (dip->di_uring_flag == True) {
+	if (dip->di_dtype->dt_dtype == DT_TAPE) {
+	    Wprintf(dip, "The io_uring engine is NOT supported for tapes, using POSIX AIO!\n");
+	    dip->di_uring_flag = False;
+	} else {
+	    status = dturing_initialize(dip);
+	}
+    }
+#endif /* defined(URING) */
+#if defined(SCSI) && defined(__linux__)
+    if ( (status == SUCCESS) && (dip->di_scsi_io_flag == True) ) {
+	status = dtscsi_aio_initialize(dip);
+    }
+#endif /* defined(SCSI) && defined(__linux__) */
     return (status);
 }
 
 void
 dtaio_free_buffers(dinfo_t *dip)
 {
+#if defined(URING)
+    /* Note: Teardown the ring first, since buffers may be registered. */
+    dturing_cleanup(dip);
+#endif /* defined(URING) */
+#if defined(SCSI) && defined(__linux__)
+    dtscsi_aio_cleanup(dip);
+#endif /* defined(SCSI) && defined(__linux__) */
     if (dip->di_aio_bufs && dip->di_acbs) {
 	int index;
 	struct aiocb *acbp;
@@ -242,6 +563,21 @@ dtaio_free_buffers(dinfo_t *dip)
 	dip->di_aiobufs = NULL;
 	Free(dip, dip->di_acbs);
 	dip->di_acbs = NULL;
+	Free(dip, dip->di_aio_times);
+	dip->di_aio_times = NULL;
+	Free(dip, dip->di_aio_optypes);
+	dip->di_aio_optypes = NULL;
+	Free(dip, dip->di_aio_vreads);
+	dip->di_aio_vreads = NULL;
+    }
+    if (dip->di_aio_wmap) {
+	Free(dip, dip->di_aio_wmap);
+	dip->di_aio_wmap = NULL;
+	dip->di_aio_wmap_blocks = 0;
+    }
+    if (dip->di_aio_list) {
+	Free(dip, dip->di_aio_list);
+	dip->di_aio_list = NULL;
     }
     return;
 }
@@ -279,7 +615,18 @@ dtaio_cancel (struct dinfo *dip)
 	}
     }
 #else /* !defined(WIN32) */
-    if ((status = aio_cancel(dip->di_fd, (struct aiocb *) 0)) == FAILURE) {
+# if defined(URING)
+    if (dip->di_uring) {
+	status = dturing_cancel(dip);
+    } else
+# endif /* defined(URING) */
+# if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	status = dtscsi_aio_cancel(dip);
+    } else
+# endif /* defined(SCSI) && defined(__linux__) */
+    status = aio_cancel(dip->di_fd, (struct aiocb *) 0);
+    if (status == FAILURE) {
 	int error = os_get_error();
 	/*
 	 * aio_cancel() returns EBADF if the file descriptor is
@@ -373,6 +720,7 @@ dtaio_restart(struct dinfo *dip, struct aiocb *first_acbp)
 
     /*
      * Now, wait for and restart all previously active I/O's.
+     * With unordered processing, only the failed request is restarted.
      */
     do {
 	/*
@@ -381,17 +729,13 @@ dtaio_restart(struct dinfo *dip, struct aiocb *first_acbp)
 	if (dip->di_Debug_flag) {
 	    Printf(dip, "Restarting request for acbp at %#lx...\n", acbp);
 	}
-	if (dip->di_mode == READ_MODE) {
+	if (dtaio_request_mode(dip, acbp) == READ_MODE) {
 #if defined(WIN32)
 	   error = SUCCESS;
 	   if ( !ReadFile(acbp->aio_fildes, acbp->aio_buf, (DWORD)acbp->aio_nbytes,
 			  NULL, &acbp->overlap) ) error = FAILURE;
 #else /* !defined(WIN32) */
-# if defined(_AIO_AIX_SOURCE)
-	    error = aio_read(acbp->aio_fildes, acbp);
-# else /* !defined(_AIO_AIX_SOURCE) */
-	    error = aio_read(acbp);
-# endif /* defined(_AIO_AIX_SOURCE) */
+	    error = dtaio_queue_read(dip, acbp);
 #endif /* defined(WIN32) */
 	    if (error == FAILURE) {
 		acbp->aio_fildes = AIO_NotQed;
@@ -404,11 +748,7 @@ dtaio_restart(struct dinfo *dip, struct aiocb *first_acbp)
 	   if ( !WriteFile(acbp->aio_fildes, acbp->aio_buf, (DWORD)acbp->aio_nbytes,
 			   NULL, &acbp->overlap) ) error = FAILURE;
 #else /* !defined(WIN32) */
-# if defined(_AIO_AIX_SOURCE)
-	    error = aio_write(acbp->aio_fildes, acbp);
-# else /* !defined(_AIO_AIX_SOURCE) */
-	    error = aio_write(acbp);
-# endif /* defined(_AIO_AIX_SOURCE) */
+	    error = dtaio_queue_write(dip, acbp);
 #endif /* defined(WIN32) */
 	    if (error == FAILURE) {
 		acbp->aio_fildes = AIO_NotQed;
@@ -416,6 +756,7 @@ dtaio_restart(struct dinfo *dip, struct aiocb *first_acbp)
 		return (error);
 	    }
 	}
+	if (dip->di_aio_anyorder == True) break;
 	if (++index == dip->di_aio_bufs) index = 0;
 	if (index == dip->di_aio_index) break;
 
@@ -424,7 +765,7 @@ dtaio_restart(struct dinfo *dip, struct aiocb *first_acbp)
 
 	error = dtaio_wait(dip, acbp);
 #if !defined(WIN32)
-	(void)aio_return(acbp);	/* Why is this here? */
+	(void)dtaio_return(dip, acbp);	/* Why is this here? */
 #endif /* !defined(WIN32) */
 
     } while (True);
@@ -484,6 +825,22 @@ dtaio_wait (struct dinfo *dip, struct aiocb *acbp)
 	}
     }
 #else /* !defined(WIN32) */
+# if defined(URING)
+    if (dip->di_uring) {
+	if ( ((status = dturing_wait(dip, acbp)) == FAILURE) && !terminating_flag) {
+	    ReportErrorInfo(dip, dip->di_dname, os_get_error(), "dturing_wait", OTHER_OP, True);
+	}
+	goto done;
+    }
+# endif /* defined(URING) */
+# if defined(SCSI) && defined(__linux__)
+    if (dip->di_scsi_aio) {
+	if ( ((status = dtscsi_aio_wait(dip, acbp)) == FAILURE) && !terminating_flag) {
+	    ReportErrorInfo(dip, dip->di_dname, os_get_error(), "dtscsi_aio_wait", OTHER_OP, True);
+	}
+	goto done;
+    }
+# endif /* defined(SCSI) && defined(__linux__) */
     /*
      * Loop waiting for an I/O request to complete.
      */
@@ -519,6 +876,7 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
     register size_t bsize;
     register ssize_t count;
     ssize_t adjust;
+    test_mode_t mode;
     int index, error, status = SUCCESS;
 
     /*
@@ -528,6 +886,7 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
 	acbp = &dip->di_acbs[dip->di_aio_index];
 	if (++dip->di_aio_index == dip->di_aio_bufs) dip->di_aio_index = 0;
 	if (acbp->aio_fildes == AIO_NotQed) continue;
+	mode = dtaio_request_mode(dip, acbp);
 	if ( (error = dtaio_wait(dip, acbp))) {
 	    status = error;
 	    if (status == FAILURE) {
@@ -540,7 +899,7 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
 	count = acbp->bytes_rw;
 	error = acbp->last_error;
 #else /* !defined(WIN32) */
-	count = aio_return(acbp);
+	count = dtaio_return(dip, acbp);
 #endif /* defined(WIN32) */
 	acbp->aio_fildes = AIO_NotQed;
 	errno = error;
@@ -556,7 +915,7 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
 		ReportDeviceInfo(dip, acbp->aio_nbytes, 0, eio_flag, NotMismatchedData);
 		if ( (dip->di_trigger_control == TRIGGER_ON_ALL) ||
 		     (dip->di_trigger_control == TRIGGER_ON_ERRORS) ) {
-		    if (dip->di_mode == READ_MODE) {
+		    if (mode == READ_MODE) {
 			(void)ExecuteTrigger(dip, "read");
 		    } else {
 			(void)ExecuteTrigger(dip, "write");
@@ -596,7 +955,7 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
 	     * Adjust counts for total statistics.
 	     */
 	    if (!canceling) {
-		if (dip->di_mode == READ_MODE) {
+		if (mode == READ_MODE) {
 		    dip->di_dbytes_read += count;
 		    dip->di_fbytes_read += count;
 		} else {
@@ -605,13 +964,13 @@ dtaio_waitall(struct dinfo *dip, hbool_t canceling)
 		}
 		dip->di_aio_data_adjust += count;
 		if ((size_t)count == bsize) {
-                    if (dip->di_mode == READ_MODE) {
+                    if (mode == READ_MODE) {
 		        dip->di_full_reads++;
                     } else {
                         dip->di_full_writes++;
                     }
 		} else {
-                    if (dip->di_mode == READ_MODE) {
+                    if (mode == READ_MODE) {
 		        dip->di_partial_reads++;
                     } else {
                         dip->di_partial_writes++;
@@ -632,6 +991,29 @@ dtaio_wait_reads(struct dinfo *dip)
     struct aiocb *acbp;
     int index, error, status = SUCCESS;
 
+#if !defined(WIN32)
+    if (dip->di_aio_anyorder == True) {
+	int outstanding = 0;
+	for (index = 0; index < dip->di_aio_bufs; index++) {
+	    if (dip->di_acbs[index].aio_fildes != AIO_NotQed) outstanding++;
+	}
+	/*
+	 * Process the outstanding requests in completion order.
+	 */
+	while (outstanding--) {
+	    if ( (acbp = dtaio_wait_any(dip)) == NULL) return (FAILURE);
+	    if ( (error = dtaio_process_read(dip, acbp)) == FAILURE) {
+		status = error;
+	    }
+	    if ( dip->di_end_of_file ||
+		 (dip->di_records_read >= dip->di_record_limit) || (dip->di_fbytes_read >= dip->di_data_limit) ) {
+		break;
+	    }
+	}
+	return (status);
+    }
+#endif /* !defined(WIN32) */
+
     /*
      * Loop waiting for all I/O requests to complete.
      */
@@ -660,6 +1042,26 @@ dtaio_wait_writes(struct dinfo *dip)
     struct aiocb *acbp;
     int index, error, status = SUCCESS;
 
+#if !defined(WIN32)
+    if (dip->di_aio_anyorder == True) {
+	int outstanding = 0;
+	for (index = 0; index < dip->di_aio_bufs; index++) {
+	    if (dip->di_acbs[index].aio_fildes != AIO_NotQed) outstanding++;
+	}
+	/*
+	 * Process the outstanding requests in completion order.
+	 */
+	while (outstanding--) {
+	    if ( (acbp = dtaio_wait_any(dip)) == NULL) return (FAILURE);
+	    if ( (error = dtaio_process_request(dip, acbp)) == FAILURE) {
+		status = error;
+		if (dip->di_error_count >= dip->di_error_limit) break;
+	    }
+	}
+	return (status);
+    }
+#endif /* !defined(WIN32) */
+
     /*
      * Loop waiting for all I/O requests to complete.
      */
@@ -668,7 +1070,7 @@ dtaio_wait_writes(struct dinfo *dip)
 	if (++dip->di_aio_index == dip->di_aio_bufs) dip->di_aio_index = 0;
 	if (acbp->aio_fildes == AIO_NotQed) continue;
 	
-	if ( (error = dtaio_process_write(dip, acbp)) == FAILURE) {
+	if ( (error = dtaio_process_request(dip, acbp)) == FAILURE) {
 	    status = error;
 	    if (dip->di_error_count >= dip->di_error_limit) break;
 	}
@@ -706,6 +1108,7 @@ dtaio_read_data(struct dinfo *dip)
 	dip->di_aio_lba = make_lbdata(dip, dip->di_aio_offset);
     }
     dip->di_aio_data_bytes = dip->di_aio_file_bytes = dip->di_aio_record_count = 0;
+    dip->di_aio_mixed = False;
 
     if ( dip->di_last_fbytes_written && dip->di_random_access ) {
 	if ( dip->di_files_read == (dip->di_last_files_written - 1) ) {
@@ -719,6 +1122,9 @@ dtaio_read_data(struct dinfo *dip)
 
     dsize = get_data_size(dip, READ_OP);
     data_limit = get_data_limit(dip);
+#if !defined(WIN32)
+    (void)dtaio_set_anyorder(dip, data_limit);
+#endif /* !defined(WIN32) */
 
     /* Prime the common btag data, except for IOT pattern. */
     if ( (dip->di_btag_flag == True) && (dip->di_iot_pattern == False) ) {
@@ -883,11 +1289,7 @@ dtaio_read_data(struct dinfo *dip)
 		return (error);
 	    }
 #else /* !defined(WIN32) */
-# if defined(_AIO_AIX_SOURCE)
-	    if ( (error = aio_read(acbp->aio_fildes, acbp)) == FAILURE) {
-# else /* !defined(_AIO_AIX_SOURCE) */
-	    if ( (error = aio_read(acbp)) == FAILURE) {
-# endif /* defined(_AIO_AIX_SOURCE) */
+	    if ( (error = dtaio_queue_read(dip, acbp)) == FAILURE) {
 		acbp->aio_fildes = AIO_NotQed;
 		ReportErrorInfo(dip, dip->di_dname, os_get_error(), OS_AIO_READ, READ_OP, True);
 		return (error);
@@ -944,6 +1346,13 @@ dtaio_read_data(struct dinfo *dip)
 	    }
 	    acbp = &dip->di_acbs[dip->di_aio_index];
 	    if (acbp->aio_fildes == AIO_NotQed) continue; /* Never Q'ed. */
+#if !defined(WIN32)
+	    if (dip->di_aio_anyorder == True) {
+		/* Process whichever completes first, then reuse its slot. */
+		if ( (acbp = dtaio_wait_any(dip)) == NULL) return (FAILURE);
+		dip->di_aio_index = (int)(acbp - dip->di_acbs);
+	    }
+#endif /* !defined(WIN32) */
 
 	    if ( (status = dtaio_process_read(dip, acbp)) == FAILURE) {
 		return (status);
@@ -1007,7 +1416,8 @@ retry:
     count = acbp->bytes_rw;
     error = acbp->last_error;
 #else /* !defined(WIN32) */
-    count = aio_return (acbp);
+    count = dtaio_return(dip, acbp);
+    dtaio_update_latency(dip, acbp, count);
 #endif /* defined(WIN32) */
 
     errno = error;
@@ -1152,7 +1562,12 @@ retry:
     /*
      * Verify the data (unless disabled).
      */
-    if ( (status != FAILURE) && dip->di_compare_flag && (dip->di_io_mode == TEST_MODE)) {
+    if ( (status != FAILURE) && (count > (ssize_t) 0) && (dip->di_aio_mixed == True) ) {
+	/* Mixed reads are verified only when their data is known. */
+	if (dip->di_aio_vreads[acbp - dip->di_acbs] == True) {
+	    status = dtaio_mixed_verify(dip, acbp, count);
+	}
+    } else if ( (status != FAILURE) && dip->di_compare_flag && (dip->di_io_mode == TEST_MODE)) {
 	ssize_t vsize = count;
 	if (dip->di_lbdata_flag || dip->di_iot_pattern) {
 	    dip->di_aio_lba = make_lbdata(dip, (dip->di_volume_bytes + acbp->aio_offset));
@@ -1209,6 +1624,11 @@ dtaio_write_data(struct dinfo *dip)
     register size_t bsize, dsize;
     large_t data_limit;
     u_int32 lba = dip->di_lbdata_addr;
+    iotype_t iotype = dip->di_io_type;
+    optype_t optype = WRITE_OP;
+    int probability_reads = 0, probability_random = 0;
+    int random_percentage = dip->di_random_percentage;
+    hbool_t percentages_flag = False;
 
     if (dip->di_random_access) {
 	if ( (dip->di_io_type == SEQUENTIAL_IO) && (dip->di_io_dir == REVERSE) ) {
@@ -1224,6 +1644,26 @@ dtaio_write_data(struct dinfo *dip)
 
     dsize = get_data_size(dip, WRITE_OP);
     data_limit = get_data_limit(dip);
+#if !defined(WIN32)
+    (void)dtaio_set_anyorder(dip, data_limit);
+#endif /* !defined(WIN32) */
+
+    if (dip->di_read_percentage || dip->di_random_percentage ||
+	dip->di_random_rpercentage || dip->di_random_wpercentage) {
+	percentages_flag = True;
+        /* Don't allow random percentages to exceed the data limit set above. */
+	if (dip->di_random_rpercentage || dip->di_random_wpercentage) {
+            if ( isFileSystemFile(dip) ) {
+                dip->di_rdata_limit = max(dip->di_data_limit, dip->di_max_limit);
+                if (data_limit < dip->di_rdata_limit) {
+                    dip->di_rdata_limit = data_limit;
+                }
+            }
+        }
+    }
+    if ( (status = dtaio_mixed_setup(dip, (percentages_flag) ? data_limit : 0)) == FAILURE) {
+	return (status);
+    }
 
     if ( (dip->di_fill_always == True) || (dip->di_fill_once == True) ) {
 	if ( (dip->di_fill_always == True) || (dip->di_pass_count == 0) ) {
@@ -1238,8 +1678,8 @@ dtaio_write_data(struct dinfo *dip)
      * Now write the specifed number of records.
      */
     while ( (dip->di_error_count < dip->di_error_limit) &&
-	    (dip->di_fbytes_written < data_limit) &&
-	    (dip->di_records_written < dip->di_record_limit) ) {
+	    ((dip->di_fbytes_written + ((percentages_flag) ? dip->di_fbytes_read : 0)) < data_limit) &&
+	    ((dip->di_records_written + ((percentages_flag) ? dip->di_records_read : 0)) < dip->di_record_limit) ) {
 
 	PAUSE_THREAD(dip);
 	if ( THREAD_TERMINATING(dip) ) break;
@@ -1288,6 +1728,35 @@ dtaio_write_data(struct dinfo *dip)
 		mySleep(dip, dip->di_write_delay);
 	    }
 
+	    /*
+	     * Setup for read/write and/or random/sequential percentages (if enabled).
+	     * Note: The AIO byte and record counts include both reads and writes.
+	     */
+	    if (percentages_flag == True) {
+		int read_percentage = dip->di_read_percentage;
+
+		if (read_percentage == -1) {
+		    read_percentage = (int)(get_random(dip) % 100);
+		}
+		if (read_percentage) {
+		    probability_reads  = (int)(get_random(dip) % 100);
+		}
+		probability_random = (int)(get_random(dip) % 100);
+
+		optype = (probability_reads < read_percentage) ? READ_OP : WRITE_OP;
+		if (dip->di_min_size == 0) {
+		    dsize = get_data_size(dip, optype);
+		}
+		if ( (optype == READ_OP) && dip->di_random_rpercentage) {
+		    random_percentage = dip->di_random_rpercentage;
+		} else if ((optype == WRITE_OP) && dip->di_random_wpercentage) {
+		    random_percentage = dip->di_random_wpercentage;
+		} else {
+		    random_percentage = dip->di_random_percentage;
+		}
+		iotype = (probability_random < random_percentage) ? RANDOM_IO : SEQUENTIAL_IO;
+	    }
+
 	    /*
 	     * If data limit was specified, ensure we don't exceed it.
 	     */
@@ -1310,22 +1779,48 @@ dtaio_write_data(struct dinfo *dip)
 		dip->di_data_buffer = (u_char *) acbp->aio_buf;
 	    }
 
-	    if ( (dip->di_io_type == SEQUENTIAL_IO) && (dip->di_io_dir == REVERSE) ) {
+	    if ( (iotype == SEQUENTIAL_IO) && (dip->di_io_dir == REVERSE) ) {
 		/*debug*/ if (!dip->di_aio_offset) abort(); /*debug*/
 		bsize = (size_t)MIN((dip->di_aio_offset - dip->di_file_position), (Offset_t)bsize);
 		dip->di_aio_offset = (Offset_t)(dip->di_aio_offset - bsize);
 	    }
 
             if (dip->di_debug_flag && (bsize != dsize) && !dip->di_variable_flag) {
-                Printf(dip, "Record #%lu, Writing a partial record of %d bytes...\n",
-		       (dip->di_aio_record_count + 1), bsize);
+                Printf(dip, "Record #%lu, %s a partial record of %d bytes...\n",
+		       (dip->di_aio_record_count + 1),
+		       (optype == READ_OP) ? "Reading" : "Writing", bsize);
             }
 
-	    if (dip->di_io_type == RANDOM_IO) {
+	    if (iotype == RANDOM_IO) {
 		acbp->aio_offset = do_random(dip, False, bsize);
 	    } else {
 		acbp->aio_offset = dip->di_aio_offset;
 	    }
+	    acbp->aio_fildes = dip->di_fd;
+            acbp->aio_nbytes = bsize;
+
+	    if (percentages_flag == True) {
+		dip->di_aio_optypes[dip->di_aio_index] = optype;
+		dip->di_aio_vreads[dip->di_aio_index] = False;
+		if ( (optype == READ_OP) && (dip->di_aio_mixed_verify == True) ) {
+		    dip->di_aio_vreads[dip->di_aio_index] =
+			( dtaio_mixed_written(dip, acbp->aio_offset, bsize) &&
+			  (dtaio_mixed_overlap(dip, acbp, optype) == False) );
+		} else if (optype == WRITE_OP) {
+		    (void)dtaio_mixed_overlap(dip, acbp, optype);
+		}
+	    }
+
+	    if (optype == READ_OP) {
+		/*
+		 * Poison the buffer like read_data(), so we know it's written.
+		 */
+		if ( (dip->di_prefill_buffer == True) && dip->di_aio_vreads[dip->di_aio_index] ) {
+		    uint32_t pattern = (dip->di_prefill_pattern) ? dip->di_prefill_pattern : (uint32_t)dip->di_thread_number;
+		    init_buffer(dip, dip->di_data_buffer, bsize, pattern);
+		}
+		goto queue_request;
+	    }
 
 	    if (dip->di_iot_pattern || dip->di_lbdata_flag) {
 		lba = make_lbdata(dip, (dip->di_volume_bytes + acbp->aio_offset));
@@ -1338,6 +1833,11 @@ dtaio_write_data(struct dinfo *dip)
 	        if (dip->di_iot_pattern) {
 		    lba = init_iotdata(dip, dip->di_data_buffer, bsize, lba, dip->di_lbdata_size);
 		} else {
+		    if (dip->di_aio_mixed_verify == True) {
+			/* Start at the offset phase, so mixed reads can be verified. */
+			dip->di_pattern_bufptr = dip->di_pattern_buffer +
+				(size_t)(acbp->aio_offset % dip->di_pattern_bufsize);
+		    }
 		    fill_buffer(dip, dip->di_data_buffer, bsize, dip->di_pattern);
 		}
 	    }
@@ -1364,11 +1864,10 @@ dtaio_write_data(struct dinfo *dip)
 				    dip->di_data_buffer, bsize, (dip->di_aio_record_count + 1));
 	    }
 
-	    acbp->aio_fildes = dip->di_fd;
-            acbp->aio_nbytes = bsize;
-
+queue_request:
 	    if (dip->di_Debug_flag) {
-		report_io(dip, WRITE_MODE, (void *)acbp->aio_buf, acbp->aio_nbytes, acbp->aio_offset);
+		report_io(dip, (optype == READ_OP) ? READ_MODE : WRITE_MODE,
+			  (void *)acbp->aio_buf, acbp->aio_nbytes, acbp->aio_offset);
 	    }
 	    
 #if defined(WIN32)
@@ -1376,8 +1875,13 @@ dtaio_write_data(struct dinfo *dip)
 	    acbp->overlap.hEvent = 0;
 	    acbp->overlap.Offset = ((PLARGE_INTEGER)(&acbp->aio_offset))->LowPart;
 	    acbp->overlap.OffsetHigh = ((PLARGE_INTEGER)(&acbp->aio_offset))->HighPart;
-	    error = WriteFile(acbp->aio_fildes, acbp->aio_buf, (DWORD)acbp->aio_nbytes,
-			      NULL, &acbp->overlap);
+	    if (optype == READ_OP) {
+		error = ReadFile(acbp->aio_fildes, acbp->aio_buf, (DWORD)acbp->aio_nbytes,
+				 NULL, &acbp->overlap);
+	    } else {
+		error = WriteFile(acbp->aio_fildes, acbp->aio_buf, (DWORD)acbp->aio_nbytes,
+				  NULL, &acbp->overlap);
+	    }
 	    if ((!error) && (GetLastError() != ERROR_IO_PENDING)) {
 		error = FAILURE;
 		acbp->aio_fildes = AIO_NotQed;
@@ -1388,16 +1892,19 @@ dtaio_write_data(struct dinfo *dip)
 	    	if ( is_Eof(dip, error, bsize, &error) ) {
 		    break;	/* Process outstanding requests below. */
 		} else {
-		    ReportErrorInfo(dip, dip->di_dname, os_get_error(), "WriteFile", WRITE_OP, True);
+		    ReportErrorInfo(dip, dip->di_dname, os_get_error(),
+				    (optype == READ_OP) ? "ReadFile" : "WriteFile", optype, True);
 		    return (error);
 		}
 	    }
 #else /* !defined(WIN32) */
-# if defined(_AIO_AIX_SOURCE)
-	    if ( (error = aio_write(acbp->aio_fildes, acbp)) == FAILURE) {
-# else /* !defined(_AIO_AIX_SOURCE) */
-	    if ( (error = aio_write(acbp)) == FAILURE) {
-# endif /* defined(_AIO_AIX_SOURCE) */
+	    if (optype == READ_OP) {
+		if ( (error = dtaio_queue_read(dip, acbp)) == FAILURE) {
+		    acbp->aio_fildes = AIO_NotQed;
+		    ReportErrorInfo(dip, dip->di_dname, os_get_error(), OS_AIO_READ, READ_OP, True);
+		    return (error);
+		}
+	    } else if ( (error = dtaio_queue_write(dip, acbp)) == FAILURE) {
 		acbp->aio_fildes = AIO_NotQed;
 		ReportErrorInfo(dip, dip->di_dname, os_get_error(), OS_AIO_WRITE, WRITE_OP, True);
 		return (error);
@@ -1411,7 +1918,9 @@ dtaio_write_data(struct dinfo *dip)
 	    dip->di_aio_file_bytes += bsize;
 	    dip->di_aio_record_count++;
 
-	    if (dip->di_io_dir == FORWARD) {
+	    /* Note: With percentages, only sequential I/O advances our offset. */
+	    if ( (dip->di_io_dir == FORWARD) &&
+		 ((percentages_flag == False) || (iotype == SEQUENTIAL_IO)) ) {
 		dip->di_aio_offset += bsize;
 	    } 
 
@@ -1453,8 +1962,15 @@ dtaio_write_data(struct dinfo *dip)
 	    }
 	    acbp = &dip->di_acbs[dip->di_aio_index];
 	    if (acbp->aio_fildes == AIO_NotQed) continue; /* Never Q'ed. */
+#if !defined(WIN32)
+	    if (dip->di_aio_anyorder == True) {
+		/* Process whichever completes first, then reuse its slot. */
+		if ( (acbp = dtaio_wait_any(dip)) == NULL) return (FAILURE);
+		dip->di_aio_index = (int)(acbp - dip->di_acbs);
+	    }
+#endif /* !defined(WIN32) */
 
-	    if ( (status = dtaio_process_write(dip, acbp)) == FAILURE) {
+	    if ( (status = dtaio_process_request(dip, acbp)) == FAILURE) {
 		return (status);
 	    }
 	    if (dip->di_end_of_file) break;
@@ -1517,7 +2033,8 @@ retry:
     count = acbp->bytes_rw; 
     error = acbp->last_error;
 #else /* !defined(WIN32) */
-    count = aio_return(acbp);
+    count = dtaio_return(dip, acbp);
+    dtaio_update_latency(dip, acbp, count);
 #endif /* defined(WIN32) */
 
     errno = error;
@@ -1661,6 +2178,9 @@ retry:
 	    }
         }
 	dip->di_offset = acbp->aio_offset;
+	if (dip->di_aio_mixed_verify == True) {
+	    dtaio_mixed_update(dip, acbp->aio_offset, (size_t)count);
+	}
     }
     status = check_write(dip, count, bsize, acbp->aio_offset);
     if (status == FAILURE) {
@@ -1693,6 +2213,18 @@ retry:
 	status = write_verify(dip, (u_char *)acbp->aio_buf, count, dsize, acbp->aio_offset);
 	if ( (status == FAILURE) && (dip->di_error_count >= dip->di_error_limit) ) {
 	    return (status);
+	} else if ( (status != FAILURE) && (dip->di_aio_mixed == True) ) {
+	    /* Note: Undo the read statistics, so percentages are more accurate. */
+	    dip->di_records_read--;
+	    dip->di_dbytes_read -= count;
+	    dip->di_fbytes_read -= count;
+	    dip->di_vbytes_read -= count;
+	    dip->di_maxdata_read -= count;
+	    if ((size_t)count == dsize) {
+		dip->di_full_reads--;
+	    } else {
+		dip->di_partial_reads--;
+	    }
 	}
     }
 
@@ -1713,4 +2245,205 @@ retry:
     return (status);
 }
 
+/*
+ * dtaio_request_mode() - Return the Mode of an AIO Request.
+ *
+ * Description:
+ *	With read/write percentages, each request has its own operation,
+ * otherwise all requests are in the current read or write mode.
+ */
+static test_mode_t
+dtaio_request_mode(struct dinfo *dip, struct aiocb *acbp)
+{
+    if ( (dip->di_aio_mixed == True) && dip->di_aio_optypes ) {
+	return( (dip->di_aio_optypes[acbp - dip->di_acbs] == READ_OP) ? READ_MODE : WRITE_MODE );
+    }
+    return (dip->di_mode);
+}
+
+/*
+ * dtaio_process_request() - Process a Write Pass AIO Request.
+ *
+ * Description:
+ *	Reads queued by the read percentage are processed in read mode, so
+ * statistics, latencies, and error reports reflect the operation.
+ */
+static int
+dtaio_process_request(struct dinfo *dip, struct aiocb *acbp)
+{
+    int status;
+
+    if (dtaio_request_mode(dip, acbp) == WRITE_MODE) {
+	return( dtaio_process_write(dip, acbp) );
+    }
+    dip->di_mode = READ_MODE;
+    status = dtaio_process_read(dip, acbp);
+    dip->di_mode = WRITE_MODE;
+    return (status);
+}
+
+/*
+ * The mixed I/O written bitmap is limited to this size, which tracks 64g
+ * of 512 byte blocks. Beyond this, mixed reads are not verified.
+ */
+#define AIO_MIXED_MAP_MAX	(16 * MBYTE_SIZE)
+
+/*
+ * dtaio_mixed_setup() - Setup Mixed Read/Write Percentages.
+ *
+ * Description:
+ *	Mixed reads are verified when the blocks were written during this
+ * pass, and the expected data is derived from the offset alone. Therefore,
+ * btags, timestamps, and prefixes, which describe the write, are excluded.
+ * Writes start the pattern at the offset phase, so any block compares.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	data_limit = The data limit, or zero if percentages are disabled.
+ *
+ * Return Value:
+ *	Returns SUCCESS/FAILURE = Ok/Allocation failed.
+ */
+static int
+dtaio_mixed_setup(struct dinfo *dip, large_t data_limit)
+{
+    large_t blocks, end;
+
+    dip->di_aio_mixed = dip->di_aio_mixed_verify = False;
+    if (data_limit == 0) return (SUCCESS);
+    dip->di_aio_mixed = True;
+
+    if ( (dip->di_read_percentage == 0) || (dip->di_compare_flag == False) ||
+	 (dip->di_io_mode != TEST_MODE) || (dip->di_random_access == False) ||
+	 dip->di_btag_flag || dip->di_timestamp_flag || dip->di_fprefix_string ||
+	 dip->di_iolock || dip->di_volumes_flag || (dip->di_pattern_buffer == NULL) ) {
+	return (SUCCESS);
+    }
+    end = max(dip->di_rdata_limit, (dip->di_file_position + data_limit));
+    blocks = howmany(end, dip->di_dsize);
+    if (howmany(blocks, BITS_PER_BYTE) > AIO_MIXED_MAP_MAX) {
+	if (dip->di_debug_flag && (dip->di_pass_count == 0) ) {
+	    Printf(dip, "The written map for " LUF " blocks is too large, mixed reads are not verified.\n",
+		   blocks);
+	}
+	return (SUCCESS);
+    }
+    if (blocks != dip->di_aio_wmap_blocks) {
+	if (dip->di_aio_wmap) Free(dip, dip->di_aio_wmap);
+	dip->di_aio_wmap = Malloc(dip, (size_t)howmany(blocks, BITS_PER_BYTE));
+	if (dip->di_aio_wmap == NULL) return (FAILURE);
+	dip->di_aio_wmap_blocks = blocks;
+    } else {
+	/* A new pass means a new pattern, so nothing is written yet. */
+	memset(dip->di_aio_wmap, '\0', (size_t)howmany(blocks, BITS_PER_BYTE));
+    }
+    dip->di_aio_mixed_verify = True;
+    return (SUCCESS);
+}
+
+/*
+ * dtaio_mixed_written() - Check if all Blocks have been Written.
+ *
+ * Description:
+ *	Every block the read touches must be written, and with IOT or lbdata
+ * patterns, the read must start on a logical block (as the compare does).
+ */
+static hbool_t
+dtaio_mixed_written(struct dinfo *dip, Offset_t offset, size_t bytes)
+{
+    large_t block, end;
+
+    if ( (dip->di_iot_pattern || dip->di_lbdata_flag) && (offset % dip->di_lbdata_size) ) {
+	return (False);
+    }
+    block = (large_t)(offset / dip->di_dsize);
+    end = howmany((large_t)offset + bytes, dip->di_dsize);
+    if (end > dip->di_aio_wmap_blocks) return (False);
+    for (; block < end; block++) {
+	if ( (dip->di_aio_wmap[block / BITS_PER_BYTE] & (1 << (block % BITS_PER_BYTE))) == 0 ) {
+	    return (False);
+	}
+    }
+    return (True);
+}
+
+/*
+ * dtaio_mixed_update() - Mark the Fully Written Blocks.
+ */
+static void
+dtaio_mixed_update(struct dinfo *dip, Offset_t offset, size_t bytes)
+{
+    large_t block, end;
+
+    block = howmany((large_t)offset, dip->di_dsize);
+    end = (large_t)((offset + bytes) / dip->di_dsize);
+    if (end > dip->di_aio_wmap_blocks) end = dip->di_aio_wmap_blocks;
+    for (; block < end; block++) {
+	dip->di_aio_wmap[block / BITS_PER_BYTE] |= (1 << (block % BITS_PER_BYTE));
+    }
+    return;
+}
+
+/*
+ * dtaio_mixed_overlap() - Check Outstanding Requests for Overlap.
+ *
+ * Description:
+ *	A read overlapping an outstanding write may return either data, so
+ * it is not verified. Likewise, a new write stops verifying outstanding
+ * reads it overlaps.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	acbp = The AIO control block being queued.
+ *	optype = The operation being queued.
+ *
+ * Return Value:
+ *	Returns True if an outstanding write overlaps a read.
+ */
+static hbool_t
+dtaio_mixed_overlap(struct dinfo *dip, struct aiocb *acbp, optype_t optype)
+{
+    struct aiocb *oacbp;
+    int index;
+
+    for (index = 0, oacbp = dip->di_acbs; index < dip->di_aio_bufs; index++, oacbp++) {
+	if ( (oacbp == acbp) || (oacbp->aio_fildes == AIO_NotQed) ) continue;
+	if ( (oacbp->aio_offset >= (Offset_t)(acbp->aio_offset + acbp->aio_nbytes)) ||
+	     (acbp->aio_offset >= (Offset_t)(oacbp->aio_offset + oacbp->aio_nbytes)) ) {
+	    continue;
+	}
+	if (dip->di_aio_optypes[index] == WRITE_OP) {
+	    if (optype == READ_OP) return (True);
+	} else if (optype == WRITE_OP) {
+	    dip->di_aio_vreads[index] = False;
+	}
+    }
+    return (False);
+}
+
+/*
+ * dtaio_mixed_verify() - Verify a Mixed Read Request.
+ *
+ * Description:
+ *	The expected data is generated from the offset, the same way the
+ * writes initialized the blocks (see dtaio_write_data()).
+ */
+static int
+dtaio_mixed_verify(struct dinfo *dip, struct aiocb *acbp, ssize_t count)
+{
+    struct dtfuncs *dtf = dip->di_funcs;
+    u_int32 lba = 0;
+
+    if (dip->di_lbdata_flag || dip->di_iot_pattern) {
+	lba = make_lbdata(dip, (dip->di_volume_bytes + acbp->aio_offset));
+    }
+    if (dip->di_iot_pattern) {
+	(void)init_iotdata(dip, dip->di_pattern_buffer, count, lba, dip->di_lbdata_size);
+    } else {
+	dip->di_pattern_bufptr = dip->di_pattern_buffer +
+		(size_t)(acbp->aio_offset % dip->di_pattern_bufsize);
+    }
+    return( (*dtf->tf_verify_data)(dip, (u_char *)acbp->aio_buf, count, dip->di_pattern, &lba, False) );
+}
+
 #endif /* defined(AIO) */
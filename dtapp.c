@@ -29,6 +29,14 @@
  * 
  * Modification History: 
  *  
+ * October 16th, 2026 by Robin T. Miller
+ *      With fanout, honor random I/O, read/write delays, and volume limits,
+ * and return a failure from any device, not just the status of the last.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the "fanout" option, to issue a record to every device at once
+ * using per device worker threads, rather than one device at a time.
+ * 
  * October 30th, 2025 by Robin T. Miller
  *      Convert microsecond variables from 32-bits to 64 bits.
  * 
@@ -89,8 +97,38 @@ typedef struct dtapp_information {
     int dta_write_order_index;      /* The current write order index.	        */
     btag_write_order_t *dta_write_orders; /* Write order table (array).         */
     btag_write_order_t *dta_last_write_order; /* Pointer to last entry.         */
+    hbool_t dta_fanout_flag;        /* Issue to all devices concurrently.       */
 } dtapp_information_t;
 
+/*
+ * Parallel Fan-out Information: (one worker thread per device)
+ */
+typedef enum dtapp_fanout_op {
+    FANOUT_OP_NONE, FANOUT_OP_READ, FANOUT_OP_WRITE, FANOUT_OP_EXIT
+} dtapp_fanout_op_t;
+
+typedef struct dtapp_fanout_request {
+    struct dtapp_fanout *fr_fanout; /* Pointer to the fan-out information.      */
+    dinfo_t *fr_dip;                /* The device information for this worker.  */
+    pthread_t fr_thread;            /* The worker thread ID.                    */
+    dtapp_fanout_op_t fr_op;        /* The operation for this round.            */
+    size_t fr_bsize;                /* The request size.                        */
+    size_t fr_dsize;                /* The data size (for partial records).     */
+    lbdata_t fr_lba;                /* The starting logical block address.      */
+    ssize_t fr_count;               /* The completed transfer count.            */
+    int fr_status;                  /* The completion status.                   */
+} dtapp_fanout_request_t;
+
+typedef struct dtapp_fanout {
+    pthread_mutex_t fo_lock;        /* Protects the round state below.          */
+    pthread_cond_t fo_start;        /* Signaled to start a round.               */
+    pthread_cond_t fo_done;         /* Signaled when the round completes.       */
+    uint64_t fo_generation;         /* The round generation number.             */
+    int fo_pending;                 /* The workers still busy this round.       */
+    int fo_count;                   /* The number of worker threads.            */
+    dtapp_fanout_request_t *fo_requests; /* The per device requests.            */
+} dtapp_fanout_t;
+
 /*
  * Forward References: 
  */
@@ -179,6 +217,13 @@ int dtapp_common_device_setup(dinfo_t *dip);
 
 int dtapp_read_data(dinfo_t *dip);
 int dtapp_write_data(dinfo_t *dip);
+int dtapp_read_data_fanout(dinfo_t *dip);
+int dtapp_write_data_fanout(dinfo_t *dip);
+lbdata_t dtapp_init_write_buffer(dinfo_t *dip, dinfo_t *odip, size_t bsize, lbdata_t lba);
+void *dtapp_fanout_worker(void *arg);
+void dtapp_fanout_issue(dtapp_fanout_t *fop);
+int dtapp_fanout_start(dinfo_t *dip, dtapp_fanout_t *fop, dinfo_t **dips, int device_count);
+void dtapp_fanout_stop(dinfo_t *dip, dtapp_fanout_t *fop);
 
 int dtapp_report_btag(dinfo_t *dip, btag_t *ebtag, btag_t *rbtag, hbool_t raw_flag);
 int dtapp_update_btag(dinfo_t *dip, btag_t *btag, Offset_t offset,
@@ -301,6 +346,10 @@ dtapp_parser(dinfo_t *dip, char *option)
         dtapp_help(dip);
         return(STOP_PARSING);
     }
+    if (match(&option, "fanout")) {
+        dtap->dta_fanout_flag = True;
+        return(status);
+    }
     /* Add dtapp specific parsing here... */
     return(PARSE_NOMATCH);
 }
@@ -1770,6 +1819,14 @@ dtapp_validate_parameters(dinfo_t *dip)
 	dip->di_random_io = False;
 	dip->di_vary_iotype = False;
     }
+    /*
+     * The fan-out loops do not implement per record locking, steps, or IOPS.
+     */
+    if ( (dtap->dta_fanout_flag == True) &&
+	 ( (dip->di_lock_files == True) || dip->di_step_offset || dip->di_iops ) ) {
+	Wprintf(dip, "Disabling fanout, since not supported with file locks, step, or iops!\n");
+	dtap->dta_fanout_flag = False;
+    }
     return(status);
 }
 
@@ -1784,6 +1841,7 @@ dtapp_help(dinfo_t *dip)
     P(dip, "\nOptions:\n");
     P(dip, "\thelp                    Show this help text, then exit.\n");
     P(dip, "\tversion                 Print the version, then exit.\n");
+    P(dip, "\tfanout                  Issue each record to all devices concurrently.\n");
     /* Add dtapp specific help here! */
     P(dip, "\n");
     return;
@@ -1791,6 +1849,571 @@ dtapp_help(dinfo_t *dip)
 
 /* ============================================================================= */
 
+/*
+ * Parallel Fan-out Support:
+ *
+ * With fanout, each loop iteration issues one record to every device, and
+ * the per device I/O's are done concurrently by per device worker threads.
+ * Buffer preparation and post-processing (verification, btag write orders)
+ * remain serial on the dtapp thread, in device order, so each btag written
+ * in a round references the last write of the previous round, which was
+ * complete before any of the round's writes were issued.
+ */
+void *
+dtapp_fanout_worker(void *arg)
+{
+    dtapp_fanout_request_t *frp = arg;
+    dtapp_fanout_t *fop = frp->fr_fanout;
+    dinfo_t *dip = frp->fr_dip;
+    uint64_t generation = 0;
+    dtapp_fanout_op_t op;
+    ssize_t count = 0;
+    int status;
+
+    for (;;) {
+	(void)pthread_mutex_lock(&fop->fo_lock);
+	while (fop->fo_generation == generation) {
+	    (void)pthread_cond_wait(&fop->fo_start, &fop->fo_lock);
+	}
+	generation = fop->fo_generation;
+	op = frp->fr_op;
+	(void)pthread_mutex_unlock(&fop->fo_lock);
+
+	if (op == FANOUT_OP_EXIT) break;
+
+	status = SUCCESS;
+	if (op == FANOUT_OP_READ) {
+	    dip->di_retry_count = 0;
+	    do {
+		count = read_record(dip, dip->di_data_buffer, frp->fr_bsize, frp->fr_dsize,
+				    dip->di_offset, &status);
+	    } while (status == RETRYABLE);
+	} else if (op == FANOUT_OP_WRITE) {
+	    dip->di_retry_count = 0;
+	    do {
+		count = write_record(dip, dip->di_data_buffer, frp->fr_bsize, frp->fr_dsize,
+				     dip->di_offset, &status);
+	    } while (status == RETRYABLE);
+	}
+	frp->fr_count = count;
+	frp->fr_status = status;
+
+	(void)pthread_mutex_lock(&fop->fo_lock);
+	if (--fop->fo_pending == 0) {
+	    (void)pthread_cond_signal(&fop->fo_done);
+	}
+	(void)pthread_mutex_unlock(&fop->fo_lock);
+    }
+    return(NULL);
+}
+
+/*
+ * dtapp_fanout_issue() - Start the Round of I/O's and Wait for Completion.
+ */
+void
+dtapp_fanout_issue(dtapp_fanout_t *fop)
+{
+    (void)pthread_mutex_lock(&fop->fo_lock);
+    fop->fo_pending = fop->fo_count;
+    fop->fo_generation++;
+    (void)pthread_cond_broadcast(&fop->fo_start);
+    while (fop->fo_pending) {
+	(void)pthread_cond_wait(&fop->fo_done, &fop->fo_lock);
+    }
+    (void)pthread_mutex_unlock(&fop->fo_lock);
+    return;
+}
+
+int
+dtapp_fanout_start(dinfo_t *dip, dtapp_fanout_t *fop, dinfo_t **dips, int device_count)
+{
+    dtapp_fanout_request_t *frp;
+    int device, pstatus;
+
+    memset(fop, '\0', sizeof(*fop));
+    fop->fo_requests = Malloc(dip, (sizeof(*frp) * device_count));
+    if (fop->fo_requests == NULL) return(FAILURE);
+    (void)pthread_mutex_init(&fop->fo_lock, NULL);
+    (void)pthread_cond_init(&fop->fo_start, NULL);
+    (void)pthread_cond_init(&fop->fo_done, NULL);
+
+    for (device = 0; (device < device_count); device++) {
+	frp = &fop->fo_requests[device];
+	frp->fr_fanout = fop;
+	frp->fr_dip = dips[device];
+	frp->fr_op = FANOUT_OP_NONE;
+	pstatus = pthread_create(&frp->fr_thread, tjattrp, dtapp_fanout_worker, frp);
+	if (pstatus != SUCCESS) {
+	    tPerror(dip, pstatus, "pthread_create() failed for fanout device %s",
+		    frp->fr_dip->di_dname);
+	    dtapp_fanout_stop(dip, fop);
+	    return(FAILURE);
+	}
+	fop->fo_count++;
+    }
+    return(SUCCESS);
+}
+
+void
+dtapp_fanout_stop(dinfo_t *dip, dtapp_fanout_t *fop)
+{
+    void *thread_status = NULL;
+    int device;
+
+    if (fop->fo_requests == NULL) return;
+    for (device = 0; (device < fop->fo_count); device++) {
+	fop->fo_requests[device].fr_op = FANOUT_OP_EXIT;
+    }
+    (void)pthread_mutex_lock(&fop->fo_lock);
+    fop->fo_generation++;
+    (void)pthread_cond_broadcast(&fop->fo_start);
+    (void)pthread_mutex_unlock(&fop->fo_lock);
+    for (device = 0; (device < fop->fo_count); device++) {
+	(void)pthread_join(fop->fo_requests[device].fr_thread, &thread_status);
+    }
+#if !defined(WIN32)
+    (void)pthread_cond_destroy(&fop->fo_start);
+    (void)pthread_cond_destroy(&fop->fo_done);
+#endif /* !defined(WIN32) */
+    (void)pthread_mutex_destroy(&fop->fo_lock);
+    Free(dip, fop->fo_requests);
+    fop->fo_requests = NULL;
+    fop->fo_count = 0;
+    return;
+}
+
+/*
+ * dtapp_read_data_fanout() - Read a Record from Each Device Concurrently.
+ */
+int
+dtapp_read_data_fanout(dinfo_t *dip)
+{
+    dtapp_information_t *dtap = dip->di_opaque;
+    dtapp_fanout_t fanout;
+    dtapp_fanout_t *fop = &fanout;
+    dtapp_fanout_request_t *frp;
+    dinfo_t *idip;
+    dinfo_t **dips;
+    int device, device_count, round_count;
+    ssize_t count;
+    size_t bsize, dsize;
+    large_t data_limit;
+    large_t fbytes_read = 0, records_read = 0;
+    unsigned long error_count = 0;
+    hbool_t end_of_test = False;
+    int status = SUCCESS, result = SUCCESS;
+
+    if (dip->di_ftype == INPUT_FILE) {
+        dips = dtap->dta_input_dips;
+        device_count = dtap->dta_input_count;
+    } else { /* OUTPUT_FILE */
+        dips = dtap->dta_output_dips;
+        device_count = dtap->dta_output_count;
+    }
+
+    dsize = get_data_size(dip, READ_OP);
+    data_limit = dtapp_get_data_limit(dip, dtap);
+
+    status = dtapp_set_device_offsets(dip, dtap);
+    if (status == FAILURE) return(status);
+
+    status = dtapp_fanout_start(dip, fop, dips, device_count);
+    if (status == FAILURE) return(status);
+
+    while ( (end_of_test == False) &&
+	    (error_count < dip->di_error_limit) &&
+	    (fbytes_read < data_limit) &&
+	    (records_read < dip->di_record_limit) ) {
+
+	PAUSE_THREAD(dip);
+	if ( THREAD_TERMINATING(dip) ) break;
+	if (dip->di_terminating) break;
+
+	/*
+	 * Prepare a record for each device (serially).
+	 */
+	round_count = 0;
+	for (device = 0; (device < device_count); device++) {
+	    frp = &fop->fo_requests[device];
+	    frp->fr_op = FANOUT_OP_NONE;
+	    if ( (end_of_test == True) ||
+		 ((records_read + round_count) >= dip->di_record_limit) ) {
+		continue;
+	    }
+	    idip = dips[device];
+	    if ( idip->di_max_data && (idip->di_maxdata_read >= idip->di_max_data) ) {
+		idip->di_maxdata_reached = True;
+		end_of_test = True;
+		continue;
+	    }
+	    if ( idip->di_volumes_flag &&
+		 (idip->di_multi_volume >= idip->di_volume_limit) &&
+		 (idip->di_volume_records >= idip->di_volume_records) ) {
+		end_of_test = True;
+		continue;
+	    }
+	    if (idip->di_read_delay) {			/* Optional read delay.	*/
+		mySleep(dip, idip->di_read_delay);
+	    }
+	    /* Note: With slices, we MUST honor the per device limits! */
+	    if ( (idip->di_lbytes_read + dsize) > idip->di_data_limit) {
+		bsize = (size_t)(idip->di_data_limit - idip->di_lbytes_read);
+		if (bsize == 0) {
+		    set_Eof(idip);
+		    end_of_test = True;
+		    continue;
+		}
+	    } else {
+		bsize = dsize;
+	    }
+	    if ( (idip->di_io_type == SEQUENTIAL_IO) && (idip->di_io_dir == REVERSE) ) {
+		bsize = (size_t)MIN((idip->di_offset - idip->di_file_position), (Offset_t)bsize);
+		idip->di_offset = set_position(idip, (Offset_t)(idip->di_offset - bsize), False);
+	    } else if (idip->di_io_type == RANDOM_IO) {
+		/* Note: The size *must* match the write size (see dtapp_read_data). */
+		idip->di_offset = do_random(idip, True, bsize);
+	    }
+	    if (idip->di_iot_pattern || idip->di_lbdata_flag) {
+		frp->fr_lba = make_lbdata(idip, (Offset_t)(idip->di_volume_bytes + idip->di_offset));
+	    } else {
+		frp->fr_lba = make_lbdata(idip, idip->di_offset);
+	    }
+	    if (idip->di_rotate_flag) {
+		idip->di_data_buffer = (idip->di_base_buffer + (idip->di_rotate_offset++ % ROTATE_SIZE));
+	    }
+	    if ( (idip->di_io_mode == TEST_MODE) && (idip->di_compare_flag == True) ) {
+		init_padbytes(idip->di_data_buffer, bsize, ~idip->di_pattern);
+		if (idip->di_iot_pattern) {
+		    if (idip->di_btag) {
+			update_buffer_btags(idip, idip->di_btag, idip->di_offset,
+					    idip->di_pattern_buffer, bsize, (idip->di_records_read + 1));
+		    }
+		    frp->fr_lba = init_iotdata(idip, idip->di_pattern_buffer, bsize,
+					       frp->fr_lba, idip->di_lbdata_size);
+		}
+	    }
+	    if (dip->di_Debug_flag) {
+		Printf(idip, "Index: %d, Device: %s\n", device, idip->di_dname);
+		report_io(idip, READ_MODE, idip->di_data_buffer, bsize, idip->di_offset);
+	    }
+	    frp->fr_bsize = bsize;
+	    frp->fr_dsize = dsize;
+	    frp->fr_op = FANOUT_OP_READ;
+	    round_count++;
+	}
+	if (round_count == 0) break;
+
+	dtapp_fanout_issue(fop);
+
+	/*
+	 * Verify each record (serially, in device order).
+	 */
+	for (device = 0; (device < device_count); device++) {
+	    frp = &fop->fo_requests[device];
+	    if (frp->fr_op != FANOUT_OP_READ) continue;
+	    dtap->dta_current_index = device;
+	    idip = dips[device];
+	    count = frp->fr_count;
+	    status = frp->fr_status;
+	    if (status == FAILURE) result = FAILURE;
+	    if (idip->di_end_of_file) {
+		end_of_test = True;
+		continue;
+	    }
+	    if ( (status != FAILURE) && dip->di_compare_flag && (dip->di_io_mode == TEST_MODE) ) {
+		status = (*idip->di_funcs->tf_verify_data)(idip, idip->di_data_buffer, count,
+							   idip->di_pattern, &frp->fr_lba, False);
+		if ( (status == SUCCESS) && dip->di_pad_check) {
+		    (void)verify_padbytes(idip, idip->di_data_buffer, count, ~idip->di_pattern, frp->fr_bsize);
+		}
+	    }
+	    if (status == SUCCESS) {
+		idip->di_offset += count;
+		status = verify_btag_write_order(idip, (btag_t *)idip->di_data_buffer, (size_t)count);
+		idip->di_offset -= count;
+	    }
+	    if (status == FAILURE) result = FAILURE;
+	    fbytes_read += count;
+	    records_read++;
+	    idip->di_lbytes_read += count;
+	    idip->di_records_read++;
+	    idip->di_volume_records++;
+
+	    if (idip->di_io_dir == FORWARD) {
+		idip->di_offset += count;
+	    } else if ( (idip->di_io_type == SEQUENTIAL_IO) &&
+			(idip->di_offset == (Offset_t)idip->di_file_position) ) {
+		set_Eof(idip);
+		end_of_test = True;
+	    }
+	}
+
+	/*
+	 * For variable length records, adjust the next record size.
+	 */
+	if (dip->di_min_size) {
+	    if (dip->di_variable_flag) {
+		dsize = get_variable(dip);
+	    } else {
+		dsize += dip->di_incr_count;
+	        if (dsize > dip->di_max_size) dsize = dip->di_min_size;
+	    }
+	}
+        error_count = 0;
+        IterateInputDevices(dtap, dtapp_error_count, &error_count);
+    }
+    dtapp_fanout_stop(dip, fop);
+    return(result);
+}
+
+/*
+ * dtapp_write_data_fanout() - Write a Record to Each Device Concurrently.
+ */
+int
+dtapp_write_data_fanout(dinfo_t *dip)
+{
+    dtapp_information_t *dtap = dip->di_opaque;
+    dtapp_fanout_t fanout;
+    dtapp_fanout_t *fop = &fanout;
+    dtapp_fanout_request_t *frp;
+    dinfo_t *idip = NULL, *odip = NULL;
+    dinfo_t **dips = dtap->dta_output_dips;
+    int device, device_count = dtap->dta_output_count, round_count;
+    ssize_t count;
+    size_t bsize, dsize;
+    large_t data_limit;
+    large_t fbytes_written = 0, records_written = 0;
+    unsigned long error_count = 0;
+    hbool_t end_of_test = False;
+    int rc, status = SUCCESS, result = SUCCESS;
+
+    dsize = get_data_size(dip, WRITE_OP);
+    data_limit = dtapp_get_data_limit(dip, dtap);
+
+    dtapp_set_device_offsets(dip, dtap);
+    status = dtapp_setup_write_orders(dip, dtap, dtap->dta_output_count);
+    if (status == FAILURE) return(status);
+
+    status = dtapp_fanout_start(dip, fop, dips, device_count);
+    if (status == FAILURE) return(status);
+
+    while ( (end_of_test == False) &&
+	    (error_count < dip->di_error_limit) &&
+	    (fbytes_written < data_limit) &&
+	    (records_written < dip->di_record_limit) ) {
+
+	PAUSE_THREAD(dip);
+	if ( THREAD_TERMINATING(dip) ) break;
+	if (dip->di_terminating) break;
+
+	/*
+	 * Prepare a record for each device (serially). All btags in this
+	 * round reference the last write order of the previous round.
+	 */
+	round_count = 0;
+	for (device = 0; (device < device_count); device++) {
+	    frp = &fop->fo_requests[device];
+	    frp->fr_op = FANOUT_OP_NONE;
+	    if ( (end_of_test == True) ||
+		 ((records_written + round_count) >= dip->di_record_limit) ) {
+		continue;
+	    }
+	    odip = dips[device];
+	    idip = (dtap->dta_input_dips) ? dtap->dta_input_dips[device] : NULL;
+	    if ( odip->di_max_data && (odip->di_maxdata_written >= odip->di_max_data) ) {
+		odip->di_maxdata_reached = True;
+		end_of_test = True;
+		continue;
+	    }
+	    if ( odip->di_volumes_flag &&
+		 (odip->di_multi_volume >= odip->di_volume_limit) &&
+		 (odip->di_volume_records >= odip->di_volume_records) ) {
+		end_of_test = True;
+		continue;
+	    }
+	    if (odip->di_write_delay) {			/* Optional write delay	*/
+		mySleep(odip, odip->di_write_delay);
+	    }
+	    /* Note: With slices, we MUST honor the per device limits! */
+	    if ( (odip->di_lbytes_written + dsize) > odip->di_data_limit) {
+		bsize = (size_t)(odip->di_data_limit - odip->di_lbytes_written);
+		if (bsize == 0) {
+		    set_Eof(odip);
+		    end_of_test = True;
+		    continue;
+		}
+	    } else {
+		bsize = dsize;
+	    }
+	    if ( (odip->di_io_type == SEQUENTIAL_IO) && (odip->di_io_dir == REVERSE) ) {
+		bsize = MIN((size_t)(odip->di_offset - odip->di_file_position), bsize);
+		odip->di_offset = set_position(odip, (Offset_t)(odip->di_offset - bsize), False);
+		if (idip) {
+		    idip->di_offset = set_position(idip, (Offset_t)(idip->di_offset - bsize), False);
+		}
+	    } else if (odip->di_io_type == RANDOM_IO) {
+		odip->di_offset = do_random(odip, True, bsize);
+		if (idip) {
+		    idip->di_offset = odip->di_offset;
+		    set_position(idip, idip->di_offset, False);
+		}
+	    }
+	    if (dip->di_iot_pattern || dip->di_lbdata_flag) {
+		frp->fr_lba = make_lbdata(odip, (Offset_t)(odip->di_volume_bytes + odip->di_offset));
+	    } else {
+		frp->fr_lba = make_lbdata(odip, odip->di_offset);
+	    }
+	    if (dip->di_rotate_flag) {
+		odip->di_data_buffer = (odip->di_base_buffer + (odip->di_rotate_offset++ % ROTATE_SIZE));
+	    }
+	    if ( (dip->di_compare_flag == True) &&
+		 ( (dip->di_io_mode == MIRROR_MODE) || (dip->di_io_mode == TEST_MODE) ) ) {
+		frp->fr_lba = dtapp_init_write_buffer(dip, odip, bsize, frp->fr_lba);
+	    }
+	    if (dip->di_Debug_flag) {
+		Printf(odip, "Index: %d, Device: %s\n", device, odip->di_dname);
+		report_io(odip, WRITE_MODE, odip->di_data_buffer, bsize, odip->di_offset);
+	    }
+	    frp->fr_bsize = bsize;
+	    frp->fr_dsize = dsize;
+	    frp->fr_op = FANOUT_OP_WRITE;
+	    round_count++;
+	}
+	if (round_count == 0) break;
+
+	dtapp_fanout_issue(fop);
+
+	/*
+	 * Complete each write (serially, in device order).
+	 */
+	for (device = 0; (device < device_count); device++) {
+	    hbool_t partial = False;
+
+	    frp = &fop->fo_requests[device];
+	    if (frp->fr_op != FANOUT_OP_WRITE) continue;
+	    dtap->dta_current_index = device;
+	    odip = dips[device];
+	    idip = (dtap->dta_input_dips) ? dtap->dta_input_dips[device] : NULL;
+	    bsize = frp->fr_bsize;
+	    count = frp->fr_count;
+	    status = frp->fr_status;
+	    if (status == FAILURE) result = FAILURE;
+	    if (odip->di_end_of_file) {
+		end_of_test = True;
+		continue;
+	    }
+	    if (status != FAILURE) {
+		partial = (count < (ssize_t)bsize) ? True : False;
+	    }
+	    if ( (status == SUCCESS) && (dip->di_io_mode == MIRROR_MODE) ) {
+		(void)verify_record(idip, odip->di_data_buffer, count, odip->di_offset, &status);
+		if (idip->di_end_of_file) {
+		    odip->di_end_of_file = idip->di_end_of_file;
+		    end_of_test = True;
+		    continue;
+		}
+		if (status == FAILURE) {
+		    dip->di_error_count++;
+		}
+		if ( (status == SUCCESS) && (odip->di_raw_flag == False) && (dip->di_dump_btags == False) ) {
+		    idip->di_offset += count;
+		    status = verify_btag_write_order(idip, (btag_t *)idip->di_data_buffer, (size_t)count);
+		    idip->di_offset -= count;
+		}
+		if (status == FAILURE) result = FAILURE;
+	    }
+	    fbytes_written += count;
+	    records_written++;
+	    odip->di_lbytes_written += count;
+	    odip->di_records_written++;
+	    odip->di_volume_records++;
+
+	    if ( odip->di_fsync_frequency && ((odip->di_records_written % odip->di_fsync_frequency) == 0) ) {
+		status = (*odip->di_funcs->tf_flush_data)(odip);
+	    }
+	    if ( (count > (ssize_t) 0) && odip->di_raw_flag) {
+		status = write_verify(odip, odip->di_data_buffer, count, dsize, odip->di_offset);
+		if (status == SUCCESS) {
+		    odip->di_offset += count;
+		    status = verify_btag_write_order(odip, (btag_t *)odip->di_data_buffer, (size_t)count);
+		    odip->di_offset -= count;
+		}
+	    }
+	    if (status == FAILURE) result = FAILURE;
+	    if ( (status == SUCCESS) && odip->di_btag ) {
+		dtapp_set_write_order_entry(odip, odip->di_btag);
+	    }
+	    if ( partial && (odip->di_dtype->dt_dtype == DT_REGULAR) ) {
+		odip->di_last_write_size = count;
+		odip->di_last_write_attempted = frp->fr_dsize;
+		odip->di_last_write_offset = odip->di_offset;
+		odip->di_no_space_left = True;
+		odip->di_file_system_full = True;
+		set_Eof(odip);
+		end_of_test = True;
+		continue;
+	    }
+	    if (odip->di_io_dir == FORWARD) {
+		odip->di_offset += count;
+		if (idip) idip->di_offset += count;
+	    } else if ( (odip->di_io_type == SEQUENTIAL_IO) &&
+			(odip->di_offset == (Offset_t)odip->di_file_position) ) {
+		set_Eof(odip);
+		dip->di_beginning_of_file = True;
+		end_of_test = True;
+	    }
+	}
+
+	/*
+	 * For variable length records, adjust the next record size.
+	 */
+	if (dip->di_min_size) {
+	    if (dip->di_variable_flag) {
+		dsize = get_variable(dip);
+	    } else {
+		dsize += dip->di_incr_count;
+		if (dsize > dip->di_max_size) dsize = dip->di_min_size;
+	    }
+	}
+        error_count = 0;
+        IterateAllDevices(dtap, dtapp_error_count, &error_count, rc);
+    }
+    dtapp_fanout_stop(dip, fop);
+    return(result);
+}
+
+/*
+ * dtapp_init_write_buffer() - Initialize the Write Buffer Pattern and btags.
+ */
+lbdata_t
+dtapp_init_write_buffer(dinfo_t *dip, dinfo_t *odip, size_t bsize, lbdata_t lba)
+{
+    if (dip->di_iot_pattern) {
+	lba = init_iotdata(odip, odip->di_data_buffer, bsize, lba, odip->di_lbdata_size);
+    } else {
+	fill_buffer(odip, odip->di_data_buffer, bsize, odip->di_pattern);
+    }
+    /*
+     * Initialize the logical block data (if enabled).
+     */
+    if ( dip->di_lbdata_flag && dip->di_lbdata_size && (dip->di_iot_pattern == False) ) {
+	lba = init_lbdata(odip, odip->di_data_buffer, bsize, lba, odip->di_lbdata_size);
+    }
+#if defined(TIMESTAMP)
+    /*
+     * If timestamps are enabled, initialize buffer accordingly.
+     */
+    if (dip->di_timestamp_flag) {
+	init_timestamp(odip, odip->di_data_buffer, bsize, odip->di_lbdata_size);
+    }
+#endif /* defined(TIMESTAMP) */
+    if (odip->di_btag) {
+	update_buffer_btags(odip, odip->di_btag, odip->di_offset,
+			    odip->di_data_buffer, bsize, (odip->di_records_written + 1));
+    }
+    return(lba);
+}
+
 int
 dtapp_read_data(dinfo_t *dip)
 {
@@ -1810,6 +2433,9 @@ dtapp_read_data(dinfo_t *dip)
     unsigned long error_count = 0;
     int status = SUCCESS;
 
+    if (dtap->dta_fanout_flag == True) {
+        return( dtapp_read_data_fanout(dip) );
+    }
     if (dip->di_ftype == INPUT_FILE) {
         dips = dtap->dta_input_dips;
         device_count = dtap->dta_input_count;
@@ -2084,6 +2710,9 @@ dtapp_write_data(dinfo_t *dip)
     unsigned long error_count = 0;
     int rc, status = SUCCESS;
 
+    if (dtap->dta_fanout_flag == True) {
+        return( dtapp_write_data_fanout(dip) );
+    }
     dsize = get_data_size(dip, WRITE_OP);
     data_limit = dtapp_get_data_limit(dip, dtap);
 
@@ -2203,29 +2832,7 @@ dtapp_write_data(dinfo_t *dip)
 	 */
 	if ( (dip->di_compare_flag == True) &&
 	     ( (dip->di_io_mode == MIRROR_MODE) || (dip->di_io_mode == TEST_MODE) ) ) {
-	    if (dip->di_iot_pattern) {
-		lba = init_iotdata(odip, odip->di_data_buffer, bsize, lba, odip->di_lbdata_size);
-	    } else {
-		fill_buffer(odip, odip->di_data_buffer, bsize, odip->di_pattern);
-	    }
-	    /*
-	     * Initialize the logical block data (if enabled).
-	     */
-	    if ( dip->di_lbdata_flag && dip->di_lbdata_size && (dip->di_iot_pattern == False) ) {
-		lba = init_lbdata(odip, odip->di_data_buffer, bsize, lba, odip->di_lbdata_size);
-	    }
-#if defined(TIMESTAMP)
-	    /*
-	     * If timestamps are enabled, initialize buffer accordingly.
-	     */
-	    if (dip->di_timestamp_flag) {
-		init_timestamp(odip, odip->di_data_buffer, bsize, odip->di_lbdata_size);
-	    }
-#endif /* defined(TIMESTAMP) */
-	    if (odip->di_btag) {
-		update_buffer_btags(odip, odip->di_btag, odip->di_offset,
-				    odip->di_data_buffer, bsize, (odip->di_records_written + 1));
-	    }
+	    lba = dtapp_init_write_buffer(dip, odip, bsize, lba);
 	}
 
 	if (dip->di_Debug_flag) {
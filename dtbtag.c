@@ -31,6 +31,16 @@
  *
  * Modification History:
  * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Batch the btag updates in update_buffer_btags(), so the invariant
+ * fields (flags, write timestamp, pattern, generation) are setup once per
+ * record, rather than calling gettimeofday() for each lbdata block.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add a faster CRC-32 engine, using carry-less multiply (PCLMULQDQ)
+ * folding when the CPU supports it, otherwise slice-by-8 tables. The CRC
+ * values are identical to the original byte-wise zlib algorithm.
+ * 
  * November 4th, 2021 by Robin T. Miller
  *      Switch to using device ID page instead of serial numbers.
  *      Note: For NVMe disks, use the global unique identifier instead
@@ -943,16 +953,53 @@ update_buffer_btags(dinfo_t *dip, btag_t *btag, Offset_t offset,
     register uint32_t dsize = dip->di_lbdata_size;
     register uint32_t record_index;
     size_t btag_size = getBtagSize(btag);
+    hbool_t disk_flag = isDiskDevice(dip);
+
+    /*
+     * The btag extension (if any) may vary per block, so update each btag.
+     */
+    if (dip->di_funcs->tf_update_btag) {
+	for (record_index = 0; record_index < record_size; record_index += dsize) {
+	    uint32_t crc = 0;
+	    update_btag(dip, btag, (offset + record_index),
+			record_index, record_size, record_number);
+	    /* Copy the btag template. */
+	    memcpy(bp, btag, btag_size);
+	    /* Calculate the CRC (btag + data). */
+	    crc = crc32(crc, bp, dip->di_lbdata_size);
+	    ((btag_t *)bp)->btag_crc32 = HtoL32(crc);
+	    bp += dsize;
+	}
+	/* Return the 1st btag! */
+	memcpy(btag, buffer, btag_size);
+	return;
+    }
+    /*
+     * Setup the fields invariant for this record once, including the write
+     * timestamp, so all blocks in a record have the same write time. Then
+     * only the block offset/lba, record index/size, and CRC are updated.
+     */
+    update_btag(dip, btag, offset, 0, record_size, record_number);
 
     for (record_index = 0; record_index < record_size; record_index += dsize) {
+	btag_t *bbtag = (btag_t *)bp;
 	uint32_t crc = 0;
-	update_btag(dip, btag, (offset + record_index),
-		    record_index, record_size, record_number);
 	/* Copy the btag template. */
 	memcpy(bp, btag, btag_size);
+	if (record_index) {
+	    Offset_t boffset = (offset + record_index);
+	    if (disk_flag == True) {
+		uint64_t lba = makeLBA(dip, boffset);
+		bbtag->btag_lba = HtoL64(lba);
+	    } else {
+		bbtag->btag_offset = HtoL64(boffset);
+	    }
+	    bbtag->btag_record_index = HtoL32(record_index);
+	    bbtag->btag_record_size = HtoL32((uint32_t)record_size - record_index);
+	}
 	/* Calculate the CRC (btag + data). */
-	crc = crc32(crc, bp, dip->di_lbdata_size);
-	((btag_t *)bp)->btag_crc32 = HtoL32(crc);
+	crc = crc32(crc, bp, dsize);
+	bbtag->btag_crc32 = HtoL32(crc);
 	bp += dsize;
     }
     /* Return the 1st btag! */
@@ -1954,6 +2001,83 @@ const uLongf * ZEXPORT get_crc_table()
 #define Do4(buf)  Do2(buf); Do2(buf);
 #define Do8(buf)  Do4(buf); Do4(buf);
 
+/*
+ * Slice-by-8 tables, crc_slice[0] is the byte-wise crc_table, and each
+ * subsequent table advances the CRC by another zero byte. This processes
+ * 8 bytes per iteration with independent table lookups.
+ */
+local uint32_t crc_slice[8][256];
+local hbool_t crc_slice_initialized = False;
+
+/*
+ * crc32_initialize() - Initialize the CRC-32 Engine.
+ *
+ * Description:
+ *	Called once at startup (after simd_initialize), prior to threads.
+ */
+void
+crc32_initialize(void)
+{
+    int n, k;
+
+    if (crc_slice_initialized == True) return;
+#ifdef DYNAMIC_CRC_TABLE
+    if (crc_table_empty)
+      make_crc_table();
+#endif
+    for (n = 0; n < 256; n++) {
+	crc_slice[0][n] = crc_table[n];
+    }
+    for (n = 0; n < 256; n++) {
+	uint32_t c = crc_slice[0][n];
+	for (k = 1; k < 8; k++) {
+	    c = crc_slice[0][c & 0xff] ^ (c >> 8);
+	    crc_slice[k][n] = c;
+	}
+    }
+    crc_slice_initialized = True;
+    return;
+}
+
+/*
+ * crc32_slice8() - Slice-by-8 CRC-32 (internal, pre-inverted crc).
+ *
+ * Note: The words are assembled a byte at a time, so this is endian
+ * neutral, and compilers merge these into single loads where possible.
+ */
+local uint32_t
+crc32_slice8(uint32_t crc, uint8_t *bp, size_t len)
+{
+    while (len >= 8) {
+	uint32_t one = crc ^ ( (uint32_t)bp[0] | ((uint32_t)bp[1] << 8) |
+			       ((uint32_t)bp[2] << 16) | ((uint32_t)bp[3] << 24) );
+	uint32_t two = ( (uint32_t)bp[4] | ((uint32_t)bp[5] << 8) |
+			 ((uint32_t)bp[6] << 16) | ((uint32_t)bp[7] << 24) );
+	crc = crc_slice[7][one & 0xff] ^
+	      crc_slice[6][(one >> 8) & 0xff] ^
+	      crc_slice[5][(one >> 16) & 0xff] ^
+	      crc_slice[4][one >> 24] ^
+	      crc_slice[3][two & 0xff] ^
+	      crc_slice[2][(two >> 8) & 0xff] ^
+	      crc_slice[1][(two >> 16) & 0xff] ^
+	      crc_slice[0][two >> 24];
+	bp += 8;
+	len -= 8;
+    }
+    while (len--) {
+	Do1(bp);
+    }
+    return(crc);
+}
+
+/*
+ * crc32() - Calculate the CRC-32 (zlib compatible).
+ *
+ * Description:
+ *	The results are identical to the original byte-wise zlib loop, which
+ * is required so existing btag data verifies. With PCLMULQDQ, the data is
+ * folded 64 bytes at a time (see simd_crc32_fold), otherwise slice-by-8.
+ */
 uint32_t
 crc32(uint32_t crc, void *buffer, unsigned int length)
 {
@@ -1961,17 +2085,29 @@ crc32(uint32_t crc, void *buffer, unsigned int length)
     register unsigned int len = length;
 
     if (bp == NULL) return(0);
+    crc = (crc ^ 0xffffffffU);
+    if (crc_slice_initialized == False) {
 #ifdef DYNAMIC_CRC_TABLE
-    if (crc_table_empty)
-      make_crc_table();
+	if (crc_table_empty)
+	  make_crc_table();
 #endif
-    crc = (crc ^ 0xffffffffU);
-    while (len >= 8) {
-      Do8(bp);
-      len -= 8;
-    }
-    if (len) do {
-	Do1(bp);
-    } while (--len);
+	while (len >= 8) {
+	  Do8(bp);
+	  len -= 8;
+	}
+	if (len) do {
+	    Do1(bp);
+	} while (--len);
+	return( crc ^ 0xffffffffU );
+    }
+#if defined(SIMD_X86)
+    if ( (simd_crc32_flag == True) && (len >= SIMD_CRC_MINIMUM) ) {
+	unsigned int fold_len = (len & ~(unsigned int)0xF);
+	crc = simd_crc32_fold(crc, bp, fold_len);
+	bp += fold_len;
+	len -= fold_len;
+    }
+#endif /* defined(SIMD_X86) */
+    crc = crc32_slice8(crc, bp, len);
     return( crc ^ 0xffffffffU );
 }
@@ -0,0 +1,370 @@
+/****************************************************************************
+ *      								    *
+ *      		  COPYRIGHT (c) 1988 - 2026     		    *
+ *      		   This Software Provided       		    *
+ *      			     By 				    *
+ *      		  Robin's Nest Software Inc.    		    *
+ *      								    *
+ * Permission to use, copy, modify, distribute and sell this software and   *
+ * its documentation for any purpose and without fee is hereby granted,     *
+ * provided that the above copyright notice appear in all copies and that   *
+ * both that copyright notice and this permission notice appear in the      *
+ * supporting documentation, and that the name of the author not be used    *
+ * in advertising or publicity pertaining to distribution of the software   *
+ * without specific, written prior permission.  			    *
+ *      								    *
+ * THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,        *
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN      *
+ * NO EVENT SHALL HE BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL   *
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR    *
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS  *
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF   *
+ * THIS SOFTWARE.       						    *
+ *      								    *
+ ****************************************************************************/
+/*
+ * Module:      dtdist.c
+ * Author:      Robin T. Miller
+ * Date:	October 15th, 2026
+ *
+ * Description:
+ *      Random access distributions, for skewed random I/O.
+ *
+ *	Uniform random offsets touch every block equally, which defeats
+ * array caches and tiering in ways real applications never do. These
+ * distributions return a block (or alignment unit) index, where the hot
+ * blocks are at the start of the range (the center for normal), so a
+ * tiering array sees a contiguous hot region, like real data sets.
+ *
+ *	zipf[:theta]		Zipf, using rejection-inversion sampling.
+ *	pareto[:h]		Pareto, where a fraction h gets (1-h) of I/O.
+ *	hotcold[:hot[:io]]	The hot % of blocks receive io % of the I/O.
+ *	normal[:stddev]		Normal, stddev is a % of the range.
+ *
+ *	All samplers are O(1) per I/O. The per range constants are computed
+ * once, and only recomputed when the range changes (variable block sizes).
+ *
+ * Modification History:
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Initial creation, with zipf, pareto, hotcold, and normal.
+ */
+#include "dt.h"
+
+#if !defined(M_PI)
+#  define M_PI	3.14159265358979323846
+#endif
+
+#define RDIST_DEFAULT_ZIPF_THETA	0.99
+#define RDIST_DEFAULT_PARETO_H		0.2
+#define RDIST_DEFAULT_HOT_PERCENT	20.0
+#define RDIST_DEFAULT_HOT_IO		80.0
+#define RDIST_DEFAULT_NORMAL_STDDEV	10.0
+#define RDIST_NORMAL_RETRIES		100
+
+static char *rdist_names[] = { "uniform", "zipf", "pareto", "hotcold", "normal" };
+
+/*
+ * Zipf helpers: (see Hormann & Derflinger, "Rejection-inversion to generate
+ * variates from monotone discrete distributions")
+ */
+static double
+zipf_helper1(double x)		/* log(1+x)/x */
+{
+    return( (fabs(x) > 1e-8) ? (log1p(x) / x) : (1.0 - x * (0.5 - x * (1.0/3.0 - 0.25 * x))) );
+}
+
+static double
+zipf_helper2(double x)		/* (exp(x)-1)/x */
+{
+    return( (fabs(x) > 1e-8) ? (expm1(x) / x) : (1.0 + x * 0.5 * (1.0 + x * (1.0/3.0) * (1.0 + 0.25 * x))) );
+}
+
+static double
+zipf_h(random_dist_t *rdp, double x)
+{
+    return( exp(-rdp->rd_param * log(x)) );
+}
+
+static double
+zipf_H(random_dist_t *rdp, double x)
+{
+    double log_x = log(x);
+    return( zipf_helper2((1.0 - rdp->rd_param) * log_x) * log_x );
+}
+
+static double
+zipf_Hinv(random_dist_t *rdp, double x)
+{
+    double t = x * (1.0 - rdp->rd_param);
+    if (t < -1.0) t = -1.0;
+    return( exp(zipf_helper1(t) * x) );
+}
+
+/*
+ * setup_random_distribution() - Compute the Constants for a Range.
+ */
+static void
+setup_random_distribution(random_dist_t *rdp, uint64_t items)
+{
+    double hot_percent = (rdp->rd_type == RDIST_HOTCOLD) ? rdp->rd_param : RDIST_DEFAULT_HOT_PERCENT;
+
+    rdp->rd_items = items;
+    rdp->rd_hot_items = (uint64_t)(((double)items * hot_percent) / 100.0);
+    if (rdp->rd_hot_items == 0) rdp->rd_hot_items = 1;
+    if (rdp->rd_type == RDIST_NORMAL) {
+	/* The hot set is centered on the peak. */
+	rdp->rd_hot_begin = ((items - rdp->rd_hot_items) / 2);
+    } else {
+	rdp->rd_hot_begin = 0;
+    }
+    switch (rdp->rd_type) {
+	case RDIST_ZIPF:
+	    rdp->rd_hx1 = (zipf_H(rdp, 1.5) - 1.0);
+	    rdp->rd_hxn = zipf_H(rdp, (double)items + 0.5);
+	    rdp->rd_s = (2.0 - zipf_Hinv(rdp, zipf_H(rdp, 2.5) - zipf_h(rdp, 2.0)));
+	    break;
+	case RDIST_PARETO:
+	    rdp->rd_s = (log(rdp->rd_param) / log(1.0 - rdp->rd_param));
+	    break;
+	case RDIST_NORMAL:
+	    rdp->rd_s = (((double)items * rdp->rd_param) / 100.0);
+	    break;
+	default:
+	    break;
+    }
+    return;
+}
+
+/*
+ * random_distribution_index() - Return a Random Index from the Distribution.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	items = The number of items (blocks) in the range.
+ *
+ * Return Value:
+ *	An index in the range 0 to (items - 1).
+ */
+uint64_t
+random_distribution_index(dinfo_t *dip, uint64_t items)
+{
+    random_dist_t *rdp = &dip->di_rdist;
+    uint64_t index;
+
+    if (items <= 1) return(0);
+    if (items != rdp->rd_items) {
+	setup_random_distribution(rdp, items);
+    }
+    switch (rdp->rd_type) {
+
+	case RDIST_ZIPF: {
+	    double u, x;
+	    uint64_t k;
+	    for (;;) {
+		u = rdp->rd_hxn + genrand64_real2(dip) * (rdp->rd_hx1 - rdp->rd_hxn);
+		x = zipf_Hinv(rdp, u);
+		k = (uint64_t)(x + 0.5);
+		if (k < 1) {
+		    k = 1;
+		} else if (k > items) {
+		    k = items;
+		}
+		if ( ((k - x) <= rdp->rd_s) ||
+		     (u >= (zipf_H(rdp, (double)k + 0.5) - zipf_h(rdp, (double)k))) ) {
+		    break;
+		}
+	    }
+	    index = (k - 1);
+	    break;
+	}
+	case RDIST_PARETO:
+	    index = (uint64_t)((double)items * pow(genrand64_real2(dip), rdp->rd_s));
+	    break;
+
+	case RDIST_HOTCOLD:
+	    if ( (rdp->rd_hot_items >= items) ||
+		 ((genrand64_real2(dip) * 100.0) < rdp->rd_hot_io) ) {
+		index = (get_random64(dip) % rdp->rd_hot_items);
+	    } else {
+		index = rdp->rd_hot_items + (get_random64(dip) % (items - rdp->rd_hot_items));
+	    }
+	    break;
+
+	case RDIST_NORMAL: {
+	    double z, x;
+	    int retries = RDIST_NORMAL_RETRIES;
+	    do {
+		/* Box-Muller transform. */
+		z = sqrt(-2.0 * log(genrand64_real3(dip))) * cos(2.0 * M_PI * genrand64_real2(dip));
+		x = ((double)items / 2.0) + (z * rdp->rd_s);
+	    } while ( ((x < 0.0) || (x >= (double)items)) && --retries );
+	    index = (retries) ? (uint64_t)x : (get_random64(dip) % items);
+	    break;
+	}
+	default:
+	    index = (get_random64(dip) % items);
+	    break;
+    }
+    if (index >= items) index = (items - 1);	/* Paranoia (rounding). */
+
+    rdp->rd_samples++;
+    if ( (index >= rdp->rd_hot_begin) && (index < (rdp->rd_hot_begin + rdp->rd_hot_items)) ) {
+	rdp->rd_hot_hits++;
+    }
+    return(index);
+}
+
+/*
+ * parse_random_distribution() - Parse the Random Distribution Option.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	string = The distribution string, e.g. "zipf:1.2".
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (invalid distribution or parameter).
+ */
+int
+parse_random_distribution(dinfo_t *dip, char *string)
+{
+    random_dist_t *rdp = &dip->di_rdist;
+    random_dist_t rdist;
+    char *str = string, *end;
+
+    memset(&rdist, '\0', sizeof(rdist));
+    if (match(&str, "uniform")) {
+	rdist.rd_type = RDIST_UNIFORM;
+    } else if (match(&str, "zipf")) {
+	rdist.rd_type = RDIST_ZIPF;
+	rdist.rd_param = RDIST_DEFAULT_ZIPF_THETA;
+    } else if (match(&str, "pareto")) {
+	rdist.rd_type = RDIST_PARETO;
+	rdist.rd_param = RDIST_DEFAULT_PARETO_H;
+    } else if (match(&str, "hotcold")) {
+	rdist.rd_type = RDIST_HOTCOLD;
+	rdist.rd_param = RDIST_DEFAULT_HOT_PERCENT;
+	rdist.rd_hot_io = RDIST_DEFAULT_HOT_IO;
+    } else if (match(&str, "normal")) {
+	rdist.rd_type = RDIST_NORMAL;
+	rdist.rd_param = RDIST_DEFAULT_NORMAL_STDDEV;
+    } else {
+	Eprintf(dip, "Valid random distributions are: uniform, zipf[:theta], pareto[:h], hotcold[:hot%%[:io%%]], or normal[:stddev%%]\n");
+	return(FAILURE);
+    }
+    if ( (*str == ':') && (rdist.rd_type != RDIST_UNIFORM) ) {
+	rdist.rd_param = strtod(++str, &end);
+	if (end == str) {
+	    Eprintf(dip, "Invalid random distribution parameter: %s\n", str);
+	    return(FAILURE);
+	}
+	str = end;
+	if ( (*str == ':') && (rdist.rd_type == RDIST_HOTCOLD) ) {
+	    rdist.rd_hot_io = strtod(++str, &end);
+	    if (end == str) {
+		Eprintf(dip, "Invalid hotcold I/O percentage: %s\n", str);
+		return(FAILURE);
+	    }
+	    str = end;
+	}
+    }
+    if (*str != '\0') {
+	Eprintf(dip, "Unexpected text in random distribution: %s\n", str);
+	return(FAILURE);
+    }
+    switch (rdist.rd_type) {
+	case RDIST_ZIPF:
+	    if (rdist.rd_param <= 0.0) {
+		Eprintf(dip, "The zipf theta must be greater than zero!\n");
+		return(FAILURE);
+	    }
+	    break;
+	case RDIST_PARETO:
+	    if ( (rdist.rd_param <= 0.0) || (rdist.rd_param >= 1.0) ) {
+		Eprintf(dip, "The pareto h must be between 0 and 1 (exclusive)!\n");
+		return(FAILURE);
+	    }
+	    break;
+	case RDIST_HOTCOLD:
+	    if ( (rdist.rd_param <= 0.0) || (rdist.rd_param >= 100.0) ||
+		 (rdist.rd_hot_io < 0.0) || (rdist.rd_hot_io > 100.0) ) {
+		Eprintf(dip, "The hotcold percentages must be 0 < hot < 100 and 0 <= io <= 100!\n");
+		return(FAILURE);
+	    }
+	    break;
+	case RDIST_NORMAL:
+	    if (rdist.rd_param <= 0.0) {
+		Eprintf(dip, "The normal stddev percentage must be greater than zero!\n");
+		return(FAILURE);
+	    }
+	    break;
+	default:
+	    break;
+    }
+    *rdp = rdist;
+    return(SUCCESS);
+}
+
+/*
+ * format_random_distribution() - Format the Distribution and Parameters.
+ */
+char *
+format_random_distribution(dinfo_t *dip, char *buffer)
+{
+    random_dist_t *rdp = &dip->di_rdist;
+
+    switch (rdp->rd_type) {
+	case RDIST_HOTCOLD:
+	    (void)sprintf(buffer, "%s:%g:%g", rdist_names[rdp->rd_type], rdp->rd_param, rdp->rd_hot_io);
+	    break;
+	case RDIST_UNIFORM:
+	    (void)strcpy(buffer, rdist_names[rdp->rd_type]);
+	    break;
+	default:
+	    (void)sprintf(buffer, "%s:%g", rdist_names[rdp->rd_type], rdp->rd_param);
+	    break;
+    }
+    return(buffer);
+}
+
+/*
+ * random_distribution_hot_io() - Return the Percentage of I/O to Hot Set.
+ */
+double
+random_distribution_hot_io(random_dist_t *rdp)
+{
+    if (rdp->rd_samples == 0) return(0.0);
+    return( ((double)rdp->rd_hot_hits * 100.0) / (double)rdp->rd_samples );
+}
+
+/*
+ * report_random_distribution() - Report the Achieved Hot Set Coverage.
+ */
+void
+report_random_distribution(dinfo_t *dip, random_dist_t *rdp)
+{
+    char buffer[STRING_BUFFER_SIZE];
+    double hot_percent;
+
+    if ( (rdp->rd_type == RDIST_UNIFORM) || (rdp->rd_samples == 0) ) {
+	return;
+    }
+    hot_percent = (rdp->rd_type == RDIST_HOTCOLD) ? rdp->rd_param : RDIST_DEFAULT_HOT_PERCENT;
+    Lprintf(dip, DT_FIELD_WIDTH "%s\n", "Random distribution",
+	    format_random_distribution(dip, buffer));
+    Lprintf(dip, DT_FIELD_WIDTH "%.2f%% of I/O's to the hottest %g%% of blocks (" LUF " of " LUF ")\n",
+	    "Hot set coverage", random_distribution_hot_io(rdp), hot_percent,
+	    rdp->rd_hot_hits, rdp->rd_samples);
+    return;
+}
+
+/*
+ * merge_random_distribution() - Merge Thread Coverage Statistics.
+ */
+void
+merge_random_distribution(random_dist_t *drdp, random_dist_t *srdp)
+{
+    drdp->rd_samples += srdp->rd_samples;
+    drdp->rd_hot_hits += srdp->rd_hot_hits;
+    return;
+}
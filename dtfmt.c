@@ -32,6 +32,12 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Add KeepAliveFlags(), so %json keepalives omit the message prefix.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add %json (pass) and %JSON (total) keepalive statistics records.
+ * 
  * October 30th, 2025 by Robin T. Miller
  *      Add latency keepalive format control string parsing.
  * 
@@ -112,6 +118,8 @@ static char *not_available = "NA";
  *      %iops = The I/O's per second.
  *      %spio = The seconds per I/O.
  * 
+ *      %json = The statistics as a JSON object (without message prefix).
+ * 
  * Lowercase means per pass stats, while uppercase means total stats.
  *
  * I/O Keywords:
@@ -228,6 +236,12 @@ FmtKeepAlive(struct dinfo *dip, char *keepalivefmt, char *buffer)
 		length -= 4;
 		from += 5;
 		continue;
+	    } else if (strncasecmp(key, "json", 4) == 0) {
+		hbool_t pass_stats = (strncmp(key, "json", 4) == 0);
+		to += FmtJsonStats(dip, to, "keepalive", pass_stats, True);
+		length -= 4;
+		from += 5;
+		continue;
 	    } else if (strncasecmp(key, "spio", 4) == 0) {
 		int secs;
 		u_long records;
@@ -709,6 +723,33 @@ FmtKeepAlive(struct dinfo *dip, char *keepalivefmt, char *buffer)
     return( strlen(buffer) );
 }
 
+/*
+ * KeepAliveFlags() - Return the Keepalive Message Print Flags.
+ *
+ * Description:
+ *	Keepalives with JSON statistics (%json or %JSON) are printed without
+ * the message prefix, like the JSON statistics records, so each line is a
+ * valid JSON object for consumers parsing one line at a time.
+ *
+ * Inputs:
+ *	keepalivefmt = The keepalive format control string.
+ *
+ * Return Value:
+ *	Returns PRT_NOIDENT for JSON keepalives, otherwise 0.
+ */
+int
+KeepAliveFlags(char *keepalivefmt)
+{
+    char *p = keepalivefmt;
+
+    while ( p && (p = strchr(p, '%')) ) {
+	if (strncasecmp(++p, "json", 4) == 0) {
+	    return(PRT_NOIDENT);
+	}
+    }
+    return(0);
+}
+
 /*
  * GetStatsValue() - Simple function to obtain stats values.
  *
@@ -32,6 +32,9 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Free the file system map after truncating files.
+ * 
  * October 6th, 2025 by Robin T. Miller
  *      Remove Windows drive letter check in dt_create_directory(), which
  * keeps multiple directories from being created.
@@ -1578,6 +1581,7 @@ dt_truncate_file(struct dinfo *dip, char *file,	Offset_t offset,
 	ENABLE_NOPROG(dip, TRUNCATE_OP);
 	status = os_truncate_file(file, offset);
 	DISABLE_NOPROG(dip);
+	os_free_file_map(dip);		/* The file map is now stale. */
 	if (status == FAILURE) {
 	    os_error_t error = os_get_error();
 	    INIT_ERROR_INFO(eip, file, OS_TRUNCATE_FILE_OP, TRUNCATE_OP, NULL, 0, (Offset_t)offset,
@@ -1626,6 +1630,7 @@ dt_ftruncate_file(struct dinfo *dip, char *file, HANDLE fd, Offset_t offset,
 	ENABLE_NOPROG(dip, TRUNCATE_OP);
 	status = os_ftruncate_file(fd, offset);
 	DISABLE_NOPROG(dip);
+	os_free_file_map(dip);		/* The file map is now stale. */
 	if (status == FAILURE) {
 	    os_error_t error = os_get_error();
 	    INIT_ERROR_INFO(eip, file, OS_FTRUNCATE_FILE_OP, TRUNCATE_OP, NULL, 0, (Offset_t)0,
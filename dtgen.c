@@ -32,6 +32,10 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Always free the file system map on open, since a file deleted and
+ * recreated with the same size may reuse the inode (stale extents).
+ * 
  * October 9th, 2020 by Robin T. Miller
  *      Augment the disk threads to slices sanity check to handle single slice.
  * 
@@ -417,6 +421,7 @@ init_open_defaults(dinfo_t *dip)
 	}
     }
     /* Remember, during read retries we use this code path! */
+    /* Note: Freed each open, since the file may be replaced (same inode). */
     if ( (dip->di_retrying == False) && dip->di_fsmap) {
 	os_free_file_map(dip);
     }
@@ -29,6 +29,15 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Fix growing the file table, which lost all entries since Realloc()
+ * zeroes the buffer, and allocate the file hash table (not per thread info).
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Replace the linked file list with a dense file table and a hash on
+ * the base path, so random file selection and file/stream lookups are O(1)
+ * instead of walking every file (slow with large maxfiles values).
+ * 
  * February 4th, 2023 by Robin T. Miller, Chris Nelson, & John Hollowell
  *      Fix segmentation fault when overwriting a file encounters a file
  * system full condition, due to writefile() freeing the file structure.
@@ -226,10 +235,19 @@ typedef struct hammer_file {
     uint32_t	fileid;			/* The file ID (random number).	*/
     uint32_t	timestamp;		/* The file timestamp.		*/
     int64_t	size;			/* The size of the file.	*/
-    struct hammer_file *prev, *next;
+    int64_t	index;			/* Index in the file table.	*/
+    struct hammer_file *hash_next;	/* Next file in hash chain.	*/
     struct hammer_file *base;
 } hammer_file_t;
 
+/*
+ * Files are kept in a dense table (for random selection), and hashed by
+ * their base path, the part before any stream ':', so all streams of a
+ * file reside in the same hash chain.
+ */
+#define FILE_HASHTABLE_SIZE	65521
+#define FILE_TABLE_INCREMENT	1024
+
 /*
  * Inodes allocated to/freed from hammer. 
  * (Assume that nothing else is running on the target volume.)
@@ -303,11 +321,13 @@ typedef struct hammer_thread_info {
     uint64_t	file_number;
     int64_t	nfiles;
     int64_t	nfiles_when_full;
-    hammer_file_t *head;
+    hammer_file_t **files;		/* The dense file table.	*/
+    int64_t	files_allocated;	/* Entries allocated in table.	*/
     hammer_file_t *lastwrittenfile;
     datablock_t *datablock;
     uint32_t	datablocklen;
     hammer_inode_t *inode_hash_table[INODE_HASHTABLE_SIZE];
+    hammer_file_t **file_hash_table;	/* The file path hash table.	*/
     struct timeval start;
     char	logtime_buf[TIME_BUFFER_SIZE];
     char	*uncpath;
@@ -404,6 +424,9 @@ int freefiles(dinfo_t *dip);
 hammer_file_t *getrndfile(dinfo_t *dip);
 hammer_file_t *findfile(hammer_thread_info_t *tip, char *path);
 static hammer_file_t *findotherstream(dinfo_t *dip, hammer_thread_info_t *tip, hammer_file_t *f);
+static uint32_t file_hash(char *path);
+static void hash_insert_file(hammer_thread_info_t *tip, hammer_file_t *f);
+static void hash_remove_file(hammer_thread_info_t *tip, hammer_file_t *f);
 uint64_t newrndfilenum(hammer_thread_info_t *tip);
 hammer_file_t *newrndfile(dinfo_t *dip);
 int updatesize(dinfo_t *dip, hammer_file_t *f);
@@ -1130,6 +1153,14 @@ hammer_cleanup_information(dinfo_t *dip)
 	Free(dip, tip->uncpath);
 	tip->uncpath = NULL;
     }
+    if (tip->files) {
+	Free(dip, tip->files);
+	tip->files = NULL;
+    }
+    if (tip->file_hash_table) {
+	Free(dip, tip->file_hash_table);
+	tip->file_hash_table = NULL;
+    }
     Free(dip, hip);
     dip->di_opaque = NULL;
     return;
@@ -1148,6 +1179,9 @@ hammer_clone_information(dinfo_t *dip, dinfo_t *cdip, hbool_t new_context)
     *chip = *hip;           /* Copy the original information. */
     
     /* Do hammer thread specific cloning (if any) here... */
+    chip->hammer_thread_info.files = NULL;
+    chip->hammer_thread_info.files_allocated = 0;
+    chip->hammer_thread_info.file_hash_table = NULL;
 
     return(SUCCESS);
 }
@@ -1325,7 +1359,12 @@ hammer_thread_setup(dinfo_t *dip)
 
     tip->nfiles = 0;
     tip->nfiles_when_full = 0;
-    tip->head = NULL;
+    if (tip->file_hash_table == NULL) {
+	tip->file_hash_table = Malloc(dip, (FILE_HASHTABLE_SIZE * sizeof(*tip->file_hash_table)));
+	if (tip->file_hash_table == NULL) return(FAILURE);
+    } else {
+	memset(tip->file_hash_table, '\0', (FILE_HASHTABLE_SIZE * sizeof(*tip->file_hash_table)));
+    }
     tip->lastwrittenfile = NULL;
 
     /*
@@ -1961,8 +2000,8 @@ cleanup_files(dinfo_t *dip)
     }
     Printf(dip, "cleaning up...\n");
     dip->di_deleting_flag = True;
-    while (tip->head != NULL) {
-	hammer_file_t *f = tip->head;
+    while (tip->nfiles > 0) {
+	hammer_file_t *f = tip->files[tip->nfiles - 1];
 	if (f->fpath == NULL) {
 	    f->fpath = makefullpath(dip, f->path);
 	}
@@ -1999,6 +2038,25 @@ allocfile(dinfo_t *dip, char *path)
     hammer_parameters_t *hmrp = &hip->hammer_parameters;
     hammer_file_t *newfile;
 
+    if (tip->nfiles < 0) {
+	Eprintf(dip, "allocfile: BUG! negative nfiles="LXF"\n", tip->nfiles);
+	return(NULL);
+    }
+    if (tip->nfiles == tip->files_allocated) {
+	int64_t entries = tip->files_allocated + FILE_TABLE_INCREMENT;
+	hammer_file_t **files;
+	if (tip->files_allocated) entries = (tip->files_allocated * 2);
+	/* Note: Realloc() zeroes the whole buffer, so use realloc() directly! */
+	files = realloc(tip->files, (size_t)(entries * sizeof(*tip->files)));
+	if (files == NULL) {
+	    Perror(dip, "allocfile: realloc() failed growing the file table");
+	    return(NULL);
+	}
+	memset(&files[tip->files_allocated], '\0',
+	       (size_t)((entries - tip->files_allocated) * sizeof(*files)));
+	tip->files = files;
+	tip->files_allocated = entries;
+    }
     if ( ( newfile = Malloc(dip, sizeof(*newfile)) ) == NULL) {
 	Eprintf(dip, "allocfile: malloc failed, nbytes=0x%08X", (int)sizeof *newfile);
 	return(NULL);
@@ -2011,20 +2069,9 @@ allocfile(dinfo_t *dip, char *path)
     newfile->is_disk_full = False;
     update_dname(dip, newfile->fpath);
 
-    if (tip->head == NULL) {
-	tip->head = newfile;
-	newfile->prev = newfile->next = NULL;
-    } else {
-	tip->head->prev = newfile;
-	newfile->next = tip->head;
-	tip->head = newfile;
-	tip->head->prev = NULL;
-    }
-
-    if (tip->nfiles < 0) {
-	Eprintf(dip, "allocfile: BUG! negative nfiles="LXF"\n", tip->nfiles);
-    }
-    tip->nfiles++;
+    newfile->index = tip->nfiles;
+    tip->files[tip->nfiles++] = newfile;
+    hash_insert_file(tip, newfile);
 
     return newfile;
 }
@@ -2034,6 +2081,7 @@ freefile(dinfo_t *dip, hammer_file_t *file)
 {
     hammer_information_t *hip = dip->di_opaque;
     hammer_thread_info_t *tip = &hip->hammer_thread_info;
+    hammer_file_t *last;
 
     if (dip->di_max_data) {
 	dip->di_maxdata_written -= file->size;
@@ -2049,31 +2097,28 @@ freefile(dinfo_t *dip, hammer_file_t *file)
     if (tip->lastwrittenfile == file) {
 	tip->lastwrittenfile = NULL;
     }
-    if (file == tip->head) {
-	if ((tip->head = file->next) != NULL) {
-	    tip->head->prev = NULL;
-	}
-    } else {
-	if (file->next != NULL) {
-	    file->next->prev = file->prev;
-	}
-	file->prev->next = file->next;
-    }
     if (file->sig != FILESIG) {
-	tip->head = NULL;	/* don't recurse */
+	tip->nfiles = 0;	/* don't recurse */
 	Eprintf(dip, "freefile: %s: sig=0x%08X", file->path, file->sig);
 	return(FAILURE);
     }
+    if ( (tip->nfiles <= 0) || (file->index >= tip->nfiles) ||
+	 (tip->files[file->index] != file) ) {
+	Eprintf(dip, "freefile: nfiles="LL0XFMT", index="LL0XFMT, tip->nfiles, file->index);
+	tip->nfiles = 0;	/* don't recurse */
+	return(FAILURE);
+    }
+    hash_remove_file(tip, file);
+    /* Move the last file into this slot, keeping the table dense. */
+    last = tip->files[--tip->nfiles];
+    tip->files[file->index] = last;
+    last->index = file->index;
+    tip->files[tip->nfiles] = NULL;
+
     freestr(file->path);
     freestr(file->fpath);
     memset(file, 0xdd, sizeof(*file));
     free(file);
-    if (tip->nfiles <= 0) {
-	tip->head = NULL;	/* don't recurse */
-	Eprintf(dip, "freefile: nfiles="LL0XFMT, tip->nfiles);
-	return(FAILURE);
-    }
-    tip->nfiles--;
     return(SUCCESS);
 }
 
@@ -2084,8 +2129,8 @@ freefiles(dinfo_t *dip)
     hammer_thread_info_t *tip = &hip->hammer_thread_info;
     int status = SUCCESS;
 
-    while (tip->head != NULL) {
-	status = freefile(dip, tip->head);
+    while (tip->nfiles > 0) {
+	status = freefile(dip, tip->files[tip->nfiles - 1]);
 	if (status == FAILURE) break;
     }
     return(status);
@@ -2098,30 +2143,63 @@ getrndfile(dinfo_t *dip)
     hammer_information_t *hip = dip->di_opaque;
     hammer_thread_info_t *tip = &hip->hammer_thread_info;
     hammer_file_t *f;
-    uint64_t n;
 
     if (tip->nfiles == 0) return NULL;
 
-    n = rnd64(dip, 0, tip->nfiles - 1);
-    for (f = tip->head; f != NULL && n > 0; f = f->next) {
-	n--;
-    }
-    if (f != NULL) {
-	if (f->fpath == NULL) {
-	    f->fpath = makefullpath(dip, f->path);
-	}
-	update_dname(dip, f->fpath);
+    f = tip->files[rnd64(dip, 0, tip->nfiles - 1)];
+    if (f->fpath == NULL) {
+	f->fpath = makefullpath(dip, f->path);
     }
+    update_dname(dip, f->fpath);
 
     return f;
 }
 
+/*
+ * Hash the base path, stopping at a stream ':' (if any).
+ */
+static uint32_t
+file_hash(char *path)
+{
+    uint32_t hash = 2166136261U;	/* FNV-1a */
+
+    while ( (*path != '\0') && (*path != ':') ) {
+	hash ^= (unsigned char)*path++;
+	hash *= 16777619U;
+    }
+    return(hash % FILE_HASHTABLE_SIZE);
+}
+
+static void
+hash_insert_file(hammer_thread_info_t *tip, hammer_file_t *f)
+{
+    uint32_t hash = file_hash(f->path);
+
+    f->hash_next = tip->file_hash_table[hash];
+    tip->file_hash_table[hash] = f;
+    return;
+}
+
+static void
+hash_remove_file(hammer_thread_info_t *tip, hammer_file_t *f)
+{
+    hammer_file_t **fpp;
+
+    for (fpp = &tip->file_hash_table[file_hash(f->path)]; *fpp != NULL; fpp = &(*fpp)->hash_next) {
+	if (*fpp == f) {
+	    *fpp = f->hash_next;
+	    break;
+	}
+    }
+    return;
+}
+
 hammer_file_t *
 findfile(hammer_thread_info_t *tip, char *path)
 {
     hammer_file_t *f;
 
-    for (f = tip->head; f != NULL; f = f->next) {
+    for (f = tip->file_hash_table[file_hash(path)]; f != NULL; f = f->hash_next) {
 	if (STREQ(f->path, path)) {
 	    /* Note: We don't need the file path as used today! */
 	    return f;
@@ -2141,7 +2219,7 @@ findotherstream(dinfo_t *dip, hammer_thread_info_t *tip, hammer_file_t *f)
     }
     len = (int)strlen(f->path);
 
-    for (other = tip->head; other != NULL; other = other->next) {
+    for (other = tip->file_hash_table[file_hash(f->path)]; other != NULL; other = other->hash_next) {
 	if (other != f &&
 	    (STREQ(other->path, f->path) ||
 	     (other->colon != NULL && (other->colon - other->path) == len &&
@@ -3068,7 +3146,9 @@ renamefile(dinfo_t *dip, hammer_file_t *f)
     Print(dip, " %gsec", time_taken);
 
     if (status == SUCCESS) {
+	hash_remove_file(tip, f);	/* The base path changes. */
 	strcpy(f->path, newpath);
+	hash_insert_file(tip, f);
 	freemem(f->fpath);
 	f->fpath = fnewpath;
 	Printnl(dip);
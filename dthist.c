@@ -32,6 +32,14 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Validate history file headers in showhistory=, and never read entry
+ * data beyond the entry size, since these files are often left by crashes.
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Add history files (hfile=), which keep the history ring in a mapped
+ * file so it survives crashes, and showhistory= to decode them offline.
+ * 
  * May 5th, 2020 by Robin T. Miller
  *      Use high resolution timer for more accurate history timing. This is
  * implemented on Windows, but Unix systems still use gettimeofday() API.
@@ -41,9 +49,87 @@
  */
 #include "dt.h"
 
+#if !defined(WIN32)
+#  include <sys/mman.h>
+#endif /* !defined(WIN32) */
+
+/*
+ * History File Layout:
+ *
+ * The history file is a fixed header followed by a ring of fixed size
+ * entries, each followed by the request data bytes saved. Entries are
+ * claimed by atomically incrementing the header sequence, and committed
+ * by storing the entry sequence last, so a file left by a killed process
+ * (or host crash, after msync) decodes without any locking or recovery.
+ * All fields are fixed size, so the file can be decoded offline.
+ */
+#define HIST_FILE_MAGIC		0x46485444	/* "DTHF" */
+#define HIST_FILE_VERSION	1
+#define HIST_FILE_HEADER_SIZE	4096		/* Header size (one page).	*/
+#define HIST_FILE_DNAME_SIZE	1024		/* The device name size.	*/
+
+/* History File Flags: */
+#define HIST_FLAG_IOT		0x01		/* IOT data pattern.		*/
+#define HIST_FLAG_RANDOM	0x02		/* Random access device.	*/
+#define HIST_FLAG_LBDATA	0x04		/* Logical block data.		*/
+#define HIST_FLAG_FILES		0x08		/* Multiple files.		*/
+#define HIST_FLAG_TIMING	0x10		/* History timing enabled.	*/
+
+typedef struct hist_file_header {
+    uint32_t	hfh_magic;		/* The history file magic.	*/
+    uint32_t	hfh_version;		/* The history file version.	*/
+    uint32_t	hfh_header_size;	/* The header size (in bytes).	*/
+    uint32_t	hfh_entry_size;		/* Entry size, including data.	*/
+    uint32_t	hfh_entries;		/* The number of ring entries.	*/
+    uint32_t	hfh_data_size;		/* The data bytes per buffer.	*/
+    uint32_t	hfh_data_bufs;		/* The data buffers per entry.	*/
+    uint32_t	hfh_bsize;		/* The data buffer block size.	*/
+    uint32_t	hfh_dsize;		/* The device block size.	*/
+    uint32_t	hfh_lbdata_size;	/* The logical block data size.	*/
+    uint32_t	hfh_flags;		/* The history file flags.	*/
+    uint32_t	hfh_job_id;		/* The job ID.			*/
+    uint32_t	hfh_thread_number;	/* The thread number.		*/
+    uint32_t	hfh_pid;		/* The process ID.		*/
+    uint64_t	hfh_start_time;		/* The start time (seconds).	*/
+    volatile uint64_t hfh_sequence;	/* Next entry sequence number.	*/
+    char	hfh_dname[HIST_FILE_DNAME_SIZE]; /* The device name.	*/
+} hist_file_header_t;
+
+typedef struct hist_file_entry {
+    volatile uint64_t hfe_sequence;	/* Sequence + 1 (0 = not valid).*/
+    uint64_t	hfe_offset;		/* The file offset.		*/
+    uint64_t	hfe_record_number;	/* The record number.		*/
+    uint64_t	hfe_request_size;	/* Size of the request.		*/
+    int64_t	hfe_transfer_size;	/* Size of the transfer.	*/
+    uint32_t	hfe_file_number;	/* The file number.		*/
+    uint32_t	hfe_test_mode;		/* The I/O mode.		*/
+    uint32_t	hfe_secs;		/* The timer seconds.		*/
+    uint32_t	hfe_usecs;		/* The timer microseconds.	*/
+    /* Followed by the request data (data_bufs * data_size bytes). */
+} hist_file_entry_t;
+
+#define HIST_FILE_ENTRY(hfh, slot) \
+	(hist_file_entry_t *)((uint8_t *)(hfh) + (hfh)->hfh_header_size + \
+			      ((size_t)(slot) * (hfh)->hfh_entry_size))
+
+static void dump_history_map(dinfo_t *dip, hist_file_header_t *hfh);
+
 void
 FreeHistoryData(dinfo_t *dip)
 {
+#if !defined(WIN32)
+    if (dip->di_history_map) {
+	/* Write the history now, rather than relying on the page cache. */
+	(void)msync(dip->di_history_map, dip->di_history_map_size, MS_SYNC);
+	(void)munmap(dip->di_history_map, dip->di_history_map_size);
+	dip->di_history_map = NULL;
+	dip->di_history_map_size = 0;
+    }
+#endif /* !defined(WIN32) */
+    if (dip->di_history_file) {
+	FreeStr(dip, dip->di_history_file);
+	dip->di_history_file = NULL;
+    }
     if (dip->di_history_size && dip->di_history) {
 	history_t *hp;
 	int buf, entries = 0;
@@ -70,8 +156,9 @@ SetupHistoryData(dinfo_t *dip)
 {
     /*
      * Allocate history buffers (if requested).
+     * Note: History files are mapped when the first entry is saved.
      */
-    if (dip->di_history_size) {
+    if (dip->di_history_size && (dip->di_history_file == NULL)) {
 	history_t *hp;
 	int buf, entries = 0;
 	dip->di_history = Malloc(dip, (dip->di_history_size * sizeof(history_t)) );
@@ -113,6 +200,21 @@ dump_history_data(struct dinfo *dip)
     uint32_t bsize;
     int lock_status;
 
+    if (dip->di_history_file) {
+	if (dip->di_history_map) {
+	    dip->di_history_dumping = True;
+	    lock_status = AcquirePrintLock(dip);
+	    dump_history_map(dip, dip->di_history_map);
+	    if (lock_status == SUCCESS) {
+		lock_status = ReleasePrintLock(dip);
+	    }
+	    dip->di_history_dumped = True;
+	    dip->di_history_dumping = False;
+	} else {
+	    Printf(dip, "No history entries to report!\n");
+	}
+	return;
+    }
     if (entries == 0) {
 	Printf(dip, "No history entries to report!\n");
 	return;
@@ -262,6 +364,378 @@ dump_history_data(struct dinfo *dip)
     return;
 }
 
+/*
+ * open_history_file() - Create and map this threads' history file.
+ *
+ * Description:
+ *	With multiple threads or devices, the default postfix is added to
+ * the file name (like log files), unless the user specified their own.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE
+ */
+static int
+open_history_file(dinfo_t *dip)
+{
+#if defined(WIN32)
+    Eprintf(dip, "History files are not supported on Windows, history is disabled!\n");
+    return(FAILURE);
+#else /* !defined(WIN32) */
+    hist_file_header_t *hfh;
+    char path[PATH_BUFFER_SIZE];
+    char *hfile;
+    uint32_t bsize, entry_size;
+    size_t map_size;
+    int fd;
+
+    (void)strcpy(path, dip->di_history_file);
+    if ( ((dip->di_threads > 1) || dip->di_multiple_devs) && (strchr(path, '%') == NULL) ) {
+	(void)strcat(path, dip->di_file_sep);
+	(void)strcat(path, dip->di_file_postfix);
+    }
+    hfile = FmtLogFile(dip, path, True);
+    if (hfile == NULL) return(FAILURE);
+
+    if (dip->di_history_bsize) {
+	bsize = dip->di_history_bsize;
+    } else {
+	bsize = (dip->di_random_access) ? dip->di_dsize : dip->di_lbdata_size;
+    }
+    entry_size = (uint32_t)roundup( (sizeof(hist_file_entry_t) +
+				     (dip->di_history_bufs * dip->di_history_data_size)),
+				    sizeof(uint64_t) );
+    map_size = HIST_FILE_HEADER_SIZE + ((size_t)dip->di_history_size * entry_size);
+
+    fd = open(hfile, (O_RDWR | O_CREAT | O_TRUNC), 0644);
+    if (fd < 0) {
+	Perror(dip, "open() of history file %s failed", hfile);
+	FreeStr(dip, hfile);
+	return(FAILURE);
+    }
+    /* Note: The file is sparse until entries are saved. */
+    if (ftruncate(fd, (off_t)map_size) < 0) {
+	Perror(dip, "ftruncate() of history file %s failed", hfile);
+	(void)close(fd);
+	FreeStr(dip, hfile);
+	return(FAILURE);
+    }
+    hfh = mmap(NULL, map_size, (PROT_READ | PROT_WRITE), MAP_SHARED, fd, (off_t)0);
+    (void)close(fd);
+    if (hfh == MAP_FAILED) {
+	Perror(dip, "mmap() of history file %s failed", hfile);
+	FreeStr(dip, hfile);
+	return(FAILURE);
+    }
+    if (dip->di_debug_flag) {
+	Printf(dip, "Mapped history file %s, %d entries of %u bytes...\n",
+	       hfile, dip->di_history_size, entry_size);
+    }
+    FreeStr(dip, hfile);
+
+    hfh->hfh_version = HIST_FILE_VERSION;
+    hfh->hfh_header_size = HIST_FILE_HEADER_SIZE;
+    hfh->hfh_entry_size = entry_size;
+    hfh->hfh_entries = dip->di_history_size;
+    hfh->hfh_data_size = dip->di_history_data_size;
+    hfh->hfh_data_bufs = dip->di_history_bufs;
+    hfh->hfh_bsize = bsize;
+    hfh->hfh_dsize = dip->di_dsize;
+    hfh->hfh_lbdata_size = dip->di_lbdata_size;
+    if (dip->di_iot_pattern) hfh->hfh_flags |= HIST_FLAG_IOT;
+    if (dip->di_random_access) hfh->hfh_flags |= HIST_FLAG_RANDOM;
+    if (dip->di_lbdata_flag) hfh->hfh_flags |= HIST_FLAG_LBDATA;
+    if (dip->di_multiple_files || (dip->di_dtype && (dip->di_dtype->dt_dtype == DT_TAPE))) {
+	hfh->hfh_flags |= HIST_FLAG_FILES;
+    }
+    if (dip->di_history_timing) hfh->hfh_flags |= HIST_FLAG_TIMING;
+    hfh->hfh_job_id = (dip->di_job) ? dip->di_job->ji_job_id : 0;
+    hfh->hfh_thread_number = dip->di_thread_number;
+    hfh->hfh_pid = (uint32_t)getpid();
+    hfh->hfh_start_time = (uint64_t)time((time_t *)0);
+    hfh->hfh_sequence = 0;
+    (void)strncpy(hfh->hfh_dname, dip->di_dname, (HIST_FILE_DNAME_SIZE - 1));
+    /* Set the magic last, so the decoder knows the header is complete. */
+    hfh->hfh_magic = HIST_FILE_MAGIC;
+    (void)msync(hfh, HIST_FILE_HEADER_SIZE, MS_ASYNC);
+
+    dip->di_history_map = hfh;
+    dip->di_history_map_size = map_size;
+    return(SUCCESS);
+#endif /* defined(WIN32) */
+}
+
+/*
+ * save_history_file() - Save History Data to the mapped history file.
+ *
+ * Description:
+ *	Same as save_history_data() below, but the entry is appended to
+ * the mapped file. The file is also written (asynchronously) each time
+ * the ring wraps, so the history survives a host crash too.
+ */
+static void
+save_history_file(
+    struct dinfo	*dip,
+    u_long		file_number,
+    u_long		record_number,
+    test_mode_t		test_mode,
+    Offset_t		offset,
+    void		*buffer,
+    size_t		rsize,
+    ssize_t		tsize)
+{
+    hist_file_header_t *hfh = dip->di_history_map;
+    hist_file_entry_t *hfe;
+    uint64_t sequence;
+    uint8_t *hbp;
+    size_t data_size, data_index;
+    uint32_t buf;
+
+    if (hfh == NULL) {
+	if (open_history_file(dip) == FAILURE) {
+	    dip->di_history_size = 0;	/* Disable history. */
+	    return;
+	}
+	hfh = dip->di_history_map;
+    }
+    sequence = os_atomic_fetch_add64(&hfh->hfh_sequence, 1);
+    hfe = HIST_FILE_ENTRY(hfh, (sequence % hfh->hfh_entries));
+    /* Invalidate the entry while it's being updated. */
+    os_atomic_store64(&hfe->hfe_sequence, 0);
+    hfe->hfe_offset = (uint64_t)offset;
+    hfe->hfe_record_number = record_number;
+    hfe->hfe_request_size = rsize;
+    hfe->hfe_transfer_size = tsize;
+    hfe->hfe_file_number = (uint32_t)file_number;
+    hfe->hfe_test_mode = (uint32_t)test_mode;
+    if (dip->di_history_timing) { /* expensive syscall! */
+	struct timeval tv;
+	(void)highresolutiontime(&tv, NULL);
+	hfe->hfe_secs = (uint32_t)tv.tv_sec;
+	hfe->hfe_usecs = (uint32_t)tv.tv_usec;
+    }
+    /* On error or end of file, save data upto the requested data size. */
+    if (tsize <= (ssize_t) 0) {
+	data_size = MIN((size_t)hfh->hfh_data_size, rsize);
+    } else {
+	data_size = MIN((size_t)hfh->hfh_data_size, (size_t)tsize);
+    }
+    hbp = (uint8_t *)(hfe + 1);
+    for (buf = 0, data_index = 0; (buf < hfh->hfh_data_bufs) && (data_index < rsize); buf++) {
+	(void)memcpy(hbp, ((uint8_t *)buffer + data_index), data_size);
+	hbp += hfh->hfh_data_size;
+	data_index += hfh->hfh_bsize;
+    }
+    os_atomic_store64(&hfe->hfe_sequence, (sequence + 1));
+
+#if !defined(WIN32)
+    if ( ((sequence + 1) % hfh->hfh_entries) == 0 ) {
+	(void)msync(hfh, dip->di_history_map_size, MS_ASYNC);
+    }
+#endif /* !defined(WIN32) */
+    return;
+}
+
+/*
+ * dump_history_map() - Dump a (mapped) history file.
+ *
+ * Description:
+ *	Used for dumping history files at runtime and offline, so only the
+ * information saved in the history file header is used. Like the history
+ * dumped from memory, the latest request is reported first.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	hfh = The history file header.
+ */
+static void
+dump_history_map(dinfo_t *dip, hist_file_header_t *hfh)
+{
+    hist_file_entry_t *hfe, *phfe;
+    uint64_t sequence = os_atomic_load64(&hfh->hfh_sequence);
+    uint64_t first, seq;
+    uint32_t entries, blocks, i, buf;
+    int field_width = 16;
+    uint8_t *hbp;
+    /* Note: Never read data beyond the entry, even if the header is bogus! */
+    size_t data_space = (hfh->hfh_entry_size > sizeof(*hfe))
+			  ? (hfh->hfh_entry_size - sizeof(*hfe)) : 0;
+
+    first = (sequence > hfh->hfh_entries) ? (sequence - hfh->hfh_entries) : 0;
+    entries = (uint32_t)(sequence - first);
+    if (entries == 0) {
+	Printf(dip, "No history entries to report!\n");
+	return;
+    }
+    Printf(dip, "\n");
+    Printf(dip, "Dumping History Data for %s (%u entries, " LUF " requests, blocking %u bytes):\n",
+	   hfh->hfh_dname, entries, sequence, hfh->hfh_bsize);
+    Printf(dip, "\n");
+
+    for (seq = sequence; seq-- > first; ) {
+	size_t request_size, data_size, data_index;
+	uint64_t offset;
+	large_t iolba = NO_LBA;
+	char *bp, msg[STRING_BUFFER_SIZE];
+
+	hfe = HIST_FILE_ENTRY(hfh, (seq % hfh->hfh_entries));
+	/* Skip entries being updated, or never committed (crash). */
+	if (os_atomic_load64(&hfe->hfe_sequence) != (seq + 1)) {
+	    Printf(dip, "Entry " LUF " is incomplete, skipping...\n", seq);
+	    continue;
+	}
+	offset = hfe->hfe_offset;
+	if (hfe->hfe_transfer_size <= 0) {
+	    request_size = (size_t)hfe->hfe_request_size;
+	    Printf(dip, "Record #" LUF " - Transfer completed with " LDF ", reporting attempted request size\n",
+		   hfe->hfe_record_number, hfe->hfe_transfer_size);
+	} else {
+	    request_size = (size_t)hfe->hfe_transfer_size;
+	}
+	data_size = MIN((size_t)hfh->hfh_data_size, request_size);
+	if ( (hfh->hfh_flags & HIST_FLAG_RANDOM) && hfh->hfh_dsize ) {
+	    iolba = (offset / hfh->hfh_dsize);
+	} else if ( (hfh->hfh_flags & (HIST_FLAG_LBDATA | HIST_FLAG_IOT)) && hfh->hfh_lbdata_size ) {
+	    iolba = (offset / hfh->hfh_lbdata_size);
+	}
+	bp = msg;
+	if (hfh->hfh_flags & HIST_FLAG_TIMING) {
+	    bp += sprintf(bp, "%u.%06u ", hfe->hfe_secs, hfe->hfe_usecs);
+	    /* Report the time since the previous request. */
+	    phfe = HIST_FILE_ENTRY(hfh, ((seq - 1) % hfh->hfh_entries));
+	    if ( (seq > first) && (os_atomic_load64(&phfe->hfe_sequence) == seq) ) {
+		int secs = (int)(hfe->hfe_secs - phfe->hfe_secs);
+		int usecs = (int)hfe->hfe_usecs - (int)phfe->hfe_usecs;
+		if (usecs < 0) {
+		    secs--;
+		    usecs += uSECS_PER_SEC;
+		}
+		bp += sprintf(bp, "(%d.%06d) ", secs, usecs);
+	    }
+	}
+	if (hfh->hfh_flags & HIST_FLAG_FILES) {
+	    bp += sprintf(bp, "File #%u, ", hfe->hfe_file_number);
+	}
+	bp += sprintf(bp, "Record #" LUF " - %s %u byte%s ", hfe->hfe_record_number,
+		      (hfe->hfe_test_mode == READ_MODE) ? "Read" : "Wrote",
+		      (unsigned int)request_size, (request_size > 1) ? "s" : "");
+	if ( (iolba != NO_LBA) && hfh->hfh_dsize ) {
+	    blocks = (uint32_t)howmany(request_size, hfh->hfh_dsize);
+	    bp += sprintf(bp, "(%u block%s) ", blocks, (blocks > 1) ? "s" : "");
+	    if (blocks > 1) {
+		bp += sprintf(bp, "LBA's " LUF " - " LUF " ", iolba, (iolba + blocks - 1));
+	    } else {
+		bp += sprintf(bp, "LBA " LUF " ", iolba);
+	    }
+	}
+	bp += sprintf(bp, "(offset " LUF ")\n", offset);
+	Printf(dip, "%s", msg);
+
+	/*
+	 * Display the requested block data bytes (if any).
+	 */
+	hbp = (uint8_t *)(hfe + 1);
+	for (buf = 0, data_index = 0;
+	     data_size && (buf < hfh->hfh_data_bufs) && (data_index < request_size) &&
+	     ((((size_t)buf * hfh->hfh_data_size) + data_size) <= data_space);
+	     buf++, data_index += hfh->hfh_bsize) {
+	    uint8_t *dbp = hbp + (buf * hfh->hfh_data_size);
+	    if (hfh->hfh_data_bufs > 1) {
+		Printf(dip, "  Buffer %u: (offset " LUF ")\n", buf, (offset + data_index));
+		Printf(dip, "    Offset\n");
+	    } else {
+		Printf(dip, "Offset\n");
+	    }
+	    for (i = 0; (i < data_size); ) {
+		if ((i % field_width) == 0) {
+		    if (i) Print(dip, "\n");
+		    Printf(dip, (hfh->hfh_data_bufs > 1) ? "    %06u  " : "%06u  ", i);
+		}
+		if ( (hfh->hfh_flags & HIST_FLAG_IOT) && ((data_size - i) >= sizeof(uint32_t)) ) {
+		    Print(dip, "%08x ", get_lbn(dbp));
+		    i += sizeof(uint32_t);
+		    dbp += sizeof(uint32_t);
+		} else {
+		    Print(dip, "%02x ", *dbp);
+		    i++; dbp++;
+		}
+	    }
+	    if (i) Print(dip, "\n");
+	}
+	if (data_size) Printf(dip, "\n");
+    }
+    return;
+}
+
+/*
+ * show_history_file() - Decode a history file (offline).
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	file = The history file name.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE
+ */
+int
+show_history_file(dinfo_t *dip, char *file)
+{
+#if defined(WIN32)
+    Eprintf(dip, "History files are not supported on Windows!\n");
+    return(FAILURE);
+#else /* !defined(WIN32) */
+    hist_file_header_t *hfh;
+    struct stat sb;
+    int fd, status = SUCCESS;
+
+    if ( (fd = open(file, O_RDONLY)) < 0 ) {
+	Perror(dip, "open() of history file %s failed", file);
+	return(FAILURE);
+    }
+    if (fstat(fd, &sb) < 0) {
+	Perror(dip, "fstat() of history file %s failed", file);
+	(void)close(fd);
+	return(FAILURE);
+    }
+    if (sb.st_size < (off_t)HIST_FILE_HEADER_SIZE) {
+	Eprintf(dip, "File %s is too small to be a history file!\n", file);
+	(void)close(fd);
+	return(FAILURE);
+    }
+    hfh = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_SHARED, fd, (off_t)0);
+    (void)close(fd);
+    if (hfh == MAP_FAILED) {
+	Perror(dip, "mmap() of history file %s failed", file);
+	return(FAILURE);
+    }
+    if ( (hfh->hfh_magic != HIST_FILE_MAGIC) || (hfh->hfh_version != HIST_FILE_VERSION) ) {
+	Eprintf(dip, "File %s is not a history file (magic 0x%08x, version %u)!\n",
+		file, hfh->hfh_magic, hfh->hfh_version);
+	status = FAILURE;
+    } else if ( (hfh->hfh_header_size < sizeof(*hfh)) ||
+		(hfh->hfh_entry_size < (sizeof(hist_file_entry_t) +
+					((uint64_t)hfh->hfh_data_bufs * hfh->hfh_data_size))) ||
+		(memchr(hfh->hfh_dname, '\0', sizeof(hfh->hfh_dname)) == NULL) ) {
+	Eprintf(dip, "History file %s has an inconsistent header (header size %u, entry size %u, data buffers %u, data size %u)!\n",
+		file, hfh->hfh_header_size, hfh->hfh_entry_size, hfh->hfh_data_bufs, hfh->hfh_data_size);
+	status = FAILURE;
+    } else if ( (hfh->hfh_entries == 0) ||
+		((uint64_t)sb.st_size < ((uint64_t)hfh->hfh_header_size +
+					 ((uint64_t)hfh->hfh_entries * hfh->hfh_entry_size))) ) {
+	Eprintf(dip, "History file %s is truncated!\n", file);
+	status = FAILURE;
+    } else {
+	char time_buffer[TIME_BUFFER_SIZE];
+	time_t start_time = (time_t)hfh->hfh_start_time;
+	Printf(dip, "History file %s, Job %u, Thread %u, PID %u, started %s\n",
+	       file, hfh->hfh_job_id, hfh->hfh_thread_number, hfh->hfh_pid,
+	       os_ctime(&start_time, time_buffer, sizeof(time_buffer)));
+	dump_history_map(dip, hfh);
+    }
+    (void)munmap(hfh, (size_t)sb.st_size);
+    return(status);
+#endif /* defined(WIN32) */
+}
+
 /*
  * save_history_data() - Save History Data.
  *
@@ -305,6 +779,10 @@ save_history_data(
     uint32_t bsize;
     int buf, i;
     
+    if (dip->di_history_file) {
+	save_history_file(dip, file_number, record_number, test_mode, offset, buffer, rsize, tsize);
+	return;
+    }
     if (dip->di_history_bsize) {
 	bsize = dip->di_history_bsize;
     } else {
@@ -32,6 +32,13 @@
  *
  * Modification History:
  * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Generate the IOT words with the vector sequence kernels (dtsimd.c).
+ * When verifying (enable=iotformula, the default), the expected data is no
+ * longer generated into the pattern buffer for each record. Instead, the
+ * data read is compared directly against the IOT formula, and the pattern
+ * buffer is only generated when a mismatch must be reported.
+ * 
  * February 22nd, 2021 by Robin T. Miller
  *      When analyzing IOT good/bad data blocks, report block numbers that
  * are zero based rather than starting at block 1 to avoid confusion, and
@@ -99,6 +106,8 @@ hbool_t	is_iot_data(dinfo_t *dip, uint8_t *rptr, size_t rsize, int rprefix_size,
 		    int *iot_offset, iotlba_t *rlbn);
 
 static char *notmapped_str = "<not mapped or not a valid offset>";
+static u_int32 fill_iotdata(dinfo_t *dip, u_char *buffer, size_t bcount,
+			    u_int32 lba, u_int32 lbsize);
 
 /*
  * init_iotdata() - Initialize Buffer with IOT test pattern.
@@ -122,6 +131,10 @@ static char *notmapped_str = "<not mapped or not a valid offset>";
  * 
  * Note: If the count is smaller than sizeof(u_int32), then no lba is
  * encoded in the buffer.  Instead, we init odd bytes with ~0.
+ *
+ * Note: When the pattern buffer is initialized for verification and the
+ * IOT formula verify is enabled, the expected data is deferred, and then
+ * generated only if verify_iotdata() detects a mismatch (see below).
  */
 u_int32	
 init_iotdata (
@@ -130,6 +143,97 @@ init_iotdata (
 	size_t		bcount,
 	u_int32		lba,
 	u_int32		lbsize )
+{
+    dip->di_iot_deferred = False;
+#if !_BIG_ENDIAN_
+    if ( (buffer == dip->di_pattern_buffer) && (dip->di_iot_formula == True) &&
+	 (dip->di_btag_flag == False) && (dip->di_fprefix_string == NULL) &&
+	 (dip->di_timestamp_flag == False) && lbsize && ((lbsize % sizeof(u_int32)) == 0) &&
+	 (bcount >= sizeof(u_int32)) ) {
+	size_t words = (bcount / sizeof(u_int32));
+	size_t wperb = (lbsize / sizeof(u_int32));
+	dip->di_pattern_bufptr = buffer;
+	dip->di_iot_deferred = True;
+	dip->di_iot_deferred_lba = lba;
+	dip->di_iot_deferred_count = bcount;
+	/* Return the next lba, same as generating the data. */
+	return( lba + (u_int32)((words + wperb - 1) / wperb) );
+    }
+#endif /* !_BIG_ENDIAN_ */
+    return( fill_iotdata(dip, buffer, bcount, lba, lbsize) );
+}
+
+/*
+ * verify_iotdata() - Verify Data Against the IOT Formula.
+ *
+ * Description:
+ *	This compares the data read against the deferred IOT pattern, with
+ * the expected words computed in registers, so the expected data is never
+ * written to or read from memory. This is a fast path only, it does not
+ * report mismatches, the caller must use expand_iotdata() then do the full
+ * verify, which locates and reports the bad data.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	buffer = The data buffer to verify.
+ *	bcount = The number of bytes to verify.
+ *
+ * Return Value:
+ *	Returns True if the data matches, False if mismatched (or not deferred).
+ */
+hbool_t
+verify_iotdata(dinfo_t *dip, u_char *buffer, size_t bcount)
+{
+    size_t wperb = (dip->di_lbdata_size / sizeof(u_int32));
+    size_t words = (bcount / sizeof(u_int32));
+    size_t residual = (bcount % sizeof(u_int32));
+    u_int32 *wptr = (u_int32 *)buffer;
+    u_int32 lba = dip->di_iot_deferred_lba;
+    u_int32 lba_pattern = lba;
+
+    if ( (dip->di_iot_deferred == False) || (bcount > dip->di_iot_deferred_count) ) {
+	return(False);
+    }
+    while (words) {
+	size_t wcount = MIN(wperb, words);
+	if (simd_compare_sequence(dip, wptr, wcount, lba, dip->di_iot_seed_per_pass) == False) {
+	    return(False);
+	}
+	lba_pattern = lba + (u_int32)(wcount * dip->di_iot_seed_per_pass);
+	lba++;
+	wptr += wcount;
+	words -= wcount;
+    }
+    if (residual) {
+	u_char expected[sizeof(u_int32)];
+	init_buffer(dip, expected, sizeof(expected), lba_pattern);
+	if (memcmp(wptr, expected, residual) != 0) return(False);
+    }
+    dip->di_iot_deferred = False;
+    return(True);
+}
+
+/*
+ * expand_iotdata() - Generate the Deferred IOT Pattern.
+ *
+ * Description:
+ *	Called on a verify mismatch (or when the expected data is needed),
+ * to generate the deferred IOT data into the pattern buffer, so all of the
+ * existing data compare and IOT analysis functions work as before.
+ */
+void
+expand_iotdata(dinfo_t *dip)
+{
+    if (dip->di_iot_deferred == True) {
+	dip->di_iot_deferred = False;
+	(void)fill_iotdata(dip, dip->di_pattern_buffer, dip->di_iot_deferred_count,
+			   dip->di_iot_deferred_lba, dip->di_lbdata_size);
+    }
+    return;
+}
+
+static u_int32
+fill_iotdata(dinfo_t *dip, u_char *buffer, size_t bcount, u_int32 lba, u_int32 lbsize)
 {
     register ssize_t count = (ssize_t)bcount;
     register u_int32 lba_pattern;
@@ -226,15 +330,22 @@ init_iotdata (
 		count -= (ssize_t)pcount;
 	    }
             lba_pattern = lba++;
-            for (i = 0; (i < wperb) && (count >= iot_icnt); i++) {
 #if _BIG_ENDIAN_
+            for (i = 0; (i < wperb) && (count >= iot_icnt); i++) {
                 init_swapped(dip, (u_char *)bptr++, iot_icnt, lba_pattern);
-#else /* !_BIG_ENDIAN_ */
-                *bptr++ = lba_pattern;
-#endif /* _BIG_ENDIAN_ */
 		lba_pattern += dip->di_iot_seed_per_pass;
                 count -= iot_icnt;
             }
+#else /* !_BIG_ENDIAN_ */
+	    /* Generate this blocks' words with the vector kernels. */
+	    i = (int)MIN((ssize_t)wperb, (count / iot_icnt));
+	    if (i > 0) {
+		lba_pattern = simd_fill_sequence(dip, bptr, (size_t)i, lba_pattern,
+						 dip->di_iot_seed_per_pass);
+		bptr += i;
+		count -= (i * iot_icnt);
+	    }
+#endif /* _BIG_ENDIAN_ */
         }
         /* Handle any residual count here! */
         if ( (count > 0) && (count < iot_icnt)) {
@@ -31,6 +31,18 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Print %json job query keepalives without the message prefix.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Clamp dt_claim_iorange() claims to the limits with compare and swap.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Create, start, and stop the job time series recorder (tsfile=).
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add dt_claim_iorange(), to claim offsets with atomics (no I/O lock).
+ *
  * March 8th, 2021 by Robin T. Miller
  *      Add resume_job_thread() to resume current job thread.
  * 
@@ -272,6 +284,74 @@ dt_release_iolock(dinfo_t *dip, io_global_data_t *iogp)
     return(status);
 }
 
+/*
+ * dt_claim_iorange() - Claim the Next I/O Record (without the I/O lock).
+ *
+ * Description:
+ *	The shared bytes read or written is used as the sequential cursor,
+ * so one atomic add claims both the offset and the record number, which
+ * matches the record numbers assigned with the I/O lock (for btags).
+ * With iochunk=value, that many records are claimed at once, then used
+ * by this thread without touching the shared data at all.
+ *
+ *	Claims are clamped to the data and record limits with a compare and
+ * swap loop, so the shared counters never exceed the limits.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	iogp = The I/O global data pointer.
+ *	io_bytes = The shared bytes read or written.
+ *	io_records = The shared records read or written.
+ *	dsize = The record size (fixed size records only).
+ *	data_limit = The data limit.
+ *	bsize = Pointer to return the request size.
+ *	record = Pointer to return the record number.
+ *
+ * Outputs:
+ *	dip->di_offset is set to the claimed offset.
+ *
+ * Return Value:
+ *	Returns True if claimed, or False if the data/record limit was reached.
+ */
+hbool_t
+dt_claim_iorange(dinfo_t *dip, io_global_data_t *iogp, v_large *io_bytes,
+		 v_large *io_records, size_t dsize, large_t data_limit,
+		 size_t *bsize, u_long *record)
+{
+    large_t position;
+
+    if (dip->di_iochunk_next >= dip->di_iochunk_end) {
+	large_t chunk = (dip->di_iochunk) ? dip->di_iochunk : 1;
+	large_t records, start, end, previous, record_number;
+
+	start = os_atomic_load64(io_bytes);
+	for (;;) {
+	    /* Another thread stopped (error or end of media), so stop too. */
+	    if (iogp->io_end_of_file == True) {
+		return(False);
+	    }
+	    record_number = (start / dsize);
+	    if ( (start >= data_limit) || (record_number >= dip->di_record_limit) ) {
+		return(False);
+	    }
+	    records = MIN(chunk, (dip->di_record_limit - record_number));
+	    end = MIN((start + (records * dsize)), data_limit);
+	    previous = os_atomic_cas64(io_bytes, start, end);
+	    if (previous == start) break;
+	    start = previous;		/* Another thread claimed, so retry. */
+	}
+	(void)os_atomic_fetch_add64(io_records, howmany((end - start), dsize));
+	dip->di_iochunk_next = start;
+	dip->di_iochunk_end = end;
+    }
+    position = dip->di_iochunk_next;
+    *bsize = (size_t)MIN((large_t)dsize, (dip->di_iochunk_end - position));
+    *record = (u_long)(position / dsize) + 1;
+    dip->di_iochunk_next += *bsize;
+    dip->di_offset = (Offset_t)(iogp->io_starting_offset + position);
+    return(True);
+}
+
 /*
  * find_job_by_id() - Find a job by its' job ID.
  *
@@ -461,6 +541,10 @@ cleanup_job(dinfo_t *mdip, job_info_t *job, hbool_t lock_jobs)
 	    return(lock_status);
 	}
     }
+    /* Stop the time series recorder, before freeing the threads it samples. */
+    if (job->ji_time_series) {
+	stop_time_series(mdip, job);
+    }
     /* Free job resources. */
     if (tip = job->ji_tinfo) {
 	dinfo_t *dip = NULL;
@@ -1549,7 +1633,7 @@ query_threads_info(dinfo_t *mdip, threads_info_t *tip, char *query_string)
 	}
 	if (query_string) {
 	    (void)FmtKeepAlive(dip, query_string, buffer);
-	    LogMsg(mdip, ofp, logLevelLog, 0, "%s\n", buffer);
+	    LogMsg(mdip, ofp, logLevelLog, KeepAliveFlags(query_string), "%s\n", buffer);
 	} else {
 	    int status = WARNING;
 	    if ( (dip->di_thread_state == TS_RUNNING) && dip->di_pkeepalive) {
@@ -2239,6 +2323,15 @@ execute_threads(dinfo_t *mdip, dinfo_t **initial_dip, job_id_t *job_id)
 	    return(FAILURE);
 	}
     }
+    /* Create the time series file, if specified. */
+    if (dip->di_ts_file) {
+	status = create_time_series(dip, job);
+	if (status == FAILURE) {
+	    release_job_lock(dip, job);
+	    (void)cleanup_job(dip, job, False);
+	    return(FAILURE);
+	}
+    }
     /* Do special job initialization (if any). */
     if (dip->di_iobf && dip->di_iobf->iob_job_init) {
 	status = (*dip->di_iobf->iob_job_init)(dip, job);
@@ -2333,6 +2426,10 @@ execute_threads(dinfo_t *mdip, dinfo_t **initial_dip, job_id_t *job_id)
     tip->ti_dts = dts;
 
     job->ji_tinfo = tip;
+    /* Start recording before the threads are released to start their I/O. */
+    if (job->ji_time_series) {
+	(void)start_time_series(dip, job);
+    }
     (void)insert_job(dip, job);
     
     /*
@@ -2479,6 +2576,9 @@ wait_for_threads(dinfo_t *mdip, threads_info_t *tip)
 	}
     }
     dip->di_job->ji_job_end = time((time_t) 0);
+    if (dip->di_job->ji_time_series) {
+	stop_time_series(mdip, dip->di_job);
+    }
     if (dip->di_iobf) {
 	dip = tip->ti_dts[0];
         if (dip->di_iobf->iob_job_finish) {
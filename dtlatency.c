@@ -0,0 +1,402 @@
+/****************************************************************************
+ *      								    *
+ *      		  COPYRIGHT (c) 1988 - 2026     		    *
+ *      		   This Software Provided       		    *
+ *      			     By 				    *
+ *      		  Robin's Nest Software Inc.    		    *
+ *      								    *
+ * Permission to use, copy, modify, distribute and sell this software and   *
+ * its documentation for any purpose and without fee is hereby granted,     *
+ * provided that the above copyright notice appear in all copies and that   *
+ * both that copyright notice and this permission notice appear in the      *
+ * supporting documentation, and that the name of the author not be used    *
+ * in advertising or publicity pertaining to distribution of the software   *
+ * without specific, written prior permission.  			    *
+ *      								    *
+ * THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,        *
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN      *
+ * NO EVENT SHALL HE BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL   *
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR    *
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS  *
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF   *
+ * THIS SOFTWARE.       						    *
+ *      								    *
+ ****************************************************************************/
+/*
+ * Module:      dtlatency.c
+ * Author:      Robin T. Miller
+ * Date:	October 15th, 2026
+ *
+ * Description:
+ *      I/O latency statistics and histogram support functions.
+ *
+ *	Each thread records latencies in its own read and write histograms,
+ * so no locking is required, and the histograms are merged at job end to
+ * report the tail latency percentiles (p50 through p99.99). Averages hide
+ * the occasional slow I/O, which is often the behavior we are hunting!
+ *
+ * Modification History:
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Export the percentile tables, so sio reports the same percentiles.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Count the bytes transferred in update_latency_stats(), and add the
+ * CSV latency formatting, both for the time series recorder.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add format_latency_json() for the JSON statistics records.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Initial creation, with the log-linear latency histograms.
+ */
+#include "dt.h"
+
+/*
+ * The percentiles reported, and their display names.
+ */
+double latency_percentiles[LATENCY_PERCENTILES] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+char *latency_percentile_names[LATENCY_PERCENTILES] = { "p50", "p90", "p99", "p99.9", "p99.99" };
+
+/*
+ * latency_bucket() - Return the Histogram Bucket for a Latency.
+ */
+static int
+latency_bucket(uint64_t latency)
+{
+    int msb, shift;
+
+    if (latency < (2 * LATENCY_SUB_BUCKETS)) {
+	return( (int)latency );
+    }
+#if defined(__GNUC__)
+    msb = (63 - __builtin_clzll(latency));
+#else /* !defined(__GNUC__) */
+    {
+	uint64_t value = latency;
+	for (msb = 0; (value >>= 1); msb++) ;
+    }
+#endif /* defined(__GNUC__) */
+    shift = (msb - LATENCY_SUB_BITS);
+    return( (shift * LATENCY_SUB_BUCKETS) + (int)(latency >> shift) );
+}
+
+/*
+ * latency_bucket_value() - Return the Highest Latency for a Bucket.
+ */
+static uint64_t
+latency_bucket_value(int bucket)
+{
+    int shift;
+
+    if (bucket < (2 * LATENCY_SUB_BUCKETS)) {
+	return( (uint64_t)bucket );
+    }
+    shift = ((bucket / LATENCY_SUB_BUCKETS) - 1);
+    return( (((uint64_t)(LATENCY_SUB_BUCKETS + (bucket % LATENCY_SUB_BUCKETS)) << shift) +
+	     ((uint64_t)1 << shift)) - 1 );
+}
+
+/*
+ * record_latency() - Record a Latency in the Thread Histogram.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	optype = The operation type (READ_OP or WRITE_OP).
+ *	latency = The latency (in microseconds).
+ *
+ * Return Value:
+ *	void
+ */
+void
+record_latency(dinfo_t *dip, optype_t optype, uint64_t latency)
+{
+    latency_histogram_t **lhpp;
+    latency_histogram_t *lhp;
+
+    lhpp = (optype == READ_OP) ? &dip->di_read_histogram : &dip->di_write_histogram;
+    if ( (lhp = *lhpp) == NULL) {
+	lhp = *lhpp = Malloc(dip, sizeof(*lhp));
+	if (lhp == NULL) return;
+    }
+    lhp->lh_buckets[latency_bucket(latency)]++;
+    lhp->lh_count++;
+    if (latency > lhp->lh_max_latency) {
+	lhp->lh_max_latency = latency;
+    }
+    return;
+}
+
+/*
+ * update_latency_stats() - Update the Latency Statistics.
+ *
+ * Description:
+ *	Update the total and read/write minimum, maximum, and accumulated
+ * latencies, then record the latency in the thread histogram.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	optype = The operation type (READ_OP or WRITE_OP).
+ *	latency = The latency (in microseconds).
+ *	count = The bytes transferred (if any).
+ *
+ * Return Value:
+ *	void
+ */
+void
+update_latency_stats(dinfo_t *dip, optype_t optype, uint64_t latency, ssize_t count)
+{
+    if ( latency < dip->di_min_latency ) {
+        dip->di_min_latency = latency;
+    }
+    if ( latency > dip->di_max_latency ) {
+        dip->di_max_latency = latency;
+    }
+    dip->di_total_latency_ios++;
+    dip->di_total_latency += latency;
+    if (optype == READ_OP) {
+	dip->di_read_latency_ios++;
+	dip->di_read_latency += latency;
+	if (count > (ssize_t) 0) {
+	    dip->di_io_read_bytes += count;
+	}
+	if ( latency < dip->di_min_read_latency ) {
+	    dip->di_min_read_latency = latency;
+	}
+	if ( latency > dip->di_max_read_latency ) {
+	    dip->di_max_read_latency = latency;
+	}
+    } else {
+	dip->di_write_latency_ios++;
+	dip->di_write_latency += latency;
+	if (count > (ssize_t) 0) {
+	    dip->di_io_write_bytes += count;
+	}
+	if ( latency < dip->di_min_write_latency ) {
+	    dip->di_min_write_latency = latency;
+	}
+	if ( latency > dip->di_max_write_latency ) {
+	    dip->di_max_write_latency = latency;
+	}
+    }
+    record_latency(dip, optype, latency);
+    return;
+}
+
+/*
+ * merge_latency_histogram() - Merge a Thread Histogram.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	dhpp = Pointer to the destination histogram (allocated if NULL).
+ *	shp = The source histogram (may be NULL).
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (no memory).
+ */
+int
+merge_latency_histogram(dinfo_t *dip, latency_histogram_t **dhpp, latency_histogram_t *shp)
+{
+    latency_histogram_t *dhp;
+    int bucket;
+
+    if ( (shp == NULL) || (shp->lh_count == 0) ) {
+	return(SUCCESS);
+    }
+    if ( (dhp = *dhpp) == NULL) {
+	dhp = *dhpp = Malloc(dip, sizeof(*dhp));
+	if (dhp == NULL) return(FAILURE);
+    }
+    for (bucket = 0; (bucket < LATENCY_BUCKETS); bucket++) {
+	dhp->lh_buckets[bucket] += shp->lh_buckets[bucket];
+    }
+    dhp->lh_count += shp->lh_count;
+    if (shp->lh_max_latency > dhp->lh_max_latency) {
+	dhp->lh_max_latency = shp->lh_max_latency;
+    }
+    return(SUCCESS);
+}
+
+/*
+ * latency_percentile() - Return a Latency Percentile.
+ *
+ * Description:
+ *	The read and write histograms are combined (either may be NULL),
+ * so the total percentiles are calculated without a merged histogram.
+ * The highest latency of the bucket is returned, capped at the maximum.
+ *
+ * Inputs:
+ *	rhp = The read histogram.
+ *	whp = The write histogram.
+ *	percentile = The percentile (0.0 to 100.0).
+ *
+ * Return Value:
+ *	Returns the latency (in microseconds), or 0 if no samples.
+ */
+uint64_t
+latency_percentile(latency_histogram_t *rhp, latency_histogram_t *whp, double percentile)
+{
+    uint64_t count = 0, rank, total = 0, max_latency = 0, latency;
+    int bucket;
+
+    if (rhp) {
+	count += rhp->lh_count;
+	max_latency = rhp->lh_max_latency;
+    }
+    if (whp) {
+	count += whp->lh_count;
+	max_latency = MAX(max_latency, whp->lh_max_latency);
+    }
+    if (count == 0) return(0);
+
+    rank = (uint64_t)(((percentile / 100.0) * (double)count) + 0.5);
+    if (rank == 0) rank = 1;
+    if (rank > count) rank = count;
+
+    for (bucket = 0; (bucket < LATENCY_BUCKETS); bucket++) {
+	if (rhp) total += rhp->lh_buckets[bucket];
+	if (whp) total += whp->lh_buckets[bucket];
+	if (total >= rank) break;
+    }
+    latency = latency_bucket_value(bucket);
+    return( MIN(latency, max_latency) );
+}
+
+/*
+ * report_latency_percentiles() - Report the Latency Percentiles.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	text = The field text to display.
+ *	rhp = The read histogram (may be NULL).
+ *	whp = The write histogram (may be NULL).
+ *
+ * Return Value:
+ *	void
+ */
+void
+report_latency_percentiles(dinfo_t *dip, char *text, latency_histogram_t *rhp, latency_histogram_t *whp)
+{
+    double scaled;
+    char *suffix;
+    int precision = 0;
+    int index;
+
+    if ( ((rhp == NULL) || (rhp->lh_count == 0)) &&
+	 ((whp == NULL) || (whp->lh_count == 0)) ) {
+	return;
+    }
+    Lprintf(dip, DT_FIELD_WIDTH, text);
+    for (index = 0; (index < LATENCY_PERCENTILES); index++) {
+	uint64_t latency = latency_percentile(rhp, whp, latency_percentiles[index]);
+	scale_timer_value((double)latency, &scaled, &suffix, &precision);
+	Lprintf(dip, "%s%s %.*f%s", (index) ? ", " : "",
+		latency_percentile_names[index], precision, scaled, suffix);
+    }
+    Lprintf(dip, "\n");
+    return;
+}
+
+/*
+ * format_latency_json() - Format Latency Statistics as a JSON Object.
+ *
+ * Description:
+ *	Formats a named JSON object, for example:
+ *
+ *	"read":{"ios":100,"avg_us":45.210,"min_us":12,"max_us":980,
+ *		"percentiles_us":{"p50":40,"p90":60,"p99":300,"p99.9":980,"p99.99":980}}
+ *
+ * Inputs:
+ *	buffer = The buffer to format into.
+ *	name = The JSON object name.
+ *	ios = The number of latency I/O's.
+ *	latency = The accumulated latency (in microseconds).
+ *	min_latency = The minimum latency.
+ *	max_latency = The maximum latency.
+ *	rhp = The read histogram (may be NULL).
+ *	whp = The write histogram (may be NULL).
+ *
+ * Return Value:
+ *	Returns the number of characters formatted.
+ */
+size_t
+format_latency_json(char *buffer, char *name, uint64_t ios, uint64_t latency,
+		    uint64_t min_latency, uint64_t max_latency,
+		    latency_histogram_t *rhp, latency_histogram_t *whp)
+{
+    char *bp = buffer;
+    int index;
+
+    bp += sprintf(bp, "\"%s\":{\"ios\":" LUF ",\"avg_us\":%.3f,\"min_us\":" LUF ",\"max_us\":" LUF,
+		  name, (large_t)ios, (ios) ? ((double)latency / (double)ios) : 0.0,
+		  (large_t)((ios) ? min_latency : 0), (large_t)max_latency);
+    if ( (rhp && rhp->lh_count) || (whp && whp->lh_count) ) {
+	bp += sprintf(bp, ",\"percentiles_us\":{");
+	for (index = 0; (index < LATENCY_PERCENTILES); index++) {
+	    bp += sprintf(bp, "%s\"%s\":" LUF, (index) ? "," : "", latency_percentile_names[index],
+			  (large_t)latency_percentile(rhp, whp, latency_percentiles[index]));
+	}
+	bp += sprintf(bp, "}");
+    }
+    bp += sprintf(bp, "}");
+    return( (size_t)(bp - buffer) );
+}
+
+/*
+ * format_latency_csv_header() - Format the CSV Latency Percentile Names.
+ *
+ * Inputs:
+ *	buffer = The buffer to format into.
+ *
+ * Return Value:
+ *	Returns the number of characters formatted.
+ */
+size_t
+format_latency_csv_header(char *buffer)
+{
+    char *bp = buffer;
+    int index;
+
+    for (index = 0; (index < LATENCY_PERCENTILES); index++) {
+	bp += sprintf(bp, "%s%s_us", (index) ? "," : "", latency_percentile_names[index]);
+    }
+    return( (size_t)(bp - buffer) );
+}
+
+/*
+ * format_latency_csv() - Format the Latency Percentiles as CSV Fields.
+ *
+ * Inputs:
+ *	buffer = The buffer to format into.
+ *	rhp = The read histogram (may be NULL).
+ *	whp = The write histogram (may be NULL).
+ *
+ * Return Value:
+ *	Returns the number of characters formatted.
+ */
+size_t
+format_latency_csv(char *buffer, latency_histogram_t *rhp, latency_histogram_t *whp)
+{
+    char *bp = buffer;
+    int index;
+
+    for (index = 0; (index < LATENCY_PERCENTILES); index++) {
+	bp += sprintf(bp, "%s" LUF, (index) ? "," : "",
+		      (large_t)latency_percentile(rhp, whp, latency_percentiles[index]));
+    }
+    return( (size_t)(bp - buffer) );
+}
+
+void
+free_latency_histograms(dinfo_t *dip)
+{
+    if (dip->di_read_histogram) {
+	Free(dip, dip->di_read_histogram);
+	dip->di_read_histogram = NULL;
+    }
+    if (dip->di_write_histogram) {
+	Free(dip, dip->di_write_histogram);
+	dip->di_write_histogram = NULL;
+    }
+    return;
+}
@@ -32,11 +32,19 @@
  *
  * Modification History:
  *
+ * October 16th, 2026 by Robin T. Miller
+ *	Replace the global page aligned buffer list with per-thread size
+ * class pools, so aligned allocations and frees are O(1) without locking.
+ *
  * August 17th, 2013 by Robin T Miller
  * 	Moving memory allocation functions here.
  */
 #include "dt.h"
 
+#if !defined(WIN32)
+#  include <sys/mman.h>
+#endif /* !defined(WIN32) */
+
 void
 report_nomem(dinfo_t *dip, size_t bytes)
 {
@@ -133,33 +141,246 @@ Realloc(dinfo_t *dip, void *bp, size_t bytes)
 
 /* ========================================================================= */
 
-//#define NEED_PAGESIZE	1	/* Define to obtain page size. */
+/*
+ * Page aligned buffers are carved from a per-thread pool of size classes.
+ * Each allocation starts with one extra page, which holds the pool header
+ * at its base, and a tag just before the aligned address points back to
+ * that header, so free_palign() finds its buffer without any search. The
+ * freeing thread caches released buffers for reuse, so buffer churn from
+ * variable record sizes, per-file buffers, and AIO buffers, avoids the
+ * system allocator, fresh page faults, and any global lock.
+ *
+ * Note: Only small buffers are zeroed, since data buffers are always
+ * initialized by their callers. Large buffers are not pooled at all.
+ */
+#define MPA_MAGIC		0x4D504131	/* The buffer magic ("MPA1").	*/
+#define MPA_CLASSES		64		/* The number of size classes.	*/
+#define MPA_NOCLASS		0xFFFF		/* Unpooled buffer class.	*/
+#define MPA_POOL_MAX		(64 * MBYTE_SIZE) /* Largest pooled class.	*/
+#define MPA_CLASS_CACHED	16		/* Buffers cached per class.	*/
+#define MPA_CACHE_MAX		(256 * MBYTE_SIZE) /* Bytes cached per thread.	*/
+#define MPA_HUGE_SIZE		(2 * MBYTE_SIZE) /* The huge page size.	*/
+
+#define MPA_MAPPED		0x01		/* Buffer is mmap()'ed.		*/
+
+typedef struct mpa_hdr {
+    uint32_t	mh_magic;		/* The buffer header magic.	*/
+    uint16_t	mh_class;		/* The size class index.	*/
+    uint16_t	mh_flags;		/* The allocation flags.	*/
+    size_t	mh_size;		/* The allocation size.		*/
+    struct mpa_hdr *mh_next;		/* Next free buffer in class.	*/
+} mpa_hdr_t;
+
+typedef struct mpa_tag {
+    mpa_hdr_t	*mt_hdr;		/* The buffer header address.	*/
+    uint32_t	mt_magic;		/* The buffer tag magic.	*/
+} mpa_tag_t;
+
+typedef struct mpa_cache {
+    mpa_hdr_t	*mc_free[MPA_CLASSES];	/* The free buffer lists.	*/
+    int		mc_count[MPA_CLASSES];	/* The free buffer counts.	*/
+    size_t	mc_bytes;		/* The bytes cached by thread.	*/
+} mpa_cache_t;
+
+#if defined(WIN32)
+static __declspec(thread) mpa_cache_t *mpa_thread_cache = NULL;
+#else /* !defined(WIN32) */
+static pthread_key_t mpa_cache_key;
+static pthread_once_t mpa_cache_once = PTHREAD_ONCE_INIT;
+#endif /* defined(WIN32) */
+
+static void mpa_free_pages(dinfo_t *dip, mpa_hdr_t *hdr);
+static void mpa_release_cache(dinfo_t *dip, mpa_cache_t *mcp);
+
+#if !defined(WIN32)
+
+static void
+mpa_cache_destroy(void *arg)
+{
+    mpa_release_cache(NULL, (mpa_cache_t *)arg);
+    return;
+}
+
+static void
+mpa_cache_init(void)
+{
+    (void)pthread_key_create(&mpa_cache_key, mpa_cache_destroy);
+    return;
+}
+
+#endif /* !defined(WIN32) */
 
 /*
- * This structure is used by the page align malloc/free support code. These
- * "working sets" will contain the malloc-ed address and the page aligned
- * address for the free*() call.
+ * mpa_get_cache() - Get this threads' buffer cache.
+ *
+ * Description:
+ *	The cache is created on first use. On Unix systems, the key
+ * destructor releases the cache when the thread exits, otherwise we
+ * rely on free_palign_cache() being called during thread exit.
  */
-typedef struct mpa_ws {
-    struct mpa_ws *next;
-    void	*palign_addr;
-    void	*malloc_addr;
-    size_t	malloc_size;
-} MPA_WS;
+static mpa_cache_t *
+mpa_get_cache(dinfo_t *dip)
+{
+    mpa_cache_t *mcp;
 
-/* Initialized and uninitialized data. */
+#if defined(WIN32)
+    if ( (mcp = mpa_thread_cache) == NULL ) {
+	mcp = mpa_thread_cache = Malloc(dip, sizeof(*mcp));
+    }
+#else /* !defined(WIN32) */
+    (void)pthread_once(&mpa_cache_once, mpa_cache_init);
+    if ( (mcp = pthread_getspecific(mpa_cache_key)) == NULL ) {
+	mcp = Malloc(dip, sizeof(*mcp));
+	(void)pthread_setspecific(mpa_cache_key, mcp);
+    }
+#endif /* defined(WIN32) */
+    return(mcp);
+}
 
-static pthread_mutex_t malloc_mutex;
-static hbool_t malloc_mutex_inited = False;
+static void
+mpa_release_cache(dinfo_t *dip, mpa_cache_t *mcp)
+{
+    mpa_hdr_t *hdr;
+    int class;
+
+    if (mcp == NULL) return;
+    for (class = 0; class < MPA_CLASSES; class++) {
+	while ( (hdr = mcp->mc_free[class]) ) {
+	    mcp->mc_free[class] = hdr->mh_next;
+	    mpa_free_pages(dip, hdr);
+	}
+    }
+    Free(dip, mcp);
+    return;
+}
+
+/*
+ * mpa_size_class() - Find the size class for a number of pages.
+ *
+ * Description:
+ *	The first four classes are 1 to 4 pages, after which each power
+ * of two is split into four classes, so at most 25% of a buffer is wasted.
+ *
+ * Inputs:
+ *	pages = The number of pages required.
+ *	class_pages = Pointer to return the class size (in pages).
+ *
+ * Return Value:
+ *	The size class index or MPA_NOCLASS if the buffer is not pooled.
+ */
+static uint16_t
+mpa_size_class(size_t pages, size_t *class_pages)
+{
+    size_t base = 4, step;
+    uint16_t class = 4;
+    int n;
 
-static MPA_WS mpa_qhead;	/* local Q head for the malloc stuctures */
+    if (pages <= base) {
+	*class_pages = pages;
+	return( (uint16_t)(pages - 1) );
+    }
+    while (class < MPA_CLASSES) {
+	step = (base / 4);
+	for (n = 1; (n <= 4) && (class < MPA_CLASSES); n++, class++) {
+	    if ( pages <= (base + (n * step)) ) {
+		*class_pages = (base + (n * step));
+		if ( (*class_pages * page_size) > MPA_POOL_MAX ) break;
+		return(class);
+	    }
+	}
+	if (n <= 4) break;
+	base *= 2;
+    }
+    *class_pages = pages;
+    return(MPA_NOCLASS);
+}
+
+/*
+ * mpa_alloc_pages() - Allocate page aligned memory for the pool.
+ *
+ * Description:
+ *	When huge buffers are enabled, large buffers are backed by huge
+ * pages if they are reserved, otherwise transparent huge pages are used
+ * where the OS supports them.
+ *
+ * Return Value:
+ *	Returns the buffer header address (the allocation base).
+ *	Note: Like Malloc(), we terminate on memory failures.
+ */
+static mpa_hdr_t *
+mpa_alloc_pages(dinfo_t *dip, size_t size)
+{
+    hbool_t huge = ( dip && dip->di_bufhuge_flag && (size >= MPA_HUGE_SIZE) );
+    uint16_t flags = 0;
+    void *addr = NULL;
+
+#if defined(MAP_HUGETLB)
+    if (huge) {
+	size_t msize = roundup(size, MPA_HUGE_SIZE);
+	addr = mmap(NULL, msize, (PROT_READ | PROT_WRITE),
+		    (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
+	if (addr == MAP_FAILED) {
+	    if (dip->di_debug_flag) {
+		Printf(dip, "Huge pages are not available for "SUF" bytes, errno = %d\n", msize, errno);
+	    }
+	    addr = NULL;
+	} else {
+	    size = msize;
+	    flags |= MPA_MAPPED;
+	}
+    }
+#endif /* defined(MAP_HUGETLB) */
+    if (addr == NULL) {
+#if defined(WIN32)
+	if ( (addr = _aligned_malloc(size, page_size)) == NULL ) {
+	    Perror(dip, "_aligned_malloc() failed allocating "SUF" bytes.\n", size);
+	    terminate(dip, FAILURE);
+	}
+#else /* !defined(WIN32) */
+	int error = posix_memalign(&addr, page_size, size);
+	if (error) {
+	    tPerror(dip, error, "posix_memalign() failed allocating "SUF" bytes.\n", size);
+	    terminate(dip, FAILURE);
+	}
+# if defined(MADV_HUGEPAGE)
+	if (huge) {
+	    (void)madvise(addr, size, MADV_HUGEPAGE);
+	}
+# endif /* defined(MADV_HUGEPAGE) */
+#endif /* defined(WIN32) */
+    }
+    ((mpa_hdr_t *)addr)->mh_size = size;
+    ((mpa_hdr_t *)addr)->mh_flags = flags;
+    return( (mpa_hdr_t *)addr );
+}
+
+static void
+mpa_free_pages(dinfo_t *dip, mpa_hdr_t *hdr)
+{
+    if (mDebugFlag) {
+	Printf(dip, "  -> Freeing buffer at address "LLPXFMT", size "SUF" bytes...\n",
+	       hdr, hdr->mh_size);
+    }
+    hdr->mh_magic = 0;
+#if defined(MAP_HUGETLB)
+    if (hdr->mh_flags & MPA_MAPPED) {
+	(void)munmap(hdr, hdr->mh_size);
+	return;
+    }
+#endif /* defined(MAP_HUGETLB) */
+#if defined(WIN32)
+    _aligned_free(hdr);
+#else /* !defined(WIN32) */
+    free(hdr);
+#endif /* defined(WIN32) */
+    return;
+}
 
 /*
  * This is a local allocation routine to alloc and return to the caller a
- * system page aligned buffer.  Enough space will be added, one more page, to
- * allow the pointers to be adjusted to the next page boundry.  A local linked
- * list will keep copies of the original and adjusted addresses.  This list 
- * will be used by free_palign() to free the correct buffer.
+ * system page aligned buffer. The buffer is taken from this threads' pool
+ * when a buffer of the same size class is cached, otherwise one more page
+ * is allocated to hold the pool header and the requested offset.
  *
  * Inputs:
  * 	bytes = The number of bytes to allocate.
@@ -171,86 +392,59 @@ static MPA_WS mpa_qhead;	/* local Q head for the malloc stuctures */
 void *
 malloc_palign(dinfo_t *dip, size_t bytes, int offset)
 {
-    int error;
-    MPA_WS *ws;		/* pointer for the working set */
-#if defined(NEED_PAGESIZE)
-    int page_size;	/* for holding the system's page size */
-#endif /* defined(NEED_PAGESIZE) */
+    mpa_cache_t *mcp = NULL;
+    mpa_hdr_t *hdr = NULL;
+    mpa_tag_t tag;
+    size_t class_pages;
+    uint16_t class;
+    void *pa_addr;
 
     if (bytes == (size_t)0) {
         LogMsg(dip, efp, logLevelDiag, 0,
                "malloc_palign: FIXME -> Trying to allocate %u bytes.\n", bytes);
 	return(NULL);
     }
-    if ( malloc_mutex_inited == False ) {
-	error = pthread_mutex_init(&malloc_mutex, NULL);
-	if ( error ) {
-	    tPerror(dip, error, "pthread_mutex_init() failed!");
+    class = mpa_size_class(howmany((bytes + offset), page_size), &class_pages);
+    if (class != MPA_NOCLASS) {
+	mcp = mpa_get_cache(dip);
+	if ( (hdr = mcp->mc_free[class]) ) {
+	    mcp->mc_free[class] = hdr->mh_next;
+	    mcp->mc_count[class]--;
+	    mcp->mc_bytes -= hdr->mh_size;
 	}
-	malloc_mutex_inited = True;
-    }
-    /*
-     * The space for the working set structure that will go on the queue
-     * is allocated first.
-     */
-    ws = (MPA_WS *)Malloc(dip, sizeof(MPA_WS) );
-    if ( ws == (MPA_WS *)NULL ) {
-	return( NULL );
-    }
-
-#if defined(NEED_PAGESIZE)
-    page_size = getpagesize();
-#endif /* defined(NEED_PAGESIZE) */
-
-    ws->malloc_size = (bytes + page_size + offset);
-    /*
-     * Using the requested size, from the argument list, and the page size
-     * from the system allocate enough space to page align the requested 
-     * buffer.  The original request will have the space of one system page
-     * added to it.  The pointer will be adjusted.
-     */
-    ws->malloc_addr = Malloc(dip, ws->malloc_size);
-    if ( ws->malloc_addr == NULL ) {
-	Free(dip, ws);
-	return( NULL );
-    } else {
-	; // Malloc() does this: (void)memset(ws->malloc_addr, 0, ws->malloc_size);
     }
-
-    error = pthread_mutex_lock(&malloc_mutex);
-    if ( error ) {
-	tPerror(dip, error, "pthread_mutex_lock() failed!");
-	return (NULL);
+    if (hdr == NULL) {
+	hdr = mpa_alloc_pages(dip, (page_size + (class_pages * page_size)));
+	if (hdr == NULL) return(NULL);
+	hdr->mh_magic = MPA_MAGIC;
+	hdr->mh_class = class;
     }
-    /*
-     * Now align the allocated address to a page alignment and offset.
-     */
-    ws->palign_addr = (void *)( ((ptr_t)ws->malloc_addr + page_size) & ~(page_size-1) );
-    ws->palign_addr = (void *)((ptr_t)ws->palign_addr + offset);
+    hdr->mh_next = NULL;
 
     /*
-     * Put the working set onto the linked list so that the original malloc-ed
-     * buffer can be freeed when the user program is done with it.
+     * Align the buffer after the header page, then tag it so free_palign()
+     * can locate the header. The tag is copied, since offset may misalign it.
      */
-    ws->next = mpa_qhead.next;	    /* just put it at the head */
-    mpa_qhead.next = ws;
-
-    error = pthread_mutex_unlock(&malloc_mutex);
-    if ( error ) {
-	tPerror(dip, error, "pthread_mutex_unlock() failed!");
+    pa_addr = (void *)((ptr_t)hdr + page_size + offset);
+    tag.mt_hdr = hdr;
+    tag.mt_magic = MPA_MAGIC;
+    (void)memcpy(((uint8_t *)pa_addr - sizeof(tag)), &tag, sizeof(tag));
+    if (bytes <= (size_t)page_size) {
+	(void)memset(pa_addr, '\0', bytes);
     }
 
     if (mDebugFlag) {
 	Printf(dip, "malloc_palign: Aligned buffer at address "LLPXFMT" of %u bytes...\n",
-	       ws->palign_addr, (bytes + offset));
+	       pa_addr, (bytes + offset));
     }
-    return( ws->palign_addr );
+    return(pa_addr);
 }
 
 /*
- * This is a local free routine to return to the system a previously alloc-ed
- * buffer.  A local linked list keeps copies of the original and adjusted
- * addresses.  This list is used by this routine to free the correct buffer.
+ * This is a local free routine to return a previously alloc-ed buffer.
+ * The tag before the buffer locates its header, then the buffer is cached
+ * by this thread for reuse, or returned to the system when the cache for
+ * its size class is full.
  *
  * Inputs:
  *	pa_addr = The page aligned buffer to free.
@@ -261,54 +455,62 @@ malloc_palign(dinfo_t *dip, size_t bytes, int offset)
 void
 free_palign(dinfo_t *dip, void *pa_addr)
 {
-    int error;
-    MPA_WS *ws, *wsq;
+    mpa_cache_t *mcp;
+    mpa_hdr_t *hdr = NULL;
+    mpa_tag_t tag;
 
     if (mDebugFlag) {
 	Printf(dip, "free_palign: Freeing aligned buffer at address "LLPXFMT"...\n", pa_addr);
     }
-    error = pthread_mutex_lock(&malloc_mutex);
-    if (error) {
-	tPerror(dip, error, "pthread_mutex_lock() failed!");
-	/* race noted... */
-    }
-    /*
-     * Walk along the malloc-ed memory linked list, watch for a match on
-     * the page aligned address.
-     */
-    ws = mpa_qhead.next;
-    wsq = NULL;
-
-    while ( ws ) {
-	if ( ws->palign_addr == pa_addr ) {
-	    break;
+    if (pa_addr) {
+	(void)memcpy(&tag, ((uint8_t *)pa_addr - sizeof(tag)), sizeof(tag));
+	if ( (tag.mt_magic == MPA_MAGIC) && tag.mt_hdr && (tag.mt_hdr->mh_magic == MPA_MAGIC) ) {
+	    hdr = tag.mt_hdr;
 	}
-	wsq = ws;
-	ws = ws->next;
     }
-
-    /*
-     * After falling out of the loop the pointers are at the place where
-     * some work has to be done, (this could also be at the beginning).
-     */
-    if ( ws ) {
-	if ( wsq == NULL ) {
-	    mpa_qhead.next = ws->next;
-	} else {
-	    wsq->next = ws->next;
-	}
-	if (mDebugFlag) {
-	    Printf(dip, "  -> Freeing buffer at address "LLPXFMT", size "SUF" bytes...\n",
-		   ws->malloc_addr, ws->malloc_size);
-	}
-	FreeMem(dip, ws->malloc_addr, ws->malloc_size);
-	FreeMem(dip, ws, sizeof(*ws));
-    } else {
+    if (hdr == NULL) {
         Eprintf(dip, "free_palign: BUG: Did not find buffer at address "LLPXFMT"...\n", pa_addr);
+	return;
     }
-    error = pthread_mutex_unlock(&malloc_mutex);
-    if ( error ) {
-	tPerror(dip, error, "pthread_mutex_unlock() failed!");
+    /* Clear the tag to catch freeing this buffer twice. */
+    tag.mt_magic = 0;
+    (void)memcpy(((uint8_t *)pa_addr - sizeof(tag)), &tag, sizeof(tag));
+
+    if (hdr->mh_class != MPA_NOCLASS) {
+	mcp = mpa_get_cache(dip);
+	if ( (mcp->mc_count[hdr->mh_class] < MPA_CLASS_CACHED) &&
+	     ((mcp->mc_bytes + hdr->mh_size) <= MPA_CACHE_MAX) ) {
+	    hdr->mh_next = mcp->mc_free[hdr->mh_class];
+	    mcp->mc_free[hdr->mh_class] = hdr;
+	    mcp->mc_count[hdr->mh_class]++;
+	    mcp->mc_bytes += hdr->mh_size;
+	    return;
+	}
     }
+    mpa_free_pages(dip, hdr);
+    return;
+}
+
+/*
+ * free_palign_cache() - Release this threads' cached aligned buffers.
+ *
+ * Description:
+ *	Called when threads exit, since Windows has no thread specific
+ * data destructor to do this for us.
+ */
+void
+free_palign_cache(dinfo_t *dip)
+{
+#if defined(WIN32)
+    mpa_cache_t *mcp = mpa_thread_cache;
+    mpa_thread_cache = NULL;
+#else /* !defined(WIN32) */
+    mpa_cache_t *mcp;
+
+    (void)pthread_once(&mpa_cache_once, mpa_cache_init);
+    mcp = pthread_getspecific(mpa_cache_key);
+    (void)pthread_setspecific(mpa_cache_key, NULL);
+#endif /* defined(WIN32) */
+    mpa_release_cache(dip, mcp);
     return;
 }
@@ -32,6 +32,10 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Add asynchronous thread logging (enable=asynclog), where messages are
+ * queued to a per-thread ring and written by a background writer thread.
+ * 
  * November 30th, 2020 by Robin T. Miller
  *      When reporting records, add Physical/Relative for file system LBAs.
  * 
@@ -72,6 +76,9 @@
 #include <ctype.h>
 #include <string.h>
 #include <stdarg.h>
+#if !defined(WIN32)
+#  include <sys/uio.h>
+#endif /* !defined(WIN32) */
 
 /*
  * Local Definitions:
@@ -885,6 +892,252 @@ ReleasePrintLock(dinfo_t *dip)
     return(status);
 }
 
+/* ========================================================================= */
+
+/*
+ * Asynchronous Log Ring Support:
+ *
+ * Each thread log gets a ring, where the owning thread copies formatted
+ * messages without taking any locks. One background writer thread drains
+ * all rings periodically, writing each rings' messages with a single
+ * writev(), so the I/O threads don't write (and flush) every message.
+ * Errors and a full ring are drained synchronously by the owning thread.
+ */
+static log_ring_t *log_ring_list = NULL; /* The rings being drained.	*/
+static hbool_t log_ring_writer_active = False;
+static pthread_t LogRingThread;		/* The log ring writer thread.	*/
+
+/*
+ * log_ring_write() - Write the ring segments to the log file.
+ *
+ * Note: We cannot log errors here, since we're called while logging!
+ */
+static void
+log_ring_write(log_ring_t *lrp, char *seg1, size_t len1, char *seg2, size_t len2)
+{
+#if defined(WIN32)
+    if (len1) (void)fwrite(seg1, 1, len1, lrp->lr_fp);
+    if (len2) (void)fwrite(seg2, 1, len2, lrp->lr_fp);
+    (void)fflush(lrp->lr_fp);
+#else /* !defined(WIN32) */
+    struct iovec iov[2];
+    int iovcnt = 0;
+    int fd = fileno(lrp->lr_fp);
+    ssize_t count;
+
+    if (len1) {
+	iov[iovcnt].iov_base = seg1;
+	iov[iovcnt++].iov_len = len1;
+    }
+    if (len2) {
+	iov[iovcnt].iov_base = seg2;
+	iov[iovcnt++].iov_len = len2;
+    }
+    while (iovcnt) {
+	count = writev(fd, iov, iovcnt);
+	if (count < 0) {
+	    if (errno == EINTR) continue;
+	    break;
+	}
+	/* Handle partial writes. */
+	while ( iovcnt && ((size_t)count >= iov[0].iov_len) ) {
+	    count -= iov[0].iov_len;
+	    iov[0] = iov[1];
+	    iovcnt--;
+	}
+	if (iovcnt) {
+	    iov[0].iov_base = (char *)iov[0].iov_base + count;
+	    iov[0].iov_len -= count;
+	}
+    }
+#endif /* defined(WIN32) */
+    return;
+}
+
+/*
+ * log_ring_drain() - Write all messages queued to a ring.
+ *
+ * Description:
+ *	Called by the writer thread, and by the owning thread on errors,
+ * when the ring is full, and when closing the log file.
+ */
+static void
+log_ring_drain(log_ring_t *lrp)
+{
+    uint64_t head, tail;
+    size_t index, length, len1;
+
+    (void)pthread_mutex_lock(&lrp->lr_lock);
+    tail = lrp->lr_tail;
+    head = os_atomic_load64(&lrp->lr_head);
+    if (head != tail) {
+	index = (size_t)(tail & (lrp->lr_size - 1));
+	length = (size_t)(head - tail);
+	len1 = min(length, (lrp->lr_size - index));
+	log_ring_write(lrp, (lrp->lr_buffer + index), len1, lrp->lr_buffer, (length - len1));
+	os_atomic_store64(&lrp->lr_tail, head);
+    }
+    (void)pthread_mutex_unlock(&lrp->lr_lock);
+    return;
+}
+
+/*
+ * log_ring_put() - Add a message to a ring.
+ *
+ * Inputs:
+ *	lrp = The log ring pointer.
+ *	buffer = The message to add.
+ *	flush = Drain the ring after adding this message.
+ */
+static void
+log_ring_put(log_ring_t *lrp, char *buffer, hbool_t flush)
+{
+    size_t length = strlen(buffer);
+    size_t index, len1;
+    uint64_t head = lrp->lr_head;	/* Only we update the head. */
+
+    if ( (lrp->lr_size - (size_t)(head - os_atomic_load64(&lrp->lr_tail))) < length ) {
+	log_ring_drain(lrp);
+	/* Messages larger than the ring are written directly. */
+	if (length > lrp->lr_size) {
+	    (void)pthread_mutex_lock(&lrp->lr_lock);
+	    log_ring_write(lrp, buffer, length, NULL, 0);
+	    (void)pthread_mutex_unlock(&lrp->lr_lock);
+	    return;
+	}
+    }
+    index = (size_t)(head & (lrp->lr_size - 1));
+    len1 = min(length, (lrp->lr_size - index));
+    (void)memcpy((lrp->lr_buffer + index), buffer, len1);
+    if (len1 < length) {
+	(void)memcpy(lrp->lr_buffer, (buffer + len1), (length - len1));
+    }
+    os_atomic_store64(&lrp->lr_head, (head + length));
+    if (flush == True) {
+	log_ring_drain(lrp);
+    }
+    return;
+}
+
+/*
+ * log_ring_writer() - The background thread draining all log rings.
+ */
+static void *
+log_ring_writer(void *arg)
+{
+    log_ring_t *lrp;
+
+    for (;;) {
+	os_msleep(LOG_RING_INTERVAL);
+	(void)pthread_mutex_lock(&log_ring_lock);
+	for (lrp = log_ring_list; lrp; lrp = lrp->lr_next) {
+	    log_ring_drain(lrp);
+	}
+	(void)pthread_mutex_unlock(&log_ring_lock);
+    }
+    /*NOTREACHED*/
+    return(NULL);
+}
+
+/*
+ * log_ring_create() - Create the ring for this threads' log file.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE if the writer thread was not created,
+ * in which case messages are written synchronously, as before.
+ */
+int
+log_ring_create(dinfo_t *dip)
+{
+    log_ring_t *lrp;
+    int status = SUCCESS;
+
+    (void)pthread_mutex_lock(&log_ring_lock);
+    if (log_ring_writer_active == False) {
+	status = pthread_create(&LogRingThread, tjattrp, log_ring_writer, NULL);
+	if (status == SUCCESS) {
+	    log_ring_writer_active = True;
+	    status = pthread_detach(LogRingThread);
+	    if (status != SUCCESS) {
+		tPerror(dip, status, "pthread_detach() failed");
+		status = SUCCESS;
+	    }
+	}
+    }
+    (void)pthread_mutex_unlock(&log_ring_lock);
+    if (status != SUCCESS) {
+	tPerror(dip, status, "pthread_create() failed for the log writer");
+	return(FAILURE);
+    }
+    lrp = Malloc(dip, sizeof(*lrp));
+    lrp->lr_buffer = Malloc(dip, LOG_RING_SIZE);
+    lrp->lr_size = LOG_RING_SIZE;
+    lrp->lr_fp = dip->di_efp;
+    (void)pthread_mutex_init(&lrp->lr_lock, NULL);
+    (void)fflush(lrp->lr_fp);		/* Flush the log header. */
+
+    (void)pthread_mutex_lock(&log_ring_lock);
+    lrp->lr_next = log_ring_list;
+    log_ring_list = lrp;
+    (void)pthread_mutex_unlock(&log_ring_lock);
+
+    dip->di_log_ring = lrp;
+    if (dip->di_output_dinfo) {
+	dip->di_output_dinfo->di_log_ring = lrp;
+    }
+    return(status);
+}
+
+/*
+ * log_ring_close() - Drain and free this threads' log ring.
+ *
+ * Note: Must be called before the thread log file is closed.
+ */
+void
+log_ring_close(dinfo_t *dip)
+{
+    log_ring_t *lrp = dip->di_log_ring, **lrpp;
+
+    if (lrp == NULL) return;
+    (void)pthread_mutex_lock(&log_ring_lock);
+    for (lrpp = &log_ring_list; *lrpp; lrpp = &(*lrpp)->lr_next) {
+	if (*lrpp == lrp) {
+	    *lrpp = lrp->lr_next;
+	    break;
+	}
+    }
+    (void)pthread_mutex_unlock(&log_ring_lock);
+    dip->di_log_ring = NULL;
+    if (dip->di_output_dinfo && (dip->di_output_dinfo->di_log_ring == lrp)) {
+	dip->di_output_dinfo->di_log_ring = NULL;
+    }
+    log_ring_drain(lrp);
+    (void)pthread_mutex_destroy(&lrp->lr_lock);
+    Free(dip, lrp->lr_buffer);
+    Free(dip, lrp);
+    return;
+}
+
+/*
+ * log_ring_flush_all() - Drain all log rings (program exiting).
+ */
+void
+log_ring_flush_all(void)
+{
+    log_ring_t *lrp;
+
+    if (log_ring_writer_active == False) return;
+    (void)pthread_mutex_lock(&log_ring_lock);
+    for (lrp = log_ring_list; lrp; lrp = lrp->lr_next) {
+	log_ring_drain(lrp);
+    }
+    (void)pthread_mutex_unlock(&log_ring_lock);
+    return;
+}
+
 /*
  * Note: This is the common function used to print all messages!
  */
@@ -892,7 +1145,8 @@ int
 PrintLogs(dinfo_t *dip, logLevel_t level, int flags, FILE *fp, char *buffer)
 {
     hbool_t job_log_flag;
-    int status;
+    hbool_t error_level = ((level == logLevelCrit) || (level == logLevelError));
+    int status = SUCCESS;
 
     job_log_flag = (dip->di_job && dip->di_job->ji_job_logfp);
     /*
@@ -905,7 +1159,13 @@ PrintLogs(dinfo_t *dip, logLevel_t level, int flags, FILE *fp, char *buffer)
      *  o if master log is open, also write to this.
      *  o finally, write to the server (if no job/thread log)
      */
-    if ( dip->di_log_opened && job_log_flag) {		/* job & thread logs */
+    if ( dip->di_log_ring && (fp == dip->di_log_ring->lr_fp) ) {
+	log_ring_put(dip->di_log_ring, buffer, error_level);	/* thread log */
+        if ( job_log_flag && (dip->di_joblog_inhibit == False) ) {
+            status = Fputs(buffer, dip->di_job->ji_job_logfp);
+	    (void)fflush(dip->di_job->ji_job_logfp);
+        }
+    } else if ( dip->di_log_opened && job_log_flag) {	/* job & thread logs */
         status = Fputs(buffer, fp);
         if (dip->di_joblog_inhibit == False) {
             status = Fputs(buffer, dip->di_job->ji_job_logfp);
@@ -918,7 +1178,7 @@ PrintLogs(dinfo_t *dip, logLevel_t level, int flags, FILE *fp, char *buffer)
         status = Fputs(buffer, fp);
 	(void)fflush(fp);
     }
-    if ( error_log && ((level == logLevelCrit) || (level == logLevelError)) ) {
+    if ( error_log && error_level ) {
 	/* Create the file in append mode, leaving it open thereafter! */
 	if (error_logfp == NULL) {
 	    status = OpenOutputFile(dip, &error_logfp, error_log, "a", DisableErrors);
@@ -28,10 +28,14 @@
  * Date:	August 7, 1993
  *
  * Description:
- *	Functions to handle multiple processes for 'dt' program.
+ *	Functions to setup slices for 'dt' program.
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Remove the multiple process (fork) engine, which was no longer used.
+ * Slices run as job threads, and only need their slice ranges setup here.
+ * 
  * September 5th, 2020 by Robin T. Miller
  *      When initializing a slice, ensure the min/max limit sizes do NOT
  * exceed the data/slice limits. Otherwise, overwrites occur and thus cause
@@ -54,773 +58,29 @@
  * 	Mostly a rewrite for multithreaded IO, so starting with new history!
  */
 #include "dt.h"
-#if !defined(WIN32)
-#  include <signal.h>
-#  include <strings.h>
-#  include <sys/stat.h>
-#  include <sys/wait.h>
-#endif /* !defined(WIN32) */
-
-#define PROC_ALLOC (sizeof(pid_t) * 3)	/* Extra allocation for PID.	*/
 
 /*
  * Forward References:
  */
 static int init_slice_info(struct dinfo *dip, slice_info_t *sip, large_t *data_resid);
 static void setup_slice(struct dinfo *dip, slice_info_t *sip);
-static void setup_iotuning(dinfo_t *dip, char *cmd);
-static void setup_multiprocs(dinfo_t *dip, char *cmd);
-static void update_cmd_line(dinfo_t *dip);
-
-#if defined(WIN32)
-
-#define HANDLE_MASK (MAXIMUM_WAIT_OBJECTS - 1)
-
-PROCESS_INFORMATION *start_process(dinfo_t *dip, char *cmd);
 
 /*
- * abort_procs - Abort processes started by the parent.
- */
-void
-abort_procs(dinfo_t *dip)
-{
-    int proc_num;
-    struct dt_procs *dtp;
-    PROCESS_INFORMATION *pip;
-
-    if ((dip->di_ptable == NULL) || dip->di_aborted_processes) return;
-    /*
-     * Terminate all active processes.
-     */
-    for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-        pip = dtp->dt_pip;
-	if ( !dtp->dt_active ) continue; /* Already reaped status! */
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Terminating child process %d...\n", pip->dwProcessId);
-	}
-
-	/*
-	 * I'd rather send a signal like Unix, to have child report
-	 * statistics, but Windows does not support a kill() API!
-	 */
-	if (TerminateProcess(pip->hProcess, ERROR_PROCESS_ABORTED) == 0) {
-	    DWORD error = GetLastError();
-	    /*
-	     * Child thread may be terminating due to signal.
-	     */
-	    if (error != ERROR_ACCESS_DENIED) {
-		Fprintf(dip, "Failed to terminate child process %d...\n", pip->dwProcessId);
-		ReportErrorInfo(dip, NULL, error, "TerminateProcess() failed", OTHER_OP, True);
-	   }
-	}
-    }
-    dip->di_aborted_processes = True;
-    return;
-}
-
-void
-await_procs(dinfo_t *dip)
-{
-    DWORD status;
-    struct dt_procs *dtp;
-    int proc_num = 0, wait_index;
-    PROCESS_INFORMATION *pip;
-    bool aborted_procs = False;
-    DWORD timeoutMs = INFINITE;
-
-    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	timeoutMs = (60 * 1000); /* For debug! */
-	Printf(dip, "Waiting for %d child processes to complete...\n", dip->di_procs_active);
-    }
-    /*
-     * For dt's oncerror option, we must wait on one process at a time,
-     * so we can abort procs if instructed to on child errors.
-     */
-    while (dip->di_procs_active) {
-	/*
-	 * Wait for all processes to complete.
-	 */
-	status = WaitForMultipleObjects((DWORD)dip->di_procs_active, // Number of handles.
-					dip->di_proc_handles,// Array of handles.
-					False,		     // Wait for any object.
-					timeoutMs);          // Timeout in ms (disable).
-
-	if (status == WAIT_FAILED) {
-	    ReportErrorInfo(dip, NULL, os_get_error(), "WaitForMultipleObjects() failed", OTHER_OP, False);
-	    abort_procs(dip);
-	    break;
-	}
-	if (status == WAIT_TIMEOUT) {
-	    Printf(dip, "Still waiting on %d processes...\n", dip->di_procs_active);
-	    Printf(dip, "Active PIDs:");
-	    for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-		pip = dtp->dt_pip;
-		if (dtp->dt_active) {
-		    Print(dip, " %d", pip->dwProcessId);
-		}
-	    }
-	    Print(dip, "\n");
-	    fflush(ofp);
-	    continue;
-	}
-	if ((status & ~HANDLE_MASK) != WAIT_OBJECT_0) {
-	    Fprintf(dip, "WaitForMultipleObjects returned status %#x\n", status);
-	    dip->di_child_status = GetLastError();
-	    abort_procs(dip);
-	    return;
-	}
-	wait_index = (status & HANDLE_MASK); /* Handle index - 1 */
-	/*
-	 * Find the process by searching for its' handle.
-	 */
-	for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-	    pip = dtp->dt_pip;
-	    if (pip->hProcess == dip->di_proc_handles[wait_index]) {
-		break;
-	    }
-	}
-	if ( !GetExitCodeProcess( pip->hProcess, &dip->di_child_status ) ) {
-	    Fprintf(dip, "GetExitCodeProcess failed (%d)\n", GetLastError() );
-	    dip->di_child_status = GetLastError();
-	}
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Child process %d, exited with status %d\n",
-		    pip->dwProcessId, dip->di_child_status);
-	}
-	dtp->dt_active = False;
-	dtp->dt_status = dip->di_child_status;
-        /*
-	 * Close process and thread handles.
-	 */
-	CloseHandle( pip->hProcess );
-	CloseHandle( pip->hThread );
-	/*
-	 * Remove the completed handle from the array to wait upon.
-	 */
-	for (; (wait_index < dip->di_procs_active); wait_index++) {
-	    dip->di_proc_handles[wait_index] = dip->di_proc_handles[wait_index + 1];
-	}
-
-	if ( (exit_status == SUCCESS) && (dip->di_child_status != SUCCESS) ) {
-	    if ( (dip->di_oncerr_action == ONERR_ABORT) &&
-		 (dip->di_child_status != WARNING) && (dip->di_child_status != END_OF_FILE) ) {
-		if (!aborted_procs) {
-		    abort_procs(dip);		/* Abort procs on error. */
-		    aborted_procs = True;
-		}
-	    }
-	    /*
-	    * Save the most sever error for parent exit status.
-	    *
-	    * Severity Priorities:
-	    *			WARNING		(lowest)
-	    *			END_OF_FILE
-	    *			Signal Number
-	    *			FATAL_ERROR	(highest)
-	    */
-	    if ( ((exit_status == SUCCESS) || (dip->di_child_status == FATAL_ERROR)) ||
-		 ((exit_status == WARNING) && (dip->di_child_status > WARNING))      ||
-		 ((exit_status == END_OF_FILE) && (dip->di_child_status > WARNING)) ) {
-		    exit_status = dip->di_child_status;	/* Set error code for exit. */
-	    }
-	}
-	dip->di_procs_active--;
-    } 
-    return;
-}
-
-/*
- * start_process() - Start a Process.
+ * init_slice() - Initialize a Slice for a Job Thread.
+ *
+ * Description:
+ *	Slices run as job threads (slices become threads), so each thread
+ * restricts its clone of the device to its own slice range. The pattern
+ * buffers, logging, and statistics are shared with or gathered by the job,
+ * rather than being setup again in a child process per slice.
  *
  * Inputs:
  *	dip = The device information pointer.
- *	cmd = The command line to execute.
+ *	slice = The slice number (1 to slices).
  *
  * Return Value:
- *	Returns pointer to process information or NULL on failure.
- */
-PROCESS_INFORMATION *
-start_process(dinfo_t *dip, char *cmd)
-{
-    STARTUPINFO si;
-    PROCESS_INFORMATION *pip;
-
-    ZeroMemory( &si, sizeof(si) );
-    si.cb = sizeof(si);
-    pip = (PROCESS_INFORMATION *)Malloc(dip, sizeof(*pip));
-    if (pip == NULL) return(pip);
-    ZeroMemory( pip, sizeof(*pip) );
-
-    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Command: %s\n", cmd);
-    }
-
-    /* Start the child process. */
-    if ( !CreateProcess( NULL,	     // No module name (use command line)
-		         cmd,        // Command line
-		         NULL,       // Process handle not inheritable
-		         NULL,       // Thread handle not inheritable
-		         False,      // Handle inheritance flag
-		         0,          // No creation flags
-		         NULL,       // Use parent's environment block
-		         NULL,       // Use parent's starting directory 
-		         &si,        // Pointer to STARTUPINFO structure
-			 pip ) )     // Pointer to PROCESS_INFORMATION structure
-    {
-        ReportErrorInfo(dip, NULL, os_get_error(), "CreateProcess failed", OTHER_OP, True);
-        Free(dip, pip);
-        return(NULL);
-    }
-    return(pip);
-}
-
-static void
-setup_iotuning(dinfo_t *dip, char *cmd)
-{
-    if (dip->di_iotuning_flag && dip->di_iotune_file ) {
-	//(void)strcat(cmd, " disable=iotuning");
-	;
-    }
-    return;
-}
-
-static void
-setup_multiprocs(dinfo_t *dip, char *cmd)
-{
-    return;
-}
-
-pid_t
-start_devs(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    size_t psize;
-    PROCESS_INFORMATION *pip;
-    char *devs, *token, *p;
-    int proc_num = 0;
-    char *dt_path, *dt_cmd;
-    char *our_cmd, *bp, *saveptr;
-
-    devs = p = (dip->di_input_file) ? dip->di_input_file : dip->di_output_file;
-    dip->di_num_devs = 1;
-    /* Count the devices specified. */
-    while (p = strchr(p, ',')) {
-	dip->di_num_devs++; p++;
-    }
-    dip->di_max_procs = dip->di_num_devs;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo(dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    ZeroMemory(dip->di_ptable, psize);
-    our_cmd = (char *)Malloc(dip, LOG_BUFSIZE);
-    /* Setup pointers to dt path and dt command line. */
-    dt_path = dip->di_dtcmd;
-    p = strchr(dt_path, ' ');
-    if (!p) {
-	Fprintf(dip, "We're broken setting up dt's path!\n");
-	abort();
-    }
-    *p = '\0';
-    dt_cmd = ++p;
-
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-
-    /* Remember: strtok() replaces "," with NULL! */
-    token = strtok_r(devs, ",", &saveptr);
-    /*
-     * Start a process for each target device specified.
-     */
-    for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-	dtp->dt_device = token;
-	bp = our_cmd;
-	/* Note: Main stripped the device options already. */
-	bp += Sprintf(bp, "%s ", dt_path);
-	/* More work, but I like the device first on the command line! */
-	if (dip->di_input_file) {
-	    bp += Sprintf(bp, "if=%s", token);
-	} else {
-	    bp += Sprintf(bp, "of=%s", token);
-	}
-	/* Now, add original options. */
-	bp += Sprintf(bp, " %s enable=child", dt_cmd);
-	setup_iotuning(dip, bp);
-	pip = start_process(dip, our_cmd);
-	if (pip == NULL) return (-1);
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Started process %d for %s...\n", pip->dwProcessId, dtp->dt_device);
-	}
-	dip->di_proc_handles[proc_num] = pip->hProcess;
-	dip->di_cur_proc++;
-	dtp->dt_pid = dip->di_child_pid = pip->dwProcessId;
-	dtp->dt_active = True;
-	dtp->dt_pip = pip;
-	dip->di_procs_active++;
-	token = strtok_r(NULL, ",", &saveptr);	/* Next device please! */
-    }
-    Free(dip, our_cmd);
-    return (dip->di_child_pid);
-}
-
-pid_t
-start_procs(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    size_t psize;
-    PROCESS_INFORMATION *pip;
-    int proc_num = 0;
-
-    dip->di_max_procs = dip->di_num_procs;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo (dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    ZeroMemory(dip->di_ptable, psize);
-
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-    (void)strcat(dip->di_dtcmd, " enable=child");
-    setup_iotuning(dip, dip->di_dtcmd);
-    setup_multiprocs(dip, dip->di_dtcmd);
-
-    /*
-     * Spawn specified number of processes.
-     */
-    for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-	pip = start_process(dip, dip->di_dtcmd);
-	if (pip == NULL) return (-1);
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Started process %d...\n", pip->dwProcessId);
-	}
-	dip->di_proc_handles[proc_num] = pip->hProcess;
-	dip->di_cur_proc++;
-	dtp->dt_pid = dip->di_child_pid = pip->dwProcessId;
-	dtp->dt_active = True;
-	dtp->dt_pip = pip;
-	dip->di_procs_active++;
-    }
-    return (dip->di_child_pid);
-}
-
-pid_t
-start_slices(dinfo_t *dip)
-{
-    struct slice_info slice_info;
-    slice_info_t *sip = &slice_info;
-    struct dt_procs *dtp;
-    size_t psize;
-    PROCESS_INFORMATION *pip;
-    int proc_num = 0;
-    large_t data_resid;
-    char *cmd = Malloc(dip, LOG_BUFSIZE);
-
-    dip->di_max_procs = dip->di_slices;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo (dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    memset(dip->di_ptable, '\0', psize);
-
-    init_slice_info(dip, sip, &data_resid);
-
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-
-    /*
-     * Spawn specified number of processes.
-     */
-    for (dtp = dip->di_ptable, proc_num = 0; proc_num < dip->di_max_procs; proc_num++, dtp++) {
-	sip->slice++;
-	/* Last slice gets any residual bytes. */
-	if ((proc_num + 1) == dip->di_max_procs) {
-	    sip->slice_length += data_resid;
-	}
-	(void)sprintf(cmd, "%s enable=logpid slice=%d", dip->di_dtcmd, sip->slice);
-	setup_iotuning(dip, cmd);
-	setup_multiprocs(dip, cmd);
-	pip = start_process(dip, cmd);
-	if (pip == NULL) return (-1);
-	dip->di_proc_handles[proc_num] = pip->hProcess;
-	dip->di_cur_proc++;
-	dtp->dt_pid = dip->di_child_pid = pip->dwProcessId;
-	dtp->dt_active = True;
-	dtp->dt_pip = pip;
-	dip->di_procs_active++;
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf (dip, "Started Slice %d, PID %d...\n", sip->slice, dip->di_child_pid);
-	}
-	if (proc_num < dip->di_max_procs) {
-	    sip->slice_position += sip->slice_length;
-	}
-    }
-    return (dip->di_child_pid);
-}
-
-
-#else /* !defined(WIN32) */
-
-/*
- * abort_procs - Abort processes started by the parent.
+ *	Returns SUCCESS / FAILURE (slice too small).
  */
-void
-abort_procs(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    int procs;
-    pid_t pid;
-
-    if ((dip->di_ptable == NULL) || dip->di_aborted_processes)  return;
-    /*
-     * Force all processes to terminate.
-     */
-    for (dtp = dip->di_ptable, procs=0; procs < dip->di_max_procs; procs++, dtp++) {
-	if ((pid = dtp->dt_pid) == (pid_t) 0) continue;
-	if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	    Printf(dip, "Aborting child process %d via a SIGINT (signal %d)...\n",
-								pid, SIGINT);
-	}
-	if (dtp->dt_active) {
-	    int status = kill (pid, SIGINT);
-    	    if ( (dip->di_debug_flag || dip->di_pDebugFlag) && (status == FAILURE) ) {
-		Perror(dip, "DEBUG: Failed to kill PID %d", pid);
-	    }
-	}
-    }
-    dip->di_aborted_processes = True;
-    return;
-}
-
-void
-await_procs(dinfo_t *dip)
-{
-    pid_t wpid;
-    struct dt_procs *dtp;
-    int procs, status;
-
-    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	Printf (dip, "Waiting for %d child processes to complete...\n", dip->di_procs_active);
-    }
-    while (1) {
-	if ((wpid = waitpid ((pid_t) -1, &dip->di_child_status, 0)) == FAILURE) {
-	    if (errno == ECHILD) {
-		if (dip->di_procs_active && dip->di_pDebugFlag) {
-		    Printf(dip, "Processes still active (%d) and ECHILD received!\n",
-			   dip->di_procs_active);
-		}
-		break;				/* No more children... */
-	    } else if (errno == EINTR) {
-		/* Note: Expect signal handler to abort children! */
-		//abort_procs(dip);
-		continue;
-	    } else {
-		ReportErrorInfo (dip, NULL, os_get_error(), "waitpid", OTHER_OP, False);
-		exit (FATAL_ERROR);
-	    }
-	}
-	/*
-	 * Examine the child process status.
-	 */
-	if ( WIFSTOPPED(dip->di_child_status) ) {
-	    Printf (dip, "Child process %d, stopped by signal %d.\n",
-					wpid, WSTOPSIG(dip->di_child_status));
-	    continue; /* Maybe attached from debugger... */
-	} else if ( WIFSIGNALED(dip->di_child_status) ) {
-	    status = WTERMSIG(dip->di_child_status);
-	    Fprintf (dip, "Child process %d, exiting because of signal %d\n",
-							wpid, status);
-	} else { /* Process must be exiting... */
-	    status = WEXITSTATUS (dip->di_child_status);
-	    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-		Printf (dip, "Child process %d, exited with status %d\n",
-							wpid, status);
-	    }
-	}
-
-	/*
-	 * Update this process' status.
-	 */
-	for (dtp = dip->di_ptable, procs = 0; procs < dip->di_max_procs; procs++, dtp++) {
-	    if (dtp->dt_pid == wpid) {
-		dtp->dt_active = False;
-		dtp->dt_status = status;
-		dip->di_procs_active--;
-		break;
-	    }
-	}
-
-	if ( (exit_status == SUCCESS) && (status != SUCCESS) ) {
-	    if ( (dip->di_oncerr_action == ONERR_ABORT) &&
-		 (status != WARNING) && (status != END_OF_FILE) ) {
-		abort_procs(dip);		/* Abort procs on error. */
-	    }
-	    /*
-	     * Save the most sever error for parent exit status.
-	     *
-	     * Severity Priorities:	WARNING		(lowest)
-	     *				END_OF_FILE
-	     *				Signal Number
-	     *				FATAL_ERROR	(highest)
-	     */
-	    if ( ((exit_status == SUCCESS) || (status == FATAL_ERROR)) ||
-		 ((exit_status == WARNING) && (status > WARNING))      ||
-		 ((exit_status == END_OF_FILE) && (status > WARNING)) ) {
-		exit_status = status;	/* Set error code for exit. */
-	    }
-	}
-    } /* End of while(1)... */
-}
-
-pid_t
-fork_process(dinfo_t *dip)
-{
-    pid_t pid;
-
-    if ((pid = fork()) == (pid_t) -1) {
-	if (errno == EAGAIN) {
-	    if (dip->di_procs_active == 0) {
-		LogMsg (dip, dip->di_efp, logLevelCrit, 0,
-			"could NOT start any processes, please check your system...\n");
-		exit (FATAL_ERROR);
-	    } else {
-		Printf (dip,
-	"Warning: System imposed process limit reached, only %d procs started...\n",
-								dip->di_procs_active);
-	    }
-	} else {
-	    ReportErrorInfo (dip, NULL, os_get_error(), "fork", OTHER_OP, False);
-	    abort_procs(dip);
-	}
-    }
-    return (pid);
-}
-
-static void
-update_cmd_line(dinfo_t *dip)
-{
-    char *device, *bp, *p;
-    char *dt_path, *options, *buffer;
-    
-    bp = buffer = (char *)Malloc(dip, LOG_BUFSIZE);
-    device = (dip->di_input_file) ? dip->di_input_file : dip->di_output_file;
-    /* Setup pointers to dt path and dt command line. */
-    dt_path = dip->di_dtcmd;
-    p = strchr(dt_path, ' ');
-    *p = '\0';
-    options = ++p;
-    /* Note: Main stripped the device options already. */
-    bp += Sprintf(bp, "%s ", dt_path);
-    if (dip->di_input_file) {
-	bp += Sprintf(bp, "if=%s", device);
-    } else {
-	bp += Sprintf(bp, "of=%s", device);
-    }
-    /* Now, add original options. */
-    bp += Sprintf(bp, " %s", options);
-    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-	Printf(dip, "Command: %s\n", buffer);
-    }
-    if (dip->di_cmd_line) Free(dip, dip->di_cmd_line);
-    dip->di_cmd_line = Malloc(dip, (strlen(buffer) + 1) );
-    strcpy(dip->di_cmd_line, buffer);
-    Free(dip, buffer);
-    return;
-}
-
-static void
-setup_iotuning(dinfo_t *dip, char *cmd)
-{
-    return;
-}
-
-static void
-setup_multiprocs(dinfo_t *dip, char *cmd)
-{
-    return;
-}
-
-pid_t
-start_devs(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    size_t psize;
-    char *devs, *token, *p, *saveptr;
-    int procs;
-
-    devs = p = (dip->di_input_file) ? dip->di_input_file : dip->di_output_file;
-    dip->di_num_devs = 1;
-    /* Count the devices specified. */
-    while (p = strchr(p, ',')) {
-	dip->di_num_devs++; p++;
-    }
-    dip->di_max_procs = dip->di_num_devs;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo(dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    memset(dip->di_ptable, 0, psize);
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-
-    /* Remember: strtok() replaces "," with NULL! */
-    token = strtok_r(devs, ",", &saveptr);
-    /*
-     * Start a process for each target device specified.
-     */
-    for (dtp = dip->di_ptable, procs = 0; procs < dip->di_max_procs; procs++, dtp++) {
-	dtp->dt_device = token;
-	if ((dip->di_child_pid = fork_process(dip)) == (pid_t) -1) {
-	    break;
-	} else if (dip->di_child_pid) {		/* Parent process gets the PID. */
-	    dip->di_cur_proc++;
-	    dtp->dt_pid = dip->di_child_pid;
-	    dtp->dt_active = True;
-	    dip->di_procs_active++;
-	    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-		Printf (dip, "Started Process %d for %s...\n", dip->di_child_pid, dtp->dt_device);
-	    }
-	    token = strtok_r(NULL, ",", &saveptr); /* Next device please! */
-	} else {			/* Child process... */
-	    dip->di_logpid_flag = True;
-	    dip->di_multiple_devs = False;
-	    if (dip->di_input_file) {
-		dip->di_input_file = dtp->dt_device;
-	    } else {
-		dip->di_output_file = dtp->dt_device;
-	    }
-	    dip->di_process_id = getpid();
-	    if (dip->di_log_format) {
-		dip->di_log_file = dip->di_log_format;	/* Original log file w/format strings. */
-	    }
-	    setup_iotuning(dip, NULL);	/* Setup IO tuning options. */
-	    update_cmd_line(dip);	/* Update the command line (for logging). */
-	    make_unique_log(dip);	/* Check & make a unique log. */
-	    break;			/* Child process, continue... */
-	}
-    }
-    return (dip->di_child_pid);
-}
-
-pid_t
-start_procs(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    size_t psize;
-    int procs;
-
-    dip->di_max_procs = dip->di_num_procs;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo (dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    memset(dip->di_ptable, '\0', psize);
-
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-
-    for (dtp = dip->di_ptable, procs = 0; procs < dip->di_max_procs; procs++, dtp++) {
-	if ((dip->di_child_pid = fork_process(dip)) == (pid_t) -1) {
-	    break;
-	} else if (dip->di_child_pid) {		/* Parent process gets the PID. */
-	    dip->di_cur_proc++;
-	    dtp->dt_pid = dip->di_child_pid;
-	    dtp->dt_active = True;
-	    dip->di_procs_active++;
-	    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-		Printf (dip, "Started Process %d...\n", dip->di_child_pid);
-	    }
-	} else {			/* Child process... */
-	    dip->di_process_id = getpid();
-	    if (dip->di_output_file) {
-		dip->di_unique_file = True;	/* Create unique file name. */
-	    }
-	    if (dip->di_log_format) {
-		dip->di_log_file = dip->di_log_format;	/* Original log file w/format strings. */
-	    }
-	    setup_iotuning(dip, NULL);	/* Setup IO tuning options. */
-	    setup_multiprocs(dip, NULL);/* Setup multiple process options. */
-	    make_unique_log(dip);	/* Check & make a unique log. */
-	    break;			/* Child process, continue... */
-	}
-    }
-    return (dip->di_child_pid);
-}
-
-pid_t
-start_slices(dinfo_t *dip)
-{
-    struct dt_procs *dtp;
-    size_t psize;
-    struct slice_info slice_info;
-    slice_info_t *sip = &slice_info;
-    large_t data_resid;
-    int procs;
-
-    dip->di_max_procs = dip->di_slices;
-    psize = (dip->di_max_procs * sizeof(*dtp));
-
-    if ((dip->di_ptable = (struct dt_procs *)Malloc(dip, psize)) == NULL) {
-	ReportErrorInfo(dip, NULL, os_get_error(), "No memory for proc table", OTHER_OP, False);
-	exit (FATAL_ERROR);
-    }
-    memset(dip->di_ptable, '\0', psize);
-
-    init_slice_info(dip, sip, &data_resid);
-
-    dip->di_cur_proc = 1;
-    dip->di_procs_active = 0;
-
-    for (dtp = dip->di_ptable, procs = 0; procs < dip->di_max_procs; procs++, dtp++) {
-	sip->slice++;
-	/* Last slice gets any residual bytes. */
-	if ((procs + 1) == dip->di_max_procs) {
-	    sip->slice_length += data_resid;
-	}
-	if ((dip->di_child_pid = fork_process(dip)) == (pid_t) -1) {
-	    break;
-	} else if (dip->di_child_pid) {		/* Parent process gets the PID. */
-	    dip->di_cur_proc++;
-	    dtp->dt_pid = dip->di_child_pid;
-	    dtp->dt_active = True;
-	    dip->di_procs_active++;
-	    if (dip->di_debug_flag || dip->di_pDebugFlag) {
-		Printf (dip, "Started Slice %d, PID %d...\n", sip->slice, dip->di_child_pid);
-	    }
-	    if (procs < dip->di_max_procs) {
-		sip->slice_position += sip->slice_length;
-	    }
-	} else {			/* Child process... */
-	    /*
-	     * Initialize the starting data pattern for each slice.
-	     */
-	    dip->di_process_id = getpid();
-	    if (dip->di_unique_pattern) {
-		dip->di_pattern = data_patterns[(dip->di_cur_proc - 1) % npatterns];
-	    }
-	    if (dip->di_log_format) {
-		dip->di_log_file = dip->di_log_format;	/* Original log file w/format strings. */
-	    }
-	    setup_iotuning(dip, NULL);	/* Setup IO tuning options. */
-	    setup_multiprocs(dip, NULL);/* Setup multiple process options. */
-	    make_unique_log(dip);	/* Check & make a unique log. */
-	    setup_slice(dip, sip);
-	    break;			/* Child process, continue... */
-	}
-    }
-    return (dip->di_child_pid);
-}
-#endif /* !defined(WIN32) */
-
 int
 init_slice(struct dinfo *dip, int slice)
 {
@@ -31,6 +31,19 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      With iolock threads, stop all threads as soon as end of file is
+ * seen, rather than after their claimed records (iochunk=).
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Pass the bytes transferred to update_latency_stats() for time series.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Use update_latency_stats(), which also records the latency histogram.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Claim forward fixed size records without the I/O lock (atomics).
+ *
  * January 8th, 2026 by Robin T. Miller
  *      Minor updates for MacOS without SCSI support.
  *
@@ -557,7 +570,7 @@ read_data_iolock(struct dinfo *dip)
 {
     io_global_data_t *iogp = dip->di_job->ji_opaque;
     register ssize_t count;
-    register size_t bsize, dsize;
+    size_t bsize, dsize;
     large_t data_limit;
     int status = SUCCESS;
     struct dtfuncs *dtf = dip->di_funcs;
@@ -565,6 +578,7 @@ read_data_iolock(struct dinfo *dip)
     hbool_t lock_full_range = False;
     hbool_t check_rwbytes = False;
     hbool_t check_write_limit = False;
+    hbool_t lockfree_flag = False;
     u_long io_record = 0;
     lbdata_t lba;
     iotype_t iotype = dip->di_io_type;
@@ -610,13 +624,23 @@ read_data_iolock(struct dinfo *dip)
 	dip->di_target_total_usecs = 0;
     }
 
+    /*
+     * Forward fixed size records are claimed without the I/O lock.
+     */
+    if ( (random_percentage == 0) && (dip->di_io_dir == FORWARD) &&
+	 (dip->di_step_offset == 0) && (dip->di_min_size == 0) ) {
+	lockfree_flag = True;
+	dip->di_iochunk_next = dip->di_iochunk_end = 0;
+    }
+
     /*
      * Now read and optionally verify the input records.
      */
-    while ( (iogp->io_end_of_file == False) &&
-	    (dip->di_error_count < dip->di_error_limit) &&
-	    (iogp->io_bytes_read < data_limit) &&
-	    (iogp->io_records_read < dip->di_record_limit) ) {
+    while ( (dip->di_error_count < dip->di_error_limit) &&
+	    (iogp->io_end_of_file == False) &&
+	    ( ((lockfree_flag == True) && (dip->di_iochunk_next < dip->di_iochunk_end)) ||
+	      ((iogp->io_bytes_read < data_limit) &&
+	       (iogp->io_records_read < dip->di_record_limit)) ) ) {
 
 	PAUSE_THREAD(dip);
 	if ( THREAD_TERMINATING(dip) ) break;
@@ -641,95 +665,109 @@ read_data_iolock(struct dinfo *dip)
 	    break;
 	}
 
-	(void)dt_acquire_iolock(dip, iogp);
-	/*
-	 * Setup the random/sequential percentages (if enabled).
-	 */
-	if (random_percentage) {
-	    probability_random = (int)(get_random(dip) % 100);
-	    if (probability_random < random_percentage) {
-		iotype = RANDOM_IO;
-	    } else {
-		iotype = SEQUENTIAL_IO;
-		dip->di_offset = iogp->io_sequential_offset;
+	if (lockfree_flag == True) {
+	    if (dip->di_read_delay) {			/* Optional read delay.	*/
+		mySleep(dip, dip->di_read_delay);
+	    }
+	    if (dt_claim_iorange(dip, iogp, &iogp->io_bytes_read, &iogp->io_records_read,
+				 dsize, data_limit, &bsize, &io_record) == False) {
+		set_Eof(dip);
+		break;
+	    }
+	    if (iotype == RANDOM_IO) {
+		dip->di_offset = do_random(dip, True, bsize);
 	    }
-	}
-
-	if (dip->di_read_delay) {			/* Optional read delay.	*/
-	    mySleep(dip, dip->di_read_delay);
-	}
-
-	/*
-	 * With multiple threads, we must check limits after unlocking.
-	 */
-	if ( (iogp->io_end_of_file == True) ||
-	     (iogp->io_bytes_read >= data_limit) ||
-	     (iogp->io_records_read >= dip->di_record_limit) ) {
-	    set_Eof(dip);
-	    iogp->io_end_of_file = dip->di_end_of_file;
-	    (void)dt_release_iolock(dip, iogp);
-	    break;
-	}
-
-	/*
-	 * If data limit was specified, ensure we don't exceed it.
-	 */
-	if ( (iogp->io_bytes_read + dsize) > data_limit) {
-	    bsize = (size_t)(data_limit - iogp->io_bytes_read);
 	} else {
-	    bsize = dsize;
-	}
+	    (void)dt_acquire_iolock(dip, iogp);
+	    /*
+	     * Setup the random/sequential percentages (if enabled).
+	     */
+	    if (random_percentage) {
+		probability_random = (int)(get_random(dip) % 100);
+		if (probability_random < random_percentage) {
+		    iotype = RANDOM_IO;
+		} else {
+		    iotype = SEQUENTIAL_IO;
+		    dip->di_offset = iogp->io_sequential_offset;
+		}
+	    }
 
-       if (iotype == SEQUENTIAL_IO) {
-	    dip->di_offset = iogp->io_sequential_offset;
-	    if (dip->di_io_dir == REVERSE) {
-		bsize = (size_t)MIN((dip->di_offset - dip->di_file_position), (Offset_t)bsize);
-		dip->di_offset = set_position(dip, (Offset_t)(dip->di_offset - bsize), False);
-		iogp->io_sequential_offset = dip->di_offset;
-	    } else {
-		iogp->io_sequential_offset += bsize;
+	    if (dip->di_read_delay) {			/* Optional read delay.	*/
+		mySleep(dip, dip->di_read_delay);
 	    }
-	} else if (iotype == RANDOM_IO) {
+
 	    /*
-	     * BEWARE: The size *must* match the write size, or you'll get
-	     * a different offset, since the size is used in calculations.
+	     * With multiple threads, we must check limits after unlocking.
 	     */
-	    dip->di_offset = do_random(dip, True, bsize);
-	}
-	iogp->io_bytes_read += bsize;
-	iogp->io_records_read++;
-	io_record = iogp->io_records_read;
+	    if ( (iogp->io_end_of_file == True) ||
+		 (iogp->io_bytes_read >= data_limit) ||
+		 (iogp->io_records_read >= dip->di_record_limit) ) {
+		set_Eof(dip);
+		iogp->io_end_of_file = dip->di_end_of_file;
+		(void)dt_release_iolock(dip, iogp);
+		break;
+	    }
 
-	if ( (iotype == SEQUENTIAL_IO) && dip->di_step_offset) {
-	    Offset_t offset = iogp->io_sequential_offset;
-	    if (dip->di_io_dir == FORWARD) {
-		/* Note: Useful for debug, but we don't need to set position! */
-		offset = set_position(dip, (offset + dip->di_step_offset), True);
-		/* Linux returns EINVAL when seeking too far! */
-		if (offset == (Offset_t)-1) {
-		    set_Eof(dip);
-		    break;
-		}
-		/* 
-		 * This check prevents us from writing past the end of a slice.
-		 * Note: Without slices, we expect to encounter end of file/media.
-		 */ 
-		if ( dip->di_slices &&
-		     ((offset + (Offset_t)dsize) >= dip->di_end_position) ) {
-		    set_Eof(dip);
-		    break;
+	    /*
+	     * If data limit was specified, ensure we don't exceed it.
+	     */
+	    if ( (iogp->io_bytes_read + dsize) > data_limit) {
+		bsize = (size_t)(data_limit - iogp->io_bytes_read);
+	    } else {
+		bsize = dsize;
+	    }
+
+	    if (iotype == SEQUENTIAL_IO) {
+		dip->di_offset = iogp->io_sequential_offset;
+		if (dip->di_io_dir == REVERSE) {
+		    bsize = (size_t)MIN((dip->di_offset - dip->di_file_position), (Offset_t)bsize);
+		    dip->di_offset = set_position(dip, (Offset_t)(dip->di_offset - bsize), False);
+		    iogp->io_sequential_offset = dip->di_offset;
+		} else {
+		    iogp->io_sequential_offset += bsize;
 		}
-	    } else { /* io_dir = REVERSE */
-		offset -= dip->di_step_offset;
-		if (offset <= (Offset_t) dip->di_file_position) {
-		    set_Eof(dip);
-		    dip->di_beginning_of_file = True;
-		    break;
+	    } else if (iotype == RANDOM_IO) {
+		/*
+		 * BEWARE: The size *must* match the write size, or you'll get
+		 * a different offset, since the size is used in calculations.
+		 */
+		dip->di_offset = do_random(dip, True, bsize);
+	    }
+	    iogp->io_bytes_read += bsize;
+	    iogp->io_records_read++;
+	    io_record = iogp->io_records_read;
+
+	    if ( (iotype == SEQUENTIAL_IO) && dip->di_step_offset) {
+		Offset_t offset = iogp->io_sequential_offset;
+		if (dip->di_io_dir == FORWARD) {
+		    /* Note: Useful for debug, but we don't need to set position! */
+		    offset = set_position(dip, (offset + dip->di_step_offset), True);
+		    /* Linux returns EINVAL when seeking too far! */
+		    if (offset == (Offset_t)-1) {
+			set_Eof(dip);
+			break;
+		    }
+		    /* 
+		     * This check prevents us from writing past the end of a slice.
+		     * Note: Without slices, we expect to encounter end of file/media.
+		     */ 
+		    if ( dip->di_slices &&
+			 ((offset + (Offset_t)dsize) >= dip->di_end_position) ) {
+			set_Eof(dip);
+			break;
+		    }
+		} else { /* io_dir = REVERSE */
+		    offset -= dip->di_step_offset;
+		    if (offset <= (Offset_t) dip->di_file_position) {
+			set_Eof(dip);
+			dip->di_beginning_of_file = True;
+			break;
+		    }
 		}
+		iogp->io_sequential_offset = offset;
 	    }
-	    iogp->io_sequential_offset = offset;
+	    (void)dt_release_iolock(dip, iogp);
 	}
-	(void)dt_release_iolock(dip, iogp);
 
         if (dip->di_debug_flag && (bsize != dsize) && !dip->di_variable_flag) {
             Printf(dip, "Record #%lu, Reading a partial record of %lu bytes...\n",
@@ -786,6 +824,12 @@ read_data_iolock(struct dinfo *dip)
 	    count = read_record(dip, dip->di_data_buffer, bsize, dsize, dip->di_offset, &status);
 	} while (status == RETRYABLE);
 
+	/* Stop the other threads now, rather than after their claims. */
+	if (dip->di_end_of_file) {
+	    iogp->io_end_of_file = True;
+	    break;
+	}
+
 	if (status == FAILURE) {
 	    if (dip->di_error_count >= dip->di_error_limit) break;
 	}
@@ -868,7 +912,16 @@ read_data_iolock(struct dinfo *dip)
     if (dip->di_end_of_file == False) {
 	set_Eof(dip);
     }
-    iogp->io_end_of_file = dip->di_end_of_file;
+    /*
+     * Once the limits are claimed, other threads must finish their claims,
+     * so only propagate end of file when stopping early (error, EOF, etc).
+     */
+    if ( (lockfree_flag == False) ||
+	 (dip->di_iochunk_next < dip->di_iochunk_end) ||
+	 ( (iogp->io_bytes_read < data_limit) &&
+	   (iogp->io_records_read < dip->di_record_limit) ) ) {
+	iogp->io_end_of_file = dip->di_end_of_file;
+    }
 
     if (lock_full_range == True) {
 	int rc = dt_lock_unlock(dip, dip->di_dname, &dip->di_fd,
@@ -1179,22 +1232,7 @@ retry:
     *status = check_read(dip, count, bsize);
 
     /* Latency */
-    if ( latency < dip->di_min_latency ) {
-        dip->di_min_latency = latency;
-    }
-    if ( latency > dip->di_max_latency ) {
-        dip->di_max_latency = latency;
-    }
-    dip->di_total_latency_ios++;
-    dip->di_total_latency += latency;
-    dip->di_read_latency_ios++;
-    dip->di_read_latency += latency;
-    if ( latency < dip->di_min_read_latency ) {
-        dip->di_min_read_latency = latency;
-    }
-    if ( latency > dip->di_max_read_latency ) {
-        dip->di_max_read_latency = latency;
-    }
+    update_latency_stats(dip, READ_OP, latency, count);
     if ( dip->di_latency_frequency || dip->di_latency_minimum || dip->di_latency_maximum ) {
         char *text;
         if ( dip->di_latency_minimum && (latency < dip->di_latency_minimum) ) {
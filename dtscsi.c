@@ -33,6 +33,10 @@
  * 
  * Modification History:
  * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the asynchronous SCSI I/O engine, so AIO with SCSI I/O keeps
+ * multiple commands in flight via the sg driver (see scsilib-linux.c).
+ * 
  * July 30th, 2021 by Robin T. Miller
  *      Adding initial support for NVMe disks.
  * 
@@ -66,6 +70,9 @@
  * the GVA Volume Name, since the data returned differs for 7-mode/c-mode.
  */
 #include "dt.h"
+#if defined(AIO) && defined(__linux__)
+#  include <poll.h>
+#endif /* defined(AIO) && defined(__linux__) */
 
 /*
  * Forward Reference:
@@ -888,6 +895,415 @@ dtReportScsiError(dinfo_t *dip, scsi_generic_t *sgp)
     return;
 }
 
+#if defined(AIO) && defined(__linux__)
+/*
+ * Asynchronous SCSI I/O Engine: (used by the AIO test functions, see dtaio.c)
+ *
+ *	With SCSI I/O enabled (enable=scsi_io), AIO requests are issued as
+ * SCSI Read/Write CDBs via the sg driver's asynchronous write()/read()
+ * interface, so multiple commands are in flight per thread (aios=), rather
+ * than one blocking SG_IO request at a time. Each AIO control block has its
+ * own SCSI generic data, so the CDB building (ReadData/WriteData), sense
+ * decoding, and error reporting are shared with synchronous SCSI I/O.
+ * The library execute CDB hook is used to submit each request, and the
+ * recovery (retry) logic is applied as each request completes.
+ *
+ *	Each thread opens its own sg file descriptor, so completions are
+ * only reaped by the thread that issued them.
+ */
+typedef struct scsi_aio_info {
+    HANDLE		sa_fd;		/* The sg device file descriptor.	*/
+    int			sa_requests;	/* The number of requests.		*/
+    scsi_generic_t	*sa_sgps;	/* The per request SCSI generic data.	*/
+    ssize_t		*sa_iosizes;	/* The per request I/O sizes.		*/
+    ssize_t		*sa_results;	/* The byte count or negative errno.	*/
+    hbool_t		*sa_done;	/* The request completed flags.		*/
+} scsi_aio_info_t;
+
+static int dtscsi_aio_execute(void *opaque, scsi_generic_t *sgp);
+static void dtscsi_aio_complete(dinfo_t *dip, scsi_aio_info_t *sap, scsi_generic_t *sgp);
+static int dtscsi_aio_reap(dinfo_t *dip, scsi_aio_info_t *sap, hbool_t wait);
+
+/*
+ * dtscsi_aio_initialize() - Setup Asynchronous SCSI I/O for this thread.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+int
+dtscsi_aio_initialize(dinfo_t *dip)
+{
+    scsi_aio_info_t *sap;
+    scsi_generic_t *sgpio = dip->di_sgpio;
+    scsi_generic_t sg;
+    int index;
+
+    if (dip->di_scsi_aio) {
+	return(SUCCESS);
+    }
+    if (sgpio == NULL) {
+	Eprintf(dip, "SCSI I/O is enabled, but the SCSI device is NOT setup!\n");
+	return(FAILURE);
+    }
+    if (os_spt_async_supported(sgpio) == False) {
+	Eprintf(dip, "Asynchronous SCSI I/O requires the sg device (sdsf=/dev/sgN), not %s!\n",
+		sgpio->dsf);
+	return(FAILURE);
+    }
+    /* Open our own sg device, so we only reap our own requests. */
+    sg = *sgpio;
+    if (os_open_device(&sg) == FAILURE) {
+	return(FAILURE);
+    }
+    sap = Malloc(dip, sizeof(*sap));
+    if (sap == NULL) {
+	(void)os_close_device(&sg);
+	return(FAILURE);
+    }
+    sap->sa_fd = sg.fd;
+    sap->sa_requests = dip->di_aio_bufs;
+    sap->sa_sgps = Malloc(dip, (sap->sa_requests * sizeof(*sap->sa_sgps)));
+    sap->sa_iosizes = Malloc(dip, (sap->sa_requests * sizeof(*sap->sa_iosizes)));
+    sap->sa_results = Malloc(dip, (sap->sa_requests * sizeof(*sap->sa_results)));
+    sap->sa_done = Malloc(dip, (sap->sa_requests * sizeof(*sap->sa_done)));
+    dip->di_scsi_aio = sap;
+    if ( (sap->sa_sgps == NULL) || (sap->sa_iosizes == NULL) ||
+	 (sap->sa_results == NULL) || (sap->sa_done == NULL) ) {
+	dtscsi_aio_cleanup(dip);
+	return(FAILURE);
+    }
+    for (index = 0; index < sap->sa_requests; index++) {
+	scsi_generic_t *sgp = &sap->sa_sgps[index];
+	*sgp = sg;
+	sgp->opaque = dip;
+	sgp->execute_cdb = dtscsi_aio_execute;
+	sgp->sense_data = malloc_palign(dip, sgp->sense_length, 0);
+	if (sgp->sense_data == NULL) {
+	    dtscsi_aio_cleanup(dip);
+	    return(FAILURE);
+	}
+	sap->sa_done[index] = True;
+    }
+    if (dip->di_debug_flag) {
+	Printf(dip, "Asynchronous SCSI I/O setup with %d requests on %s, fd = %d\n",
+	       sap->sa_requests, sg.dsf, sap->sa_fd);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * dtscsi_aio_cleanup() - Teardown Asynchronous SCSI I/O.
+ *
+ * Note: Closing the sg device discards any outstanding requests.
+ */
+void
+dtscsi_aio_cleanup(dinfo_t *dip)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index;
+
+    if (sap == NULL) return;
+    if (sap->sa_sgps) {
+	for (index = 0; index < sap->sa_requests; index++) {
+	    if (sap->sa_sgps[index].sense_data) {
+		free_palign(dip, sap->sa_sgps[index].sense_data);
+	    }
+	}
+	Free(dip, sap->sa_sgps);
+    }
+    if (sap->sa_iosizes) Free(dip, sap->sa_iosizes);
+    if (sap->sa_results) Free(dip, sap->sa_results);
+    if (sap->sa_done) Free(dip, sap->sa_done);
+    if (sap->sa_fd != INVALID_HANDLE_VALUE) {
+	(void)close(sap->sa_fd);
+    }
+    Free(dip, sap);
+    dip->di_scsi_aio = NULL;
+    return;
+}
+
+/*
+ * dtscsi_aio_execute() - Submit the SCSI Request (library execute CDB hook).
+ *
+ * Description:
+ *	Called via libExecuteCdb() after the CDB is built, this starts the
+ * request, rather than waiting for the request to complete.
+ */
+static int
+dtscsi_aio_execute(void *opaque, scsi_generic_t *sgp)
+{
+    dinfo_t *dip = opaque;
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index = (int)(sgp - sap->sa_sgps);
+
+    /* Clear the status, as libExecuteCdb() does. */
+    memset(sgp->sense_data, '\0', sgp->sense_length);
+    sgp->os_error = 0;
+    sgp->error = sgp->sense_valid = False;
+    sgp->scsi_status = sgp->driver_status = sgp->host_status = sgp->data_resid = 0;
+
+    return( os_spt_submit(sgp, (index + 1)) );
+}
+
+/*
+ * dtscsi_aio_queue() - Queue an AIO Read or Write Request.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	acbp = The AIO control block (buffer, byte count, and offset).
+ *	mode = The test mode (READ_MODE or WRITE_MODE).
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (errno is set).
+ */
+int
+dtscsi_aio_queue(dinfo_t *dip, struct aiocb *acbp, test_mode_t mode)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index = (int)(acbp - dip->di_acbs);
+    scsi_generic_t *sgp;
+    uint64_t lba;
+    uint32_t blocks;
+    ssize_t iosize;
+    int status;
+
+    if ( (sap == NULL) || (index >= sap->sa_requests) ) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    sgp = &sap->sa_sgps[index];
+    iosize = scsiRequestSetup(dip, sgp, (void *)acbp->aio_buf, acbp->aio_nbytes,
+			      acbp->aio_offset, &lba, &blocks);
+    if (iosize < 0) return(FAILURE);
+    sap->sa_iosizes[index] = iosize;
+    if (iosize == 0) {
+	/* Beyond the capacity, complete as end of media. */
+	sap->sa_results[index] = 0;
+	sap->sa_done[index] = True;
+	return(SUCCESS);
+    }
+    sgp->recovery_retries = 0;
+    sap->sa_done[index] = False;
+    if (mode == READ_MODE) {
+	status = ReadData(dip->di_scsi_read_type, sgp, lba, blocks, (uint32_t)iosize);
+    } else {
+	status = WriteData(dip->di_scsi_write_type, sgp, lba, blocks, (uint32_t)iosize);
+    }
+    if (status == FAILURE) {
+	sap->sa_done[index] = True;
+	if (sgp->os_error) errno = sgp->os_error;
+    }
+    return(status);
+}
+
+/*
+ * dtscsi_aio_complete() - Complete a SCSI Request.
+ *
+ * Description:
+ *	Retriable errors are resubmitted, as libExecuteCdb() does for
+ * synchronous requests. Otherwise, errors are reported and the result
+ * is saved for dtscsi_aio_return().
+ */
+static void
+dtscsi_aio_complete(dinfo_t *dip, scsi_aio_info_t *sap, scsi_generic_t *sgp)
+{
+    int index = (int)(sgp - sap->sa_sgps);
+
+    if ( (sgp->error == True) && sgp->recovery_flag ) {
+	if (sgp->recovery_retries == sgp->recovery_limit) {
+	    Fprintf(dip, "Exceeded retry limit (%u) for this request!\n", sgp->recovery_limit);
+	} else if (libIsRetriable(sgp) == True) {
+	    (void)os_sleep(sgp->recovery_delay);
+	    if (sgp->errlog == True) {
+		/* Folks wish to see the actual error too! */
+		libReportScsiError(sgp, True);
+		Fprintf(dip, "Warning: Retrying %s after %u second delay, retry #%u...\n",
+			sgp->cdb_name, sgp->recovery_delay, sgp->recovery_retries);
+	    }
+	    if (dtscsi_aio_execute(dip, sgp) == SUCCESS) {
+		return;
+	    }
+	}
+    }
+    if (sgp->error == True) {
+	if (sgp->errlog || sgp->debug) {
+	    libReportScsiError(sgp, sgp->warn_on_error);
+	}
+	sap->sa_results[index] = (sgp->os_error) ? -sgp->os_error : -EIO;
+    } else {
+	sap->sa_results[index] = sap->sa_iosizes[index];
+    }
+    sap->sa_done[index] = True;
+    return;
+}
+
+/*
+ * dtscsi_aio_reap() - Reap Completed SCSI Requests.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	sap = The SCSI AIO information.
+ *	wait = Wait for at least one request to complete.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (errno is set).
+ */
+static int
+dtscsi_aio_reap(dinfo_t *dip, scsi_aio_info_t *sap, hbool_t wait)
+{
+    struct pollfd pfd;
+    scsi_generic_t *sgp;
+    int error, reaped = 0;
+
+    do {
+	while ( (sgp = os_spt_reap(sap->sa_fd, &error)) ) {
+	    dtscsi_aio_complete(dip, sap, sgp);
+	    reaped++;
+	}
+	if ( (error != EAGAIN) && (error != EINTR) ) {
+	    errno = error;
+	    return(FAILURE);
+	}
+	if ( (wait == False) || reaped ) break;
+	pfd.fd = sap->sa_fd;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+	if ( (poll(&pfd, 1, -1) < 0) && (errno != EINTR) ) {
+	    return(FAILURE);
+	}
+	if (terminating_flag == True) {
+	    errno = EINTR;
+	    return(FAILURE);
+	}
+    } while (True);
+    return(SUCCESS);
+}
+
+/*
+ * dtscsi_aio_wait() - Wait for an AIO Request to Complete.
+ *
+ * Return Value:
+ *	Returns 0 if the request succeeded, an errno if the request failed
+ * (like aio_error), or FAILURE if waiting failed.
+ */
+int
+dtscsi_aio_wait(dinfo_t *dip, struct aiocb *acbp)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index = (int)(acbp - dip->di_acbs);
+
+    if (sap == NULL) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    while (sap->sa_done[index] == False) {
+	if (dtscsi_aio_reap(dip, sap, True) == FAILURE) {
+	    return(FAILURE);
+	}
+    }
+    return( (sap->sa_results[index] < 0) ? (int)-sap->sa_results[index] : 0 );
+}
+
+/*
+ * dtscsi_aio_wait_any() - Wait for Any Outstanding AIO Request to Complete.
+ *
+ * Description:
+ *	Used for unordered (completion order) processing. The search for a
+ * completed request begins at the starting index (the oldest request).
+ *
+ * Return Value:
+ *	Returns the AIO control block index, or FAILURE if waiting failed
+ * or no requests are outstanding.
+ */
+int
+dtscsi_aio_wait_any(dinfo_t *dip, int start)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int count, index, outstanding;
+
+    if (sap == NULL) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    if (dtscsi_aio_reap(dip, sap, False) == FAILURE) {
+	return(FAILURE);
+    }
+    do {
+	outstanding = 0;
+	for (count = 0, index = start; count < sap->sa_requests; count++) {
+	    if (dip->di_acbs[index].aio_fildes != AIO_NotQed) {
+		if (sap->sa_done[index] == True) {
+		    return(index);
+		}
+		outstanding++;
+	    }
+	    if (++index == sap->sa_requests) index = 0;
+	}
+	if (outstanding == 0) {
+	    errno = EINVAL;
+	    return(FAILURE);
+	}
+	if (dtscsi_aio_reap(dip, sap, True) == FAILURE) {
+	    return(FAILURE);
+	}
+    } while (True);
+    /*NOTREACHED*/
+}
+
+/*
+ * dtscsi_aio_return() - Return the AIO Request Status (like aio_return).
+ *
+ * Return Value:
+ *	Returns the byte count, or FAILURE with errno set.
+ */
+ssize_t
+dtscsi_aio_return(dinfo_t *dip, struct aiocb *acbp)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index = (int)(acbp - dip->di_acbs);
+
+    if ( (sap == NULL) || (sap->sa_done[index] == False) ) {
+	errno = EINPROGRESS;
+	return(FAILURE);
+    }
+    if (sap->sa_results[index] < 0) {
+	errno = (int)-sap->sa_results[index];
+	return(FAILURE);
+    }
+    return(sap->sa_results[index]);
+}
+
+/*
+ * dtscsi_aio_cancel() - Cancel Outstanding Requests.
+ *
+ * Description:
+ *	The sg driver cannot cancel individual requests, so outstanding
+ * requests are left to complete, and get reaped by the waiters.
+ *
+ * Return Value:
+ *	Returns AIO_NOTCANCELED or AIO_ALLDONE (like aio_cancel).
+ */
+int
+dtscsi_aio_cancel(dinfo_t *dip)
+{
+    scsi_aio_info_t *sap = dip->di_scsi_aio;
+    int index;
+
+    if (sap == NULL) {
+	errno = EBADF;
+	return(FAILURE);
+    }
+    (void)dtscsi_aio_reap(dip, sap, False);
+    for (index = 0; index < sap->sa_requests; index++) {
+	if (sap->sa_done[index] == False) {
+	    return(AIO_NOTCANCELED);
+	}
+    }
+    return(AIO_ALLDONE);
+}
+
+#endif /* defined(AIO) && defined(__linux__) */
+
 #endif /* defined(SCSI) */
 
 #if !defined(NVME)
@@ -0,0 +1,410 @@
+/****************************************************************************
+ *      								    *
+ *      		  COPYRIGHT (c) 1988 - 2026     		    *
+ *      		   This Software Provided       		    *
+ *      			     By 				    *
+ *      		  Robin's Nest Software Inc.    		    *
+ *      								    *
+ * Permission to use, copy, modify, distribute and sell this software and   *
+ * its documentation for any purpose and without fee is hereby granted,     *
+ * provided that the above copyright notice appear in all copies and that   *
+ * both that copyright notice and this permission notice appear in the      *
+ * supporting documentation, and that the name of the author not be used    *
+ * in advertising or publicity pertaining to distribution of the software   *
+ * without specific, written prior permission.  			    *
+ *      								    *
+ * THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,        *
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN      *
+ * NO EVENT SHALL HE BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL   *
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR    *
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS  *
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF   *
+ * THIS SOFTWARE.       						    *
+ *      								    *
+ ****************************************************************************/
+/*
+ * Module:      dtseries.c
+ * Author:      Robin T. Miller
+ * Date:	October 16th, 2026
+ *
+ * Description:
+ *      Per job time series recorder for throughput, IOPS, and latency.
+ *
+ *	A recorder thread samples each job thread's counters at the requested
+ * interval (tsinterval=ms), and writes one CSV row per interval to the time
+ * series file (tsfile=). The counters are only updated by their own thread,
+ * so we read them without locks, and the latency percentiles are derived
+ * from the growth of each thread histogram since the previous sample.
+ *
+ *	Per-pass statistics average out the throughput dips seen during array
+ * failovers, garbage collection, and snapshots, but these stand out here.
+ *
+ * Modification History:
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Wait for the interval on a condition variable, so stopping the
+ * recorder is immediate, rather than waiting up to a full interval.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Initial creation, with the CSV time series recorder.
+ */
+#include "dt.h"
+
+/*
+ * The previous sample of each thread's counters.
+ */
+typedef struct ts_thread {
+    uint64_t	tt_read_bytes;
+    uint64_t	tt_write_bytes;
+    uint64_t	tt_read_ops;
+    uint64_t	tt_write_ops;
+    u_long	tt_errors;
+    uint32_t	tt_noprogs;
+    latency_histogram_t *tt_read_histogram;
+    latency_histogram_t *tt_write_histogram;
+} ts_thread_t;
+
+typedef struct time_series {
+    char	*ts_file;		/* The time series file name.	*/
+    FILE	*ts_fp;			/* The time series file pointer.*/
+    uint32_t	ts_interval;		/* The sample interval (ms).	*/
+    vbool_t	ts_stop;		/* Tells the recorder to stop.	*/
+    pthread_mutex_t ts_lock;		/* The recorder wait lock.	*/
+    pthread_cond_t ts_cond;		/* Signalled to stop recorder.	*/
+    hbool_t	ts_started;		/* The recorder thread started.	*/
+    pthread_t	ts_thread_id;		/* The recorder thread ID.	*/
+    int		ts_threads;		/* The number of job threads.	*/
+    dinfo_t	**ts_dts;		/* The job thread information.	*/
+    ts_thread_t	*ts_samples;		/* The previous thread samples.	*/
+    struct timeval ts_start_time;	/* The recorder start time.	*/
+    struct timeval ts_last_time;	/* The previous sample time.	*/
+    latency_histogram_t ts_read_histogram;  /* Interval read latencies.  */
+    latency_histogram_t ts_write_histogram; /* Interval write latencies. */
+} time_series_t;
+
+static void *time_series_thread(void *arg);
+
+/*
+ * sample_histogram() - Accumulate a Thread Histogram Interval.
+ *
+ * Description:
+ *	Adds the buckets which grew since the previous sample to the interval
+ * histogram, then saves the current bucket counts for the next sample. The
+ * thread allocates its histogram on first use, so it may still be NULL.
+ *
+ * Inputs:
+ *	dip = The device information pointer (for allocations).
+ *	shp = The thread histogram (may be NULL).
+ *	php = Pointer to the previous sample histogram.
+ *	ihp = The interval histogram.
+ *
+ * Return Value:
+ *	void
+ */
+static void
+sample_histogram(dinfo_t *dip, latency_histogram_t *shp,
+		 latency_histogram_t **php, latency_histogram_t *ihp)
+{
+    latency_histogram_t *phip;
+    uint64_t value, delta;
+    int bucket;
+
+    if (shp == NULL) return;
+    if ( (phip = *php) == NULL) {
+	phip = *php = Malloc(dip, sizeof(*phip));
+	if (phip == NULL) return;
+    }
+    for (bucket = 0; (bucket < LATENCY_BUCKETS); bucket++) {
+	value = shp->lh_buckets[bucket];
+	if ( (delta = (value - phip->lh_buckets[bucket])) ) {
+	    ihp->lh_buckets[bucket] += delta;
+	    ihp->lh_count += delta;
+	    phip->lh_buckets[bucket] = value;
+	}
+    }
+    ihp->lh_max_latency = MAX(ihp->lh_max_latency, shp->lh_max_latency);
+    return;
+}
+
+/*
+ * sample_time_series() - Sample the Job Threads and Write a CSV Row.
+ *
+ * Inputs:
+ *	dip = The device information pointer (for messages).
+ *	tsp = The time series pointer.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (write failed).
+ */
+static int
+sample_time_series(dinfo_t *dip, time_series_t *tsp)
+{
+    uint64_t read_bytes = 0, write_bytes = 0, read_ops = 0, write_ops = 0;
+    uint64_t value, usecs;
+    u_long errors = 0, noprogs = 0;
+    struct timeval now;
+    double secs;
+    char *buffer, *bp;
+    int thread;
+
+    memset(&tsp->ts_read_histogram, '\0', sizeof(tsp->ts_read_histogram));
+    memset(&tsp->ts_write_histogram, '\0', sizeof(tsp->ts_write_histogram));
+    for (thread = 0; (thread < tsp->ts_threads); thread++) {
+	dinfo_t *tdip = tsp->ts_dts[thread];
+	ts_thread_t *ttp = &tsp->ts_samples[thread];
+
+	value = os_atomic_load64(&tdip->di_io_read_bytes);
+	read_bytes += (value - ttp->tt_read_bytes);
+	ttp->tt_read_bytes = value;
+	value = os_atomic_load64(&tdip->di_io_write_bytes);
+	write_bytes += (value - ttp->tt_write_bytes);
+	ttp->tt_write_bytes = value;
+	value = os_atomic_load64(&tdip->di_read_latency_ios);
+	read_ops += (value - ttp->tt_read_ops);
+	ttp->tt_read_ops = value;
+	value = os_atomic_load64(&tdip->di_write_latency_ios);
+	write_ops += (value - ttp->tt_write_ops);
+	ttp->tt_write_ops = value;
+	/* Note: The error count is restored after retries, so may go down! */
+	if (tdip->di_error_count > ttp->tt_errors) {
+	    errors += (tdip->di_error_count - ttp->tt_errors);
+	}
+	ttp->tt_errors = tdip->di_error_count;
+	noprogs += (tdip->di_noprogs - ttp->tt_noprogs);
+	ttp->tt_noprogs = tdip->di_noprogs;
+
+	sample_histogram(dip, tdip->di_read_histogram,
+			 &ttp->tt_read_histogram, &tsp->ts_read_histogram);
+	sample_histogram(dip, tdip->di_write_histogram,
+			 &ttp->tt_write_histogram, &tsp->ts_write_histogram);
+    }
+    highresolutiontime(&now, NULL);
+    usecs = timer_diff(&tsp->ts_last_time, &now);
+    secs = (usecs) ? ((double)usecs / (double)uSECS_PER_SEC) : 1.0;
+    tsp->ts_last_time = now;
+
+    buffer = bp = Malloc(dip, STRING_BUFFER_SIZE);
+    if (buffer == NULL) return(FAILURE);
+    bp += sprintf(bp, "%ld.%03ld,%.3f," LUF "," LUF "," LUF "," LUF ",%.3f,%.3f,%.1f,%.1f,",
+		  (long)now.tv_sec, (long)(now.tv_usec / 1000),
+		  ((double)timer_diff(&tsp->ts_start_time, &now) / (double)uSECS_PER_SEC),
+		  (large_t)read_bytes, (large_t)write_bytes, (large_t)read_ops, (large_t)write_ops,
+		  ((double)read_bytes / secs) / (double)MBYTE_SIZE,
+		  ((double)write_bytes / secs) / (double)MBYTE_SIZE,
+		  (double)read_ops / secs, (double)write_ops / secs);
+    bp += format_latency_csv(bp, &tsp->ts_read_histogram, &tsp->ts_write_histogram);
+    bp += sprintf(bp, ",%lu,%lu\n", errors, noprogs);
+    if ( (fputs(buffer, tsp->ts_fp) == EOF) || (fflush(tsp->ts_fp) == EOF) ) {
+	Perror(dip, "Failed writing time series file %s", tsp->ts_file);
+	Free(dip, buffer);
+	return(FAILURE);
+    }
+    Free(dip, buffer);
+    return(SUCCESS);
+}
+
+/*
+ * time_series_thread() - The Time Series Recorder Thread.
+ *
+ * Description:
+ *	Samples at fixed interval deadlines, so the time spent sampling does
+ * not drift the intervals. The wait is on a condition variable, so when the
+ * job ends we are woken immediately, and take one final sample so the tail
+ * end of the job is recorded too (with rates based on the partial interval).
+ */
+static void *
+time_series_thread(void *arg)
+{
+    time_series_t *tsp = arg;
+    dinfo_t *dip = master_dinfo;
+    uint64_t deadline = 0, usecs;
+    struct timespec abstime;
+    int status = SUCCESS;
+
+    (void)pthread_mutex_lock(&tsp->ts_lock);
+    while ( (tsp->ts_stop == False) && (status == SUCCESS) ) {
+	deadline += ((uint64_t)tsp->ts_interval * uSECS_PERmSEC);
+	usecs = (uint64_t)tsp->ts_start_time.tv_usec + deadline;
+	abstime.tv_sec = tsp->ts_start_time.tv_sec + (time_t)(usecs / uSECS_PER_SEC);
+	abstime.tv_nsec = (long)((usecs % uSECS_PER_SEC) * 1000);
+	while (tsp->ts_stop == False) {
+	    if (pthread_cond_timedwait(&tsp->ts_cond, &tsp->ts_lock, &abstime) == ETIMEDOUT) {
+		break;
+	    }
+	}
+	if (tsp->ts_stop == True) break;
+	(void)pthread_mutex_unlock(&tsp->ts_lock);
+	status = sample_time_series(dip, tsp);
+	(void)pthread_mutex_lock(&tsp->ts_lock);
+    }
+    (void)pthread_mutex_unlock(&tsp->ts_lock);
+    if (status == SUCCESS) {
+	(void)sample_time_series(dip, tsp);
+    }
+    return(NULL);
+}
+
+/*
+ * create_time_series() - Create the Time Series File for a Job.
+ *
+ * Description:
+ *	The file name is formatted like the job log, so with multiple devices
+ * the job postfix is added unless the user specified their own via "%".
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	job = The job information pointer.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+int
+create_time_series(dinfo_t *dip, job_info_t *job)
+{
+    char logfmt[STRING_BUFFER_SIZE];
+    char *path = logfmt;
+    char *bp;
+    time_series_t *tsp;
+    int status;
+
+    if (dip->di_ts_file == NULL) return(SUCCESS);
+
+    status = setup_log_directory(dip, path, dip->di_ts_file);
+    if (status == FAILURE) {
+	return (status);
+    }
+    if (dip->di_num_devs > 1) {
+	if ( strstr(dip->di_ts_file, "%") == (char *) 0 ) {
+	    strcat(path, dip->di_file_sep);
+	    strcat(path, DEFAULT_JOBLOG_POSTFIX);
+	}
+    }
+    tsp = Malloc(dip, sizeof(*tsp));
+    if (tsp == NULL) return(FAILURE);
+    tsp->ts_file = FmtLogFile(dip, path, True);
+    tsp->ts_interval = (dip->di_ts_interval) ? dip->di_ts_interval : DEFAULT_TS_INTERVAL;
+    if (dip->di_debug_flag || dip->di_fDebugFlag) {
+	Printf(dip, "Job %u, time series file is %s...\n",
+	       job->ji_job_id, tsp->ts_file);
+    }
+    tsp->ts_fp = fopen(tsp->ts_file, "w");
+    if (tsp->ts_fp == NULL) {
+	Perror(dip, "fopen() of %s failed", tsp->ts_file);
+	FreeStr(dip, tsp->ts_file);
+	Free(dip, tsp);
+	return(FAILURE);
+    }
+    job->ji_time_series = tsp;
+    bp = logfmt;
+    bp += sprintf(bp, "time,elapsed,read_bytes,write_bytes,read_ops,write_ops,"
+		      "read_mbps,write_mbps,read_iops,write_iops,");
+    bp += format_latency_csv_header(bp);
+    bp += sprintf(bp, ",errors,noprogs\n");
+    if (fputs(logfmt, tsp->ts_fp) == EOF) {
+	Perror(dip, "Failed writing time series file %s", tsp->ts_file);
+	return(FAILURE);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * start_time_series() - Start the Time Series Recorder Thread.
+ *
+ * Description:
+ *	Called once the job threads are created, but before they are released
+ * to start their I/O, so the first interval begins with the job.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	job = The job information pointer.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+int
+start_time_series(dinfo_t *dip, job_info_t *job)
+{
+    time_series_t *tsp = job->ji_time_series;
+    threads_info_t *tip = job->ji_tinfo;
+    int status;
+
+    if ( (tsp == NULL) || (tip == NULL) || (tip->ti_threads == 0) ) {
+	return(SUCCESS);
+    }
+    tsp->ts_threads = tip->ti_threads;
+    tsp->ts_dts = tip->ti_dts;
+    tsp->ts_samples = Malloc(dip, (sizeof(ts_thread_t) * tsp->ts_threads));
+    if (tsp->ts_samples == NULL) return(FAILURE);
+    if ( (status = pthread_mutex_init(&tsp->ts_lock, NULL)) != SUCCESS) {
+	tPerror(dip, status, "pthread_mutex_init() of time series lock failed");
+	return(FAILURE);
+    }
+    if ( (status = pthread_cond_init(&tsp->ts_cond, NULL)) != SUCCESS) {
+	tPerror(dip, status, "pthread_cond_init() of time series condition failed");
+	(void)pthread_mutex_destroy(&tsp->ts_lock);
+	return(FAILURE);
+    }
+    highresolutiontime(&tsp->ts_start_time, NULL);
+    tsp->ts_last_time = tsp->ts_start_time;
+    status = pthread_create( &tsp->ts_thread_id, tjattrp, time_series_thread, tsp );
+    if (status != SUCCESS) {
+	tPerror(dip, status, "pthread_create() of time series thread failed");
+	(void)pthread_cond_destroy(&tsp->ts_cond);
+	(void)pthread_mutex_destroy(&tsp->ts_lock);
+	return(FAILURE);
+    }
+    tsp->ts_started = True;
+    return(SUCCESS);
+}
+
+/*
+ * stop_time_series() - Stop the Time Series Recorder and Free Resources.
+ *
+ * Description:
+ *	This must be called before the job threads are freed, since the
+ * recorder references their device information. Safe to call repeatedly.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	job = The job information pointer.
+ *
+ * Return Value:
+ *	void
+ */
+void
+stop_time_series(dinfo_t *dip, job_info_t *job)
+{
+    time_series_t *tsp = job->ji_time_series;
+    int thread, status;
+
+    if (tsp == NULL) return;
+    job->ji_time_series = NULL;
+    if (tsp->ts_started == True) {
+	(void)pthread_mutex_lock(&tsp->ts_lock);
+	tsp->ts_stop = True;
+	(void)pthread_cond_signal(&tsp->ts_cond);
+	(void)pthread_mutex_unlock(&tsp->ts_lock);
+	status = pthread_join(tsp->ts_thread_id, NULL);
+	if (status != SUCCESS) {
+	    tPerror(dip, status, "pthread_join() of time series thread failed");
+	}
+	(void)pthread_cond_destroy(&tsp->ts_cond);
+	(void)pthread_mutex_destroy(&tsp->ts_lock);
+    }
+    if (tsp->ts_fp) {
+	if (fclose(tsp->ts_fp) == EOF) {
+	    Perror(dip, "fclose() of %s failed", tsp->ts_file);
+	}
+    }
+    if (tsp->ts_samples) {
+	for (thread = 0; (thread < tsp->ts_threads); thread++) {
+	    ts_thread_t *ttp = &tsp->ts_samples[thread];
+	    if (ttp->tt_read_histogram) Free(dip, ttp->tt_read_histogram);
+	    if (ttp->tt_write_histogram) Free(dip, ttp->tt_write_histogram);
+	}
+	Free(dip, tsp->ts_samples);
+    }
+    FreeStr(dip, tsp->ts_file);
+    Free(dip, tsp);
+    return;
+}
@@ -0,0 +1,679 @@
+/****************************************************************************
+ *      								    *
+ *      		  COPYRIGHT (c) 1988 - 2026     		    *
+ *      		   This Software Provided       		    *
+ *      			     By 				    *
+ *      		  Robin's Nest Software Inc.    		    *
+ *      								    *
+ * Permission to use, copy, modify, distribute and sell this software and   *
+ * its documentation for any purpose and without fee is hereby granted,     *
+ * provided that the above copyright notice appear in all copies and that   *
+ * both that copyright notice and this permission notice appear in the      *
+ * supporting documentation, and that the name of the author not be used    *
+ * in advertising or publicity pertaining to distribution of the software   *
+ * without specific, written prior permission.  			    *
+ *      								    *
+ * THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE,        *
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN      *
+ * NO EVENT SHALL HE BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL   *
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR    *
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS  *
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF   *
+ * THIS SOFTWARE.       						    *
+ *      								    *
+ ****************************************************************************/
+/*
+ * Module:      dtsimd.c
+ * Author:      Robin T. Miller
+ * Date:	October 15th, 2026
+ *
+ * Description:
+ *      Vector (SIMD) support functions for data pattern processing.
+ *
+ *	The CPU vector capabilities are detected once at startup, and the
+ * widest supported kernel is selected at runtime. This allows a single dt
+ * binary to run on older CPU's, while using AVX2 when the CPU supports it.
+ * For non-x86 architectures (or compilers), the generic C kernels are used.
+ *
+ * Modification History:
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the arithmetic sequence kernels, used for the IOT pattern.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the CRC-32 carry-less multiply (PCLMULQDQ) folding kernel.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the data compare kernels, used by the verify fast paths.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Initial creation, with the pattern fill (stamping) kernels.
+ */
+#include "dt.h"
+
+#if defined(SIMD_X86)
+#  include <immintrin.h>
+#endif /* defined(SIMD_X86) */
+
+/*
+ * The detected (runtime) vector type, and the names for display.
+ */
+simd_type_t simd_type = SIMD_NONE;
+hbool_t simd_crc32_flag = False;	/* PCLMULQDQ CRC-32 folding.	*/
+static hbool_t simd_initialized = False;
+
+static char *simd_names[] = {
+    "none",			/* SIMD_NONE */
+    "sse2",			/* SIMD_SSE2 */
+    "avx2"			/* SIMD_AVX2 */
+};
+
+/*
+ * Forward References:
+ */
+static void generic_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static hbool_t generic_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static uint32_t generic_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+static hbool_t generic_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+#if defined(SIMD_X86)
+static void sse2_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static void avx2_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static hbool_t sse2_compare_buffers(uint8_t *aptr, uint8_t *bptr, size_t count);
+static hbool_t avx2_compare_buffers(uint8_t *aptr, uint8_t *bptr, size_t count);
+static hbool_t sse2_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static hbool_t avx2_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern);
+static uint32_t sse2_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+static uint32_t avx2_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+static hbool_t sse2_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+static hbool_t avx2_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step);
+#endif /* defined(SIMD_X86) */
+
+/*
+ * simd_initialize() - Detect the CPU vector capabilities.
+ *
+ * Description:
+ *	This is called once at startup, before any threads are created,
+ * so no locking is required. The DT_SIMD environment variable may be
+ * used to restrict the vector type (none, sse2), useful for comparing kernels.
+ *
+ * Return Value:
+ *	void
+ */
+void
+simd_initialize(void)
+{
+    char *p;
+
+    if (simd_initialized == True) return;
+    simd_initialized = True;
+#if defined(SIMD_X86)
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("avx2") ) {
+	simd_type = SIMD_AVX2;
+    } else if ( __builtin_cpu_supports("sse2") ) {
+	simd_type = SIMD_SSE2;
+    }
+    if ( __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1") ) {
+	simd_crc32_flag = True;
+    }
+#endif /* defined(SIMD_X86) */
+    if (p = getenv(SIMD_ENVNAME)) {
+	simd_type_t type;
+	for (type = SIMD_NONE; type < simd_type; type++) {
+	    if (EQ(p, simd_names[type])) {
+		simd_type = type;
+		break;
+	    }
+	}
+	if (simd_type == SIMD_NONE) {
+	    simd_crc32_flag = False;
+	}
+    }
+    return;
+}
+
+char *
+simd_type_name(simd_type_t type)
+{
+    if ((int)type > (int)SIMD_AVX2) type = SIMD_NONE;
+    return( simd_names[type] );
+}
+
+/*
+ * simd_fill_periodic() - Fill Buffer with a Periodic Pattern.
+ *
+ * Description:
+ *	The pattern must be periodic within SIMD_PATTERN_SPAN bytes, that
+ * is, the pattern size must evenly divide the span (1, 2, 4, 8, 16, 32).
+ * The pattern is loaded into a vector register once, then stamped with
+ * wide stores. The caller replicates the pattern at the proper phase.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	bptr = The buffer to fill (alignment not required).
+ *	count = The number of bytes to fill.
+ *	pattern = Pointer to SIMD_PATTERN_SPAN bytes of pattern.
+ *
+ * Return Value:
+ *	void
+ */
+void
+simd_fill_periodic(dinfo_t *dip, uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+#if defined(SIMD_X86)
+    if (dip->di_simd_flag == True) {
+	if (simd_type == SIMD_AVX2) {
+	    avx2_fill_periodic(bptr, count, pattern);
+	    return;
+	} else if (simd_type == SIMD_SSE2) {
+	    sse2_fill_periodic(bptr, count, pattern);
+	    return;
+	}
+    }
+#endif /* defined(SIMD_X86) */
+    generic_fill_periodic(bptr, count, pattern);
+    return;
+}
+
+static void
+generic_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    while (count >= SIMD_PATTERN_SPAN) {
+	memcpy(bptr, pattern, SIMD_PATTERN_SPAN);
+	bptr += SIMD_PATTERN_SPAN;
+	count -= SIMD_PATTERN_SPAN;
+    }
+    if (count) {
+	memcpy(bptr, pattern, count);
+    }
+    return;
+}
+
+/*
+ * simd_compare_buffers() - Compare Two Buffers for Equality.
+ *
+ * Description:
+ *	This is an equality check only, the caller is expected to locate
+ * the mismatch (byte by byte) for reporting, which is the uncommon case.
+ *
+ * Return Value:
+ *	Returns True if the buffers are equal, else False.
+ */
+hbool_t
+simd_compare_buffers(dinfo_t *dip, uint8_t *aptr, uint8_t *bptr, size_t count)
+{
+#if defined(SIMD_X86)
+    if (dip->di_simd_flag == True) {
+	if (simd_type == SIMD_AVX2) {
+	    return( avx2_compare_buffers(aptr, bptr, count) );
+	} else if (simd_type == SIMD_SSE2) {
+	    return( sse2_compare_buffers(aptr, bptr, count) );
+	}
+    }
+#endif /* defined(SIMD_X86) */
+    return( (memcmp(aptr, bptr, count) == 0) ? True : False );
+}
+
+/*
+ * simd_compare_periodic() - Compare Buffer with a Periodic Pattern.
+ *
+ * Description:
+ *	The pattern requirements are the same as simd_fill_periodic().
+ *
+ * Return Value:
+ *	Returns True if the buffer matches the pattern, else False.
+ */
+hbool_t
+simd_compare_periodic(dinfo_t *dip, uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+#if defined(SIMD_X86)
+    if (dip->di_simd_flag == True) {
+	if (simd_type == SIMD_AVX2) {
+	    return( avx2_compare_periodic(bptr, count, pattern) );
+	} else if (simd_type == SIMD_SSE2) {
+	    return( sse2_compare_periodic(bptr, count, pattern) );
+	}
+    }
+#endif /* defined(SIMD_X86) */
+    return( generic_compare_periodic(bptr, count, pattern) );
+}
+
+static hbool_t
+generic_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    while (count >= SIMD_PATTERN_SPAN) {
+	if (memcmp(bptr, pattern, SIMD_PATTERN_SPAN) != 0) return(False);
+	bptr += SIMD_PATTERN_SPAN;
+	count -= SIMD_PATTERN_SPAN;
+    }
+    if ( count && (memcmp(bptr, pattern, count) != 0) ) {
+	return(False);
+    }
+    return(True);
+}
+
+/*
+ * simd_fill_sequence() - Fill Words with an Arithmetic Sequence.
+ *
+ * Description:
+ *	Each 32-bit word is computed directly as (value + (index * step)),
+ * which is the IOT pattern within a logical block. The vector kernels keep
+ * several words in flight, adding (lanes * step) to every lane per store.
+ * The words are stored in host byte order.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	wptr = The word buffer to fill (alignment not required).
+ *	words = The number of 32-bit words to fill.
+ *	value = The first word value.
+ *	step = The value added for each following word.
+ *
+ * Return Value:
+ *	Returns the next word value (value + (words * step)).
+ */
+uint32_t
+simd_fill_sequence(dinfo_t *dip, uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+#if defined(SIMD_X86)
+    if (dip->di_simd_flag == True) {
+	if (simd_type == SIMD_AVX2) {
+	    return( avx2_fill_sequence(wptr, words, value, step) );
+	} else if (simd_type == SIMD_SSE2) {
+	    return( sse2_fill_sequence(wptr, words, value, step) );
+	}
+    }
+#endif /* defined(SIMD_X86) */
+    return( generic_fill_sequence(wptr, words, value, step) );
+}
+
+static uint32_t
+generic_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    while (words--) {
+	*wptr++ = value;
+	value += step;
+    }
+    return(value);
+}
+
+/*
+ * simd_compare_sequence() - Compare Words with an Arithmetic Sequence.
+ *
+ * Description:
+ *	The expected words are computed in registers, as done by the fill,
+ * so no expected data buffer is read (or written) during the compare.
+ *
+ * Return Value:
+ *	Returns True if all words match the sequence, else False.
+ */
+hbool_t
+simd_compare_sequence(dinfo_t *dip, uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+#if defined(SIMD_X86)
+    if (dip->di_simd_flag == True) {
+	if (simd_type == SIMD_AVX2) {
+	    return( avx2_compare_sequence(wptr, words, value, step) );
+	} else if (simd_type == SIMD_SSE2) {
+	    return( sse2_compare_sequence(wptr, words, value, step) );
+	}
+    }
+#endif /* defined(SIMD_X86) */
+    return( generic_compare_sequence(wptr, words, value, step) );
+}
+
+static hbool_t
+generic_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    while (words--) {
+	if (*wptr++ != value) return(False);
+	value += step;
+    }
+    return(True);
+}
+
+#if defined(SIMD_X86)
+
+__attribute__((target("sse2")))
+static void
+sse2_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    __m128i v0 = _mm_loadu_si128((__m128i *)pattern);
+    __m128i v1 = _mm_loadu_si128((__m128i *)(pattern + 16));
+
+    /* Note: Two registers, since the pattern may be 32 byte periodic. */
+    while (count >= 64) {
+	_mm_storeu_si128((__m128i *)bptr, v0);
+	_mm_storeu_si128((__m128i *)(bptr + 16), v1);
+	_mm_storeu_si128((__m128i *)(bptr + 32), v0);
+	_mm_storeu_si128((__m128i *)(bptr + 48), v1);
+	bptr += 64;
+	count -= 64;
+    }
+    if (count >= SIMD_PATTERN_SPAN) {
+	_mm_storeu_si128((__m128i *)bptr, v0);
+	_mm_storeu_si128((__m128i *)(bptr + 16), v1);
+	bptr += SIMD_PATTERN_SPAN;
+	count -= SIMD_PATTERN_SPAN;
+    }
+    if (count) {
+	memcpy(bptr, pattern, count);
+    }
+    return;
+}
+
+__attribute__((target("avx2")))
+static void
+avx2_fill_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    __m256i v = _mm256_loadu_si256((__m256i *)pattern);
+
+    while (count >= (sizeof(v) * 4)) {
+	_mm256_storeu_si256((__m256i *)bptr, v);
+	_mm256_storeu_si256((__m256i *)(bptr + 32), v);
+	_mm256_storeu_si256((__m256i *)(bptr + 64), v);
+	_mm256_storeu_si256((__m256i *)(bptr + 96), v);
+	bptr += (sizeof(v) * 4);
+	count -= (sizeof(v) * 4);
+    }
+    while (count >= sizeof(v)) {
+	_mm256_storeu_si256((__m256i *)bptr, v);
+	bptr += sizeof(v);
+	count -= sizeof(v);
+    }
+    if (count) {
+	memcpy(bptr, pattern, count);
+    }
+    return;
+}
+
+/*
+ * The compare kernels accumulate the differences (XOR) across an unrolled
+ * group of vectors, then test once per group, to keep the loop branch free.
+ */
+__attribute__((target("sse2")))
+static hbool_t
+sse2_compare_buffers(uint8_t *aptr, uint8_t *bptr, size_t count)
+{
+    __m128i zero = _mm_setzero_si128();
+
+    while (count >= 64) {
+	__m128i d0 = _mm_xor_si128(_mm_loadu_si128((__m128i *)aptr),
+				   _mm_loadu_si128((__m128i *)bptr));
+	__m128i d1 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(aptr + 16)),
+				   _mm_loadu_si128((__m128i *)(bptr + 16)));
+	__m128i d2 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(aptr + 32)),
+				   _mm_loadu_si128((__m128i *)(bptr + 32)));
+	__m128i d3 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(aptr + 48)),
+				   _mm_loadu_si128((__m128i *)(bptr + 48)));
+	__m128i d = _mm_or_si128(_mm_or_si128(d0, d1), _mm_or_si128(d2, d3));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero)) != 0xFFFF) return(False);
+	aptr += 64; bptr += 64;
+	count -= 64;
+    }
+    return( (memcmp(aptr, bptr, count) == 0) ? True : False );
+}
+
+__attribute__((target("avx2")))
+static hbool_t
+avx2_compare_buffers(uint8_t *aptr, uint8_t *bptr, size_t count)
+{
+    while (count >= 128) {
+	__m256i d0 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)aptr),
+				      _mm256_loadu_si256((__m256i *)bptr));
+	__m256i d1 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(aptr + 32)),
+				      _mm256_loadu_si256((__m256i *)(bptr + 32)));
+	__m256i d2 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(aptr + 64)),
+				      _mm256_loadu_si256((__m256i *)(bptr + 64)));
+	__m256i d3 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(aptr + 96)),
+				      _mm256_loadu_si256((__m256i *)(bptr + 96)));
+	__m256i d = _mm256_or_si256(_mm256_or_si256(d0, d1), _mm256_or_si256(d2, d3));
+	if ( !_mm256_testz_si256(d, d) ) return(False);
+	aptr += 128; bptr += 128;
+	count -= 128;
+    }
+    return( (memcmp(aptr, bptr, count) == 0) ? True : False );
+}
+
+__attribute__((target("sse2")))
+static hbool_t
+sse2_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    __m128i v0 = _mm_loadu_si128((__m128i *)pattern);
+    __m128i v1 = _mm_loadu_si128((__m128i *)(pattern + 16));
+    __m128i zero = _mm_setzero_si128();
+
+    while (count >= 64) {
+	__m128i d0 = _mm_xor_si128(_mm_loadu_si128((__m128i *)bptr), v0);
+	__m128i d1 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(bptr + 16)), v1);
+	__m128i d2 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(bptr + 32)), v0);
+	__m128i d3 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(bptr + 48)), v1);
+	__m128i d = _mm_or_si128(_mm_or_si128(d0, d1), _mm_or_si128(d2, d3));
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero)) != 0xFFFF) return(False);
+	bptr += 64;
+	count -= 64;
+    }
+    return( generic_compare_periodic(bptr, count, pattern) );
+}
+
+__attribute__((target("avx2")))
+static hbool_t
+avx2_compare_periodic(uint8_t *bptr, size_t count, uint8_t *pattern)
+{
+    __m256i v = _mm256_loadu_si256((__m256i *)pattern);
+
+    while (count >= 128) {
+	__m256i d0 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)bptr), v);
+	__m256i d1 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(bptr + 32)), v);
+	__m256i d2 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(bptr + 64)), v);
+	__m256i d3 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(bptr + 96)), v);
+	__m256i d = _mm256_or_si256(_mm256_or_si256(d0, d1), _mm256_or_si256(d2, d3));
+	if ( !_mm256_testz_si256(d, d) ) return(False);
+	bptr += 128;
+	count -= 128;
+    }
+    return( generic_compare_periodic(bptr, count, pattern) );
+}
+
+/*
+ * The sequence kernels start with lanes (value, value+step, ...), and each
+ * vector step adds (lanes * step), with 32-bit wraparound like the C code.
+ */
+__attribute__((target("sse2")))
+static uint32_t
+sse2_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    __m128i v0 = _mm_setr_epi32((int)value, (int)(value + step),
+				(int)(value + (step * 2)), (int)(value + (step * 3)));
+    __m128i inc = _mm_set1_epi32((int)(step * 4));
+    __m128i v1 = _mm_add_epi32(v0, inc);
+    __m128i inc2 = _mm_add_epi32(inc, inc);
+
+    while (words >= 8) {
+	_mm_storeu_si128((__m128i *)wptr, v0);
+	_mm_storeu_si128((__m128i *)(wptr + 4), v1);
+	v0 = _mm_add_epi32(v0, inc2);
+	v1 = _mm_add_epi32(v1, inc2);
+	wptr += 8;
+	words -= 8;
+	value += (step * 8);
+    }
+    return( generic_fill_sequence(wptr, words, value, step) );
+}
+
+__attribute__((target("avx2")))
+static uint32_t
+avx2_fill_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    __m256i v0 = _mm256_add_epi32(_mm256_set1_epi32((int)value),
+				  _mm256_mullo_epi32(_mm256_set1_epi32((int)step),
+						     _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    __m256i inc = _mm256_set1_epi32((int)(step * 8));
+    __m256i v1 = _mm256_add_epi32(v0, inc);
+    __m256i inc2 = _mm256_add_epi32(inc, inc);
+
+    while (words >= 16) {
+	_mm256_storeu_si256((__m256i *)wptr, v0);
+	_mm256_storeu_si256((__m256i *)(wptr + 8), v1);
+	v0 = _mm256_add_epi32(v0, inc2);
+	v1 = _mm256_add_epi32(v1, inc2);
+	wptr += 16;
+	words -= 16;
+	value += (step * 16);
+    }
+    return( generic_fill_sequence(wptr, words, value, step) );
+}
+
+__attribute__((target("sse2")))
+static hbool_t
+sse2_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    __m128i v0 = _mm_setr_epi32((int)value, (int)(value + step),
+				(int)(value + (step * 2)), (int)(value + (step * 3)));
+    __m128i inc = _mm_set1_epi32((int)(step * 4));
+    __m128i v1 = _mm_add_epi32(v0, inc);
+    __m128i inc2 = _mm_add_epi32(inc, inc);
+    __m128i zero = _mm_setzero_si128();
+
+    while (words >= 8) {
+	__m128i d0 = _mm_xor_si128(_mm_loadu_si128((__m128i *)wptr), v0);
+	__m128i d1 = _mm_xor_si128(_mm_loadu_si128((__m128i *)(wptr + 4)), v1);
+	__m128i d = _mm_or_si128(d0, d1);
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(d, zero)) != 0xFFFF) return(False);
+	v0 = _mm_add_epi32(v0, inc2);
+	v1 = _mm_add_epi32(v1, inc2);
+	wptr += 8;
+	words -= 8;
+	value += (step * 8);
+    }
+    return( generic_compare_sequence(wptr, words, value, step) );
+}
+
+__attribute__((target("avx2")))
+static hbool_t
+avx2_compare_sequence(uint32_t *wptr, size_t words, uint32_t value, uint32_t step)
+{
+    __m256i v0 = _mm256_add_epi32(_mm256_set1_epi32((int)value),
+				  _mm256_mullo_epi32(_mm256_set1_epi32((int)step),
+						     _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+    __m256i inc = _mm256_set1_epi32((int)(step * 8));
+    __m256i v1 = _mm256_add_epi32(v0, inc);
+    __m256i inc2 = _mm256_add_epi32(inc, inc);
+
+    while (words >= 16) {
+	__m256i d0 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)wptr), v0);
+	__m256i d1 = _mm256_xor_si256(_mm256_loadu_si256((__m256i *)(wptr + 8)), v1);
+	__m256i d = _mm256_or_si256(d0, d1);
+	if ( !_mm256_testz_si256(d, d) ) return(False);
+	v0 = _mm256_add_epi32(v0, inc2);
+	v1 = _mm256_add_epi32(v1, inc2);
+	wptr += 16;
+	words -= 16;
+	value += (step * 16);
+    }
+    return( generic_compare_sequence(wptr, words, value, step) );
+}
+
+/*
+ * simd_crc32_fold() - CRC-32 using Carry-less Multiply Folding.
+ *
+ * Description:
+ *	This is the folding algorithm from the Intel paper "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction", using
+ * the bit-reflected constants for the zlib CRC-32 polynomial (0xEDB88320).
+ * Four 128-bit lanes are folded in parallel 64 bytes at a time, then folded
+ * into one lane, and finally Barrett reduced to 32 bits.
+ *
+ * Inputs:
+ *	crc = The current (pre-inverted) CRC value.
+ *	bptr = The data buffer.
+ *	count = The byte count, >= 64 and a multiple of 16 bytes.
+ *
+ * Return Value:
+ *	Returns the updated (pre-inverted) CRC value.
+ */
+__attribute__((target("pclmul,sse4.1")))
+uint32_t
+simd_crc32_fold(uint32_t crc, uint8_t *bptr, size_t count)
+{
+    static const uint64_t k1k2[] __attribute__((aligned(16))) = { 0x0154442bd4, 0x01c6e41596 };
+    static const uint64_t k3k4[] __attribute__((aligned(16))) = { 0x01751997d0, 0x00ccaa009e };
+    static const uint64_t k5k0[] __attribute__((aligned(16))) = { 0x0163cd6124, 0x0000000000 };
+    static const uint64_t poly[] __attribute__((aligned(16))) = { 0x01db710641, 0x01f7011641 };
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128((__m128i *)(bptr + 0x00));
+    x2 = _mm_loadu_si128((__m128i *)(bptr + 0x10));
+    x3 = _mm_loadu_si128((__m128i *)(bptr + 0x20));
+    x4 = _mm_loadu_si128((__m128i *)(bptr + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_load_si128((__m128i *)k1k2);
+    bptr += 64;
+    count -= 64;
+
+    /* Parallel fold blocks of 64 bytes. */
+    while (count >= 64) {
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+	x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+	x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+	x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+	y5 = _mm_loadu_si128((__m128i *)(bptr + 0x00));
+	y6 = _mm_loadu_si128((__m128i *)(bptr + 0x10));
+	y7 = _mm_loadu_si128((__m128i *)(bptr + 0x20));
+	y8 = _mm_loadu_si128((__m128i *)(bptr + 0x30));
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+	x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+	x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+	x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+	bptr += 64;
+	count -= 64;
+    }
+
+    /* Fold into 128 bits. */
+    x0 = _mm_load_si128((__m128i *)k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* Single fold blocks of 16 bytes. */
+    while (count >= 16) {
+	x2 = _mm_loadu_si128((__m128i *)bptr);
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	bptr += 16;
+	count -= 16;
+    }
+
+    /* Fold 128 bits to 64 bits. */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64((__m128i *)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduce to 32 bits. */
+    x0 = _mm_load_si128((__m128i *)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return( (uint32_t)_mm_extract_epi32(x1, 1) );
+}
+
+#endif /* defined(SIMD_X86) */
@@ -29,6 +29,28 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Use the latency percentile tables from dtlatency.c.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Select random blocks from the random distribution (rdist=), and
+ * report the hot set coverage with the total statistics.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Replace the global sequential block cursor (and its mutex) with an
+ * atomic block ticket, where the pass (epoch) is the ticket divided by the
+ * block range, so wrapping is detected without a lock. Add -batch=<blocks>
+ * to claim several blocks per thread with each atomic operation.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Verify the sio patterns without allocating a (unused) pattern buffer,
+ * comparing each block with the vector sequence kernels, and only falling back
+ * to the per word checks (and reporting) when a block miscompares.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Record latencies in the per thread histograms, and report the global
+ * latency percentiles (p50 through p99.99) with the total statistics.
+ * 
  * November 9, 2021 by Chris Nelson (nelc@netapp.com)
  *  Add MIT license, in order to distribute to FOSS community so it can
  *  be used and maintained by a larger audience, particularly for the
@@ -128,6 +150,7 @@
 #define SIO_DEFAULT_FILE_PER_THREAD False
 #define SIO_DEFAULT_FIXED_FILL      -1
 #define SIO_DEFAULT_IOMUTEX         False
+#define SIO_DEFAULT_BATCH_BLOCKS    1
 #define SIO_DEFAULT_LOCKALL         False
 #define SIO_DEFAULT_NOFLOCK         False
 #define SIO_DEFAULT_INSTRUMENTATION False
@@ -193,6 +216,7 @@ typedef struct sio_parameters {
     int         verify_retry;
     size_t      max_blocks;
     size_t      max_blksize;
+    size_t      batch_blocks;
     int         max_latency;
     uint64_t    numops;
     /* Saved starting and ending block numbers. */
@@ -209,6 +233,9 @@ typedef struct sio_thread_info {
     BlockNum_t      begin_blk;
     BlockNum_t      end_blk;
     BlockNum_t      per_thread_curblk;
+    uint64_t        claim_next;     /* Next global block ticket claimed. */
+    uint64_t        claim_end;      /* End of global block tickets claimed. */
+    uint64_t        global_pass;    /* The last global pass (epoch) seen. */
     uint64_t        reads;
     uint64_t        bytes_read;
     uint64_t        writes;
@@ -228,10 +255,14 @@ typedef struct sio_thread_info {
     uint64_t        interval_sumofsquares_latency;
 } sio_thread_info_t;
 
+/*
+ * Note: The global block ticket is only ever incremented (atomically), the
+ * block is (begin + (ticket % blocks)) and the pass is (ticket / blocks).
+ */
 typedef struct sio_global_data {
     pthread_mutex_t global_lock;
-    BlockNum_t      global_curblk;
-    unsigned long   pass_count;
+    v_large         global_ticket;
+    uint64_t        base_pass;      /* The pass after the prefill. */
     hbool_t         fillonce_done;
 } sio_global_data_t;
 
@@ -254,6 +285,9 @@ typedef struct sio_total_stats {
     uint64_t    global_bytes_written;
     uint64_t    total_ios;
     uint64_t    total_latency;
+    latency_histogram_t *read_histogram;
+    latency_histogram_t *write_histogram;
+    random_dist_t       rdist;
 } sio_total_stats_t;
 
 /*
@@ -268,6 +302,7 @@ void sio_report_statistics(dinfo_t *dip, sio_total_stats_t *stp);
 void sio_report_thread_stats(dinfo_t *dip);
 void sio_pretty_thread_stats(dinfo_t *dip);
 void sio_report_total_stats(dinfo_t *dip, sio_total_stats_t *stp);
+void sio_report_latency_percentiles(dinfo_t *dip, sio_total_stats_t *stp, hbool_t pretty);
 void sio_pretty_total_stats(dinfo_t *dip, sio_total_stats_t *stp);
 void sio_initial_niceoutput(dinfo_t *dip, hbool_t flush_flag);
 void sio_init_data_buffer(dinfo_t *dip, sio_parameters_t *siop);
@@ -276,6 +311,8 @@ int sio_doio(dinfo_t *dip);
 int sio_dofillonce(dinfo_t *dip);
 void sio_reset_stats(dinfo_t *dip, sio_thread_info_t *stip);
 unsigned long int sio_get_usecs(struct timeval time2, struct timeval time1);
+hbool_t sio_compare_pattern_block(dinfo_t *dip, uint32_t *wptr, BlockNum_t blk_nbr,
+                                  size_t words, int dev_nbr, hbool_t instrumentation);
 int sio_check_pattern_buffer(dinfo_t *dip,
                              int target_device,
                              char *bufP, BlockNum_t offset, size_t iosize, 
@@ -306,6 +343,7 @@ hbool_t sio_global_sequential_block(dinfo_t *dip,
                                     sio_parameters_t *siop,
                                     sio_thread_info_t *stip,
                                     sio_global_data_t *sgdp);
+void sio_global_sequential_init(dinfo_t *dip, sio_thread_info_t *stip, sio_global_data_t *sgdp);
 int sio_verify_write(dinfo_t *dip, HANDLE fd, int target_device, uint64_t record,
                      BlockNum_t curblk, char *buffer, size_t blocksize, Offset_t offset);
 
@@ -527,6 +565,11 @@ sio_parser(dinfo_t *dip, char *option)
         siop->instrumentation = True;
         return(status);
     }
+    if (match(&option, "batch=")) {
+        siop->batch_blocks = (size_t)number(dip, option, ANY_RADIX, &status, True);
+        if (siop->batch_blocks == 0) siop->batch_blocks = 1;
+        return(status);
+    }
     if (match(&option, "iomutex")) {
         siop->iomutex = True;
         return(status);
@@ -644,9 +687,8 @@ sio_job_init(dinfo_t *dip, job_info_t *job)
             }
         }
         job->ji_opaque = sgdp;
-	if (dip->di_file_position) {
-	    sgdp->global_curblk = (dip->di_file_position / dip->di_block_size);
-	}
+	/* Note: The tickets are relative to each threads' beginning block. */
+	sgdp->global_ticket = 0;
         if (dip->di_debug_flag) {
             Printf(dip, "Global data space has been allocated, expect slower performance!\n");
         }
@@ -737,6 +779,8 @@ sio_job_finish(dinfo_t *dip, job_info_t *job)
     stp->global_compute_time_start = job->ji_threads_started;
     stp->global_compute_time_end = job->ji_job_end;
     stp->global_min_latency = SIO_DEFAULT_MIN_LATENCY;
+    stp->rdist = dip->di_rdist;
+    stp->rdist.rd_samples = stp->rdist.rd_hot_hits = 0;
 
     /*
      * Accumulate the total statistics.
@@ -759,12 +803,19 @@ sio_job_finish(dinfo_t *dip, job_info_t *job)
             stp->global_min_latency = stip->min_latency;
         }
         stp->combined_sumofsquares_latency += stip->sumofsquares_latency;
+        (void)merge_latency_histogram(dip, &stp->read_histogram, tdip->di_read_histogram);
+        (void)merge_latency_histogram(dip, &stp->write_histogram, tdip->di_write_histogram);
+        merge_random_distribution(&stp->rdist, &tdip->di_rdist);
 
         sio_report_thread_stats(tdip);
     }
     
     /* TODO: Query operation, master dip does *not* have sio pointers! */
-    if ( (siop == NULL) || (stip == NULL) ) return(SUCCESS);
+    if ( (siop == NULL) || (stip == NULL) ) {
+        if (stp->read_histogram) Free(dip, stp->read_histogram);
+        if (stp->write_histogram) Free(dip, stp->write_histogram);
+        return(SUCCESS);
+    }
 
     if (siop->no_performance == True) {
         Lprintf(dip, "\nNote: No performance statistics are printed for fillonce or random runs.\n");
@@ -773,6 +824,8 @@ sio_job_finish(dinfo_t *dip, job_info_t *job)
     } else {
         sio_report_total_stats(dip, stp);
     }
+    if (stp->read_histogram) Free(dip, stp->read_histogram);
+    if (stp->write_histogram) Free(dip, stp->write_histogram);
     if (dip->di_history_size && dip->di_history_dump) {
         dump_history_data(dip);
     }
@@ -1026,6 +1079,8 @@ sio_report_total_stats(dinfo_t *dip, sio_total_stats_t *stp)
     Lprintf(dip, " max(ms):       %10.2f\n", (stp->global_max_latency / 1000.0));
     Lprintf(dip, " avg(ms):       %10.2f\n", ((stp->total_latency / (double)stp->total_ios) / 1000.0));
     Lprintf(dip, " stddev:        %10.2lf\n", combined_stddev_latency);
+    sio_report_latency_percentiles(dip, stp, False);
+    report_random_distribution(dip, &stp->rdist);
     Lprintf(dip, "\n");
 
     Lprintf(dip, "global_reads = %llu; global_bytes_read = %llu (%llu KB)\n",
@@ -1076,6 +1131,32 @@ sio_report_total_stats(dinfo_t *dip, sio_total_stats_t *stp)
     return;
 }
 
+/*
+ * Report the global latency percentiles (reads and writes combined).
+ */
+void
+sio_report_latency_percentiles(dinfo_t *dip, sio_total_stats_t *stp, hbool_t pretty)
+{
+    char name[SMALL_BUFFER_SIZE];
+    int index;
+
+    if ( (stp->read_histogram == NULL) && (stp->write_histogram == NULL) ) {
+        return;
+    }
+    for (index = 0; index < LATENCY_PERCENTILES; index++) {
+        double latency = (double)latency_percentile(stp->read_histogram, stp->write_histogram,
+                                                    latency_percentiles[index]) / 1000.0;
+        (void)sprintf(name, "%s(ms)", latency_percentile_names[index]);
+        if (pretty == True) {
+            Lprintf(dip, DT_FIELD_WIDTH "%.2f\n", name, latency);
+        } else {
+            Lprintf(dip, " %s:%*s%10.2f\n", name,
+                    (int)(14 - strlen(name)), "", latency);
+        }
+    }
+    return;
+}
+
 void
 sio_initial_niceoutput(dinfo_t *dip, hbool_t flush_flag)
 {
@@ -1153,6 +1234,8 @@ sio_pretty_total_stats(dinfo_t *dip, sio_total_stats_t *stp)
     Lprintf(dip, DT_FIELD_WIDTH "%.2f\n",
             "avg(ms)", ((stp->total_latency / (double)stp->total_ios) / 1000.0));
     Lprintf(dip, DT_FIELD_WIDTH "%.2f\n", "stddev", combined_stddev_latency);
+    sio_report_latency_percentiles(dip, stp, True);
+    report_random_distribution(dip, &stp->rdist);
     Lprintf(dip, "\n");
     
     Lprintf(dip, DT_FIELD_WIDTH LUF "\n", "global reads", stp->global_reads);
@@ -1250,13 +1333,12 @@ sio_doio(dinfo_t *dip)
     hbool_t first_pass = True;
     int status = SUCCESS;
 
-    if (sgdp) {
-        curblk = sgdp->global_curblk;
-    } else {
-        curblk = stip->begin_blk;
-    }
+    curblk = stip->begin_blk;
     stip->per_thread_curblk = curblk;
     stip->latency = 0;
+    if (sgdp) {
+        sio_global_sequential_init(dip, stip, sgdp);
+    }
 
     while (True) {
         
@@ -1317,33 +1399,7 @@ sio_doio(dinfo_t *dip)
         } else {
             hbool_t wrapped = False;
             if (sgdp) {
-                //wrapped = sio_global_sequential_block(dip, &curblk, siop, stip, sgdp);
-#if 1
-                /*
-                 * Get next global sequential block number to use.
-                 */
-                if (siop->iomutex == True) {
-                    status = sio_acquire_global_lock(dip, sgdp);
-                }
-                curblk = sgdp->global_curblk++;
-                if (curblk >= stip->end_blk) {
-                    curblk = stip->begin_blk;
-                    dip->di_pass_count++;
-                    sgdp->pass_count++;
-                    sgdp->global_curblk = curblk;
-                    wrapped = True;
-                }
-                /* 
-                 * If another thread wrapped, adjust this thread too! 
-                 */
-                if (sgdp->pass_count > dip->di_pass_count) {
-                    wrapped = True;
-                    dip->di_pass_count++;
-                }
-                if ( (siop->iomutex == True) && (status == SUCCESS) ) {
-                    status = sio_release_global_lock(dip, sgdp);
-                }
-#endif /* 1 */
+                wrapped = sio_global_sequential_block(dip, &curblk, siop, stip, sgdp);
             } else { /* Single thread or partition_among_threads. */
                 //wrapped = sio_sequential_block(dip, &curblk, stip);
                 /* Note: Doing this inline improves performance! (~23% in my testing!) */
@@ -1472,6 +1528,7 @@ sio_doio(dinfo_t *dip)
             stip->min_latency = latency;
         }
         stip->latency += latency;
+        record_latency(dip, (reading) ? READ_OP : WRITE_OP, (uint64_t)latency);
 
         if (stip->io_completes) {
             /* 
@@ -1562,12 +1619,11 @@ sio_dofillonce(dinfo_t *dip)
     int pattern;
     int status = SUCCESS;
 
+    curblk = stip->begin_blk;
+    stip->per_thread_curblk = curblk;
     if (sgdp) {
-        curblk = sgdp->global_curblk;
-    } else {
-        curblk = stip->begin_blk;
+        sio_global_sequential_init(dip, stip, sgdp);
     }
-    stip->per_thread_curblk = curblk;
 
     if (dip->di_variable_flag == True) {
         cur_blk_sz = siop->max_blksize;
@@ -1596,19 +1652,9 @@ sio_dofillonce(dinfo_t *dip)
         if (sgdp) {
 	    /* This state is required for -prefill option! */
 	    if (sgdp->fillonce_done == True) break;
-            //wrapped = sio_global_sequential_block(dip, &curblk, siop, stip, sgdp);
-            curblk = sgdp->global_curblk++;
-            if (curblk >= stip->end_blk) {
-                curblk = stip->begin_blk;
-                dip->di_pass_count++;
-                sgdp->pass_count++;
-                sgdp->global_curblk = curblk;
-                wrapped = True;
-            }
-            if (sgdp->pass_count > dip->di_pass_count) {
-                dip->di_pass_count++;
-                wrapped = True;
-            }
+            wrapped = sio_global_sequential_block(dip, &curblk, siop, stip, sgdp);
+            /* The I/O (after prefill) starts with the next pass. */
+            if (wrapped == True) sgdp->base_pass = stip->global_pass;
         } else {
             //wrapped = sio_sequential_block(dip, &curblk, stip);
             curblk = stip->per_thread_curblk++;
@@ -1720,6 +1766,55 @@ sio_get_usecs(struct timeval time2, struct timeval time1)
     return(temp);
 }
 
+/*
+ * Name:    sio_compare_pattern_block
+ *
+ * Arguments:
+ *  wptr             The block words to verify.
+ *  blk_nbr          The block number, used in calculating the pattern.
+ *  words            The number of words in the block.
+ *  dev_nbr          The target device number.
+ *  instrumentation  The instrumentation (PATTERN_B) flag.
+ *
+ * Description:
+ *  Compares a block with the expected pattern, generating the pattern words
+ * in vector registers. Within a block, both patterns are arithmetic sequences
+ * (step 1), except PATTERN_A once the word number overlaps the device bits,
+ * in which case the words are checked one at a time (still no reporting).
+ *
+ * Return Value:
+ *  True if the block matches, else False (the caller reports miscompares).
+ */
+hbool_t
+sio_compare_pattern_block(dinfo_t *dip, uint32_t *wptr, BlockNum_t blk_nbr,
+                          size_t words, int dev_nbr, hbool_t instrumentation)
+{
+    uint32_t value, mask;
+    size_t word_nbr;
+
+    if ( (instrumentation == True) || (dip->di_variable_flag == True) ) {
+        value = (uint32_t)PATTERN_B(blk_nbr, 0, words);
+        if ( (instrumentation == False) || (words < 2) ) {
+            return( simd_compare_sequence(dip, wptr, words, value, 1) );
+        }
+        /* Note: The second word is not verified with instrumentation. */
+        if (wptr[0] != value) return(False);
+        return( simd_compare_sequence(dip, (wptr + 2), (words - 2), (value + 2), 1) );
+    }
+    value = (uint32_t)PATTERN_A(blk_nbr, 0, dev_nbr);
+    for (mask = 1; (mask < (uint32_t)words) && (mask < 0x10000); mask <<= 1) ;
+    if ( (words <= 0x10000) && ((value & (mask - 1)) == 0) ) {
+        /* The word number does not overlap, so the OR is an add! */
+        return( simd_compare_sequence(dip, wptr, words, value, 1) );
+    }
+    for (word_nbr = 0; (word_nbr < words); word_nbr++) {
+        if (wptr[word_nbr] != (uint32_t)PATTERN_A(blk_nbr, word_nbr, dev_nbr)) {
+            return(False);
+        }
+    }
+    return(True);
+}
+
 /*
  * Name:    sio_check_pattern_buffer
  *
@@ -1732,7 +1827,9 @@ sio_get_usecs(struct timeval time2, struct timeval time1)
  *  break_on_error   Exit the function on encountering the first error.
  *
  * Description:
- *  Verifies the buffer contents read back.
+ *  Verifies the buffer contents read back. Each block is compared as a
+ * whole, and only a miscomparing block is checked word by word to report
+ * the errors.
  */
 int
 sio_check_pattern_buffer(dinfo_t *dip,
@@ -1743,24 +1840,24 @@ sio_check_pattern_buffer(dinfo_t *dip,
     sio_information_t *sip = dip->di_opaque;
     sio_parameters_t *siop = &sip->sio_parameters;
     int word_nbr = 0;
-    int *tmpP = (int *) bufP;
+    int words = (int)(blocksize / sizeof(int));
+    int *blkP = (int *) bufP;
+    int *tmpP;
     BlockNum_t blk_nbr;
     int actual, pattern;
-    int *PREtmpP = (int *) bufP;
     int firsterror, isfirst = 0;
     hbool_t instrumentation = siop->instrumentation;
-    char *pattbuf;
     int errors = 0;
 
-    pattbuf = Malloc(dip, iosize * blocksize);
-    if (pattbuf == NULL) {
-        return(FAILURE);
-    }
     /* Allow for more than one pattern eventually */
-    for (blk_nbr = offset; blk_nbr < (offset + (Offset_t)iosize); blk_nbr++) {
+    for (blk_nbr = offset; blk_nbr < (offset + (Offset_t)iosize); blk_nbr++, blkP += words) {
         if ( THREAD_TERMINATING(dip) ) break;
-        for (word_nbr = 0; word_nbr < (int)(blocksize / sizeof(int)); word_nbr++) {
-            if ( THREAD_TERMINATING(dip) ) break;
+        if ( sio_compare_pattern_block(dip, (uint32_t *)blkP, blk_nbr, (size_t)words,
+                                       target_device, instrumentation) == True ) {
+            continue;
+        }
+        tmpP = blkP;
+        for (word_nbr = 0; word_nbr < words; word_nbr++) {
             actual = *tmpP;
             if ( (instrumentation == True) || (dip->di_variable_flag == True) ) {
                 pattern = (int)PATTERN_B(blk_nbr, word_nbr, (blocksize) / (sizeof(int)));
@@ -1783,15 +1880,14 @@ sio_check_pattern_buffer(dinfo_t *dip,
                     break;
                 }
             }
-            PREtmpP = tmpP;
             tmpP++;
         }    
     }
-    if ( (dip->di_trigger_control == TRIGGER_ON_ALL) ||
-	 (dip->di_trigger_control == TRIGGER_ON_MISCOMPARE) ) {
+    if ( errors &&
+	 ( (dip->di_trigger_control == TRIGGER_ON_ALL) ||
+	   (dip->di_trigger_control == TRIGGER_ON_MISCOMPARE) ) ) {
 	(void)ExecuteTrigger(dip, miscompare_op);
     }
-    Free(dip, pattbuf);
     return(errors);
 }
 
@@ -1822,15 +1918,14 @@ sio_check_fixed_val_buffer(dinfo_t *dip,
     u_char actual;
     int firsterror, isfirst = 0;
     int fixedfill_value = siop->fixedfill;
-    char *pattern;
+    uint8_t pattern[SIMD_PATTERN_SPAN];
     int errors = 0;
     int i = 0;
 
-    pattern = Malloc(dip, (iosize * blocksize));
-    if (pattern == NULL) {
-        return(FAILURE);
+    memset(pattern, value, sizeof(pattern));
+    if ( simd_compare_periodic(dip, (uint8_t *)bufP, (iosize * blocksize), pattern) == True ) {
+        return(errors);
     }
-
     /* Allow for more than one pattern eventually */
     for (i = 0; i < (int)(iosize * blocksize); i++) {
         if ( THREAD_TERMINATING(dip) ) break;
@@ -1857,7 +1952,6 @@ sio_check_fixed_val_buffer(dinfo_t *dip,
 	 (dip->di_trigger_control == TRIGGER_ON_MISCOMPARE) ) {
 	(void)ExecuteTrigger(dip, miscompare_op);
     }
-    Free(dip, pattern);
     return(errors);
 }
 
@@ -2021,7 +2115,10 @@ sio_random_block(dinfo_t *dip,
      * write past the size specified and/or read an EOF (which fails)!
      */ 
     blk_range_size = (stip->end_blk - stip->begin_blk);
-    if (blk_range_size) {
+    if (blk_range_size && (dip->di_rdist.rd_type != RDIST_UNIFORM) ) {
+	(*target) = (BlockNum_t)random_distribution_index(dip, (uint64_t)blk_range_size);
+	(*target) += stip->begin_blk;
+    } else if (blk_range_size) {
 	(*target) = (BlockNum_t)( RAND64(dip) % blk_range_size );
 	(*target) += stip->begin_blk;
     } else {
@@ -2054,6 +2151,41 @@ sio_sequential_block(dinfo_t *dip,
     return(wrapped);
 }
 
+/*
+ * sio_global_sequential_init() - Initialize the Global Sequential Claims.
+ *
+ * Description:
+ *    The thread starts at the base pass, so the prefill pass is not counted
+ * again. Note: Threads may start late, so the current ticket is *not* used!
+ */
+void
+sio_global_sequential_init(dinfo_t *dip, sio_thread_info_t *stip, sio_global_data_t *sgdp)
+{
+    stip->claim_next = stip->claim_end = 0;
+    stip->global_pass = sgdp->base_pass;
+    return;
+}
+
+/*
+ * sio_global_sequential_block() - Get the Next Global Sequential Block.
+ *
+ * Description:
+ *    Each thread claims block tickets with an atomic add (batch blocks at a
+ * time), so threads never wait on each other. Since the ticket is never
+ * reset, the pass (epoch) is the ticket divided by the block range, and a
+ * thread has wrapped when it sees a pass beyond the last pass it has seen,
+ * whether this thread or another thread crossed the end of the range.
+ *
+ * Inputs:
+ *    dip = The device information pointer.
+ *    target = The target block number pointer.
+ *    siop = The sio parameters.
+ *    stip = The sio thread information.
+ *    sgdp = The sio global data.
+ *
+ * Return Value:
+ *    Returns True if wrapped (a new pass), else False.
+ */
 hbool_t
 sio_global_sequential_block(dinfo_t *dip,
                             BlockNum_t *target,
@@ -2061,38 +2193,35 @@ sio_global_sequential_block(dinfo_t *dip,
                             sio_thread_info_t *stip,
                             sio_global_data_t *sgdp)
 {
-    register BlockNum_t curblk;
+    uint64_t blocks = (stip->end_blk - stip->begin_blk);
+    uint64_t ticket, pass;
     hbool_t wrapped = False;
-    int status = SUCCESS;
-
-    /* Note: Without the lock, the global data is racey! */
 
-    /*
-     * Get next global sequential block number to use.
-     */
-    if (siop->iomutex == True) {
-        status = sio_acquire_global_lock(dip, sgdp);
-    }
-    curblk = sgdp->global_curblk++;
-    if (curblk >= stip->end_blk) {
-        curblk = stip->begin_blk;
+    if (blocks == 0) {
+        *target = stip->begin_blk;
         dip->di_pass_count++;
-        sgdp->pass_count++;
-        sgdp->global_curblk = curblk;
-        wrapped = True;
+        return(True);
     }
-    *target = curblk;
-
-    /* 
-     * If another thread wrapped, adjust this thread too!
-     */
-    if (sgdp->pass_count > dip->di_pass_count) {
-        wrapped = True;
-        dip->di_pass_count++;
+    if (stip->claim_next == stip->claim_end) {
+        int status = SUCCESS;
+        /* Note: The mutex is no longer required, but kept for comparison. */
+        if (siop->iomutex == True) {
+            status = sio_acquire_global_lock(dip, sgdp);
+        }
+        stip->claim_next = os_atomic_fetch_add64(&sgdp->global_ticket, siop->batch_blocks);
+        stip->claim_end = (stip->claim_next + siop->batch_blocks);
+        if ( (siop->iomutex == True) && (status == SUCCESS) ) {
+            (void)sio_release_global_lock(dip, sgdp);
+        }
     }
-    if ( (siop->iomutex == True) && (status == SUCCESS) ) {
-        status = sio_release_global_lock(dip, sgdp);
+    ticket = stip->claim_next++;
+    pass = (ticket / blocks);
+    if (pass > stip->global_pass) {
+        dip->di_pass_count += (unsigned long)(pass - stip->global_pass);
+        stip->global_pass = pass;
+        wrapped = True;
     }
+    *target = (stip->begin_blk + (BlockNum_t)(ticket % blocks));
     return(wrapped);
 }
 
@@ -2543,6 +2672,7 @@ sio_initialize(dinfo_t *dip)
     siop->lockall           = SIO_DEFAULT_LOCKALL;
     siop->noflock           = SIO_DEFAULT_NOFLOCK;
     siop->iomutex           = SIO_DEFAULT_IOMUTEX;
+    siop->batch_blocks      = SIO_DEFAULT_BATCH_BLOCKS;
     siop->prefill           = UNINITIALIZED;
     siop->max_blocks        = SIO_DEFAULT_MAX_BLOCKS;
     siop->max_blksize       = SIO_DEFAULT_MAX_BLKSIZE;
@@ -2724,6 +2854,7 @@ sio_show_parameters(dinfo_t *dip)
         Lprintf(dip, "    fillonce...............: %d\n", siop->fillonce            );
         Lprintf(dip, "    fixedfill..............: %d\n", siop->fixedfill           );
         Lprintf(dip, "    iomutex................: %d\n", siop->iomutex             );
+        Lprintf(dip, "    batch_blocks...........: " SUF "\n", siop->batch_blocks  );
         Lprintf(dip, "    lockall................: %d\n", siop->lockall             );
         Lprintf(dip, "    max_blocks.............: " SUF "\n", siop->max_blocks     );
         Lprintf(dip, "    max_blksize............: " SUF "\n", siop->max_blksize    );
@@ -2906,6 +3037,7 @@ sio_help(dinfo_t *dip)
     //P(dip, "-openfailok               Ignore open failures (unless all opens fail).\n");
     P(dip, "    -iofailok             Allow I/O failures (do not access file again).\n");
     P(dip, "    -iomutex              Use mutex to synchronize multiple threads.\n");
+    P(dip, "    -batch=<blocks>       Blocks claimed per thread (global sequential).\n");
     //P(dip, "-nolseek                  Remove lseek on sequential reads.\n");
     P(dip, "    -fillonce             Write all files once, then stop.\n");
     P(dip, "    -prefill              Write all files prior to test I/O.\n");
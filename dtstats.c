@@ -31,6 +31,20 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Print %json keepalives without the "End of" text or message prefix.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Report the random distribution and its achieved hot set coverage.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add JSON statistics records (stats=json), one line per record, for
+ * the per pass, per thread total, and job statistics.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Report the latency percentiles, from the per thread histograms.
+ *      Fix accumulating the thread latency I/O counts (was doubling).
+ * 
  * October 23rd, 2025 by Robin T. Miller
  *      Add reporting of latency statistics.
  * 
@@ -89,6 +103,17 @@ static char *stats_names[] = {
 	"Verify",		/* VERIFY_STATS */
 	"Job"			/* JOB_STATS */
 };
+/* The JSON record types, indexed by stats type. */
+static char *json_stats_names[] = {
+	"copy",			/* COPY_STATS */
+	"read",			/* READ_STATS */
+	"raw",			/* RAW_STATS */
+	"write",		/* WRITE_STATS */
+	"total",		/* TOTAL_STATS */
+	"mirror",		/* MIRROR_STATS */
+	"verify",		/* VERIFY_STATS */
+	"job"			/* JOB_STATS */
+};
 static char *data_op_str = "Data operation performed";
 
 /*
@@ -251,6 +276,38 @@ init_stats(struct dinfo *dip)
     return;
 }
 
+/*
+ * report_keepalive() - Report a Pass Keepalive Message.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	stats_name = The stats name for "End of" text (optional).
+ *	keepalivefmt = The keepalive format control string.
+ *
+ * Note: JSON keepalives omit the "End of" text and message prefix, so
+ * each line is a valid JSON object.
+ */
+static void
+report_keepalive(dinfo_t *dip, char *stats_name, char *keepalivefmt)
+{
+    int flags = KeepAliveFlags(keepalivefmt);
+
+    if (flags & PRT_NOIDENT) {
+	if ( FmtKeepAlive(dip, keepalivefmt, dip->di_log_bufptr) ) {
+	    LogMsg(dip, dip->di_ofp, logLevelLog, flags, "%s\n", dip->di_log_bufptr);
+	}
+	*dip->di_log_bufptr = '\0';
+	return;
+    }
+    if (stats_name) {
+	Lprintf(dip, "End of %s ", stats_name);
+    }
+    dip->di_log_bufptr += FmtKeepAlive(dip, keepalivefmt, dip->di_log_bufptr);
+    Lprintf(dip, "\n");
+    Lflush(dip);
+    return;
+}
+
 /************************************************************************
  *									*
  * report_pass() - Report end of pass information.			*
@@ -267,7 +324,8 @@ report_pass(dinfo_t *dip, stats_t stats_type)
     gather_totals(dip);		/* Update the total statistics. */
 
     if (dip->di_stats_level != STATS_NONE) {
-	if (dip->di_pstats_flag && (dip->di_stats_level == STATS_FULL) ) {
+	if ( dip->di_pstats_flag &&
+	     ((dip->di_stats_level == STATS_FULL) || (dip->di_stats_level == STATS_JSON)) ) {
 	    if (dip->di_stats_flag) {
 		report_stats(dip, stats_type);
 	    }
@@ -281,17 +339,12 @@ report_pass(dinfo_t *dip, stats_t stats_type)
 		 */
 		if ( (dip->di_user_keepalive && strlen(dip->di_keepalive)) && !dip->di_user_pkeepalive &&
 		     (time((time_t *)0) > dip->di_last_alarm_time) ) {
-		    dip->di_log_bufptr += FmtKeepAlive(dip, dip->di_keepalive, dip->di_log_bufptr);
-		    Lprintf(dip, "\n");
-		    Lflush(dip);
+		    report_keepalive(dip, NULL, dip->di_keepalive);
 		}
 	    }
 	    if ( dip->di_pkeepalive && strlen(dip->di_pkeepalive) ) {
 		/* TODO: Make stats type available in FmtKeepAlive()! */
-		Lprintf(dip, "End of %s ", stats_names[(int)stats_type]);
-		dip->di_log_bufptr += FmtKeepAlive(dip, dip->di_pkeepalive, dip->di_log_bufptr);
-		Lprintf(dip, "\n");
-		Lflush(dip);
+		report_keepalive(dip, stats_names[(int)stats_type], dip->di_pkeepalive);
 	    }
 	}
     } /* if (dip->di_stats_level != STATS_NONE) */
@@ -355,6 +408,11 @@ report_stats(struct dinfo *dip, enum stats stats_type)
     if ( (dip->di_stats_flag == False) || (dip->di_stats_level == STATS_NONE) ) return;
     if ( (stats_type == TOTAL_STATS) && (dip->di_total_stats_flag == False) ) return;
 
+    if (dip->di_stats_level == STATS_JSON) {
+	report_json_stats(dip, stats_type);
+	return;
+    }
+
     if ( (dip->di_stats_level == STATS_BRIEF) &&
 	 ( (stats_type == JOB_STATS) || (stats_type == TOTAL_STATS) ) ) {
 	/* Overloaded, need to restructure! */
@@ -362,7 +420,8 @@ report_stats(struct dinfo *dip, enum stats stats_type)
 	    if ( dip->di_user_keepalive && !dip->di_user_tkeepalive &&
 		 (time((time_t *)0) > dip->di_last_alarm_time) ) {
 		if ( FmtKeepAlive(dip, dip->di_keepalive, dip->di_log_buffer) ) {
-		    LogMsg (dip, dip->di_ofp, logLevelLog, 0, "%s\n", dip->di_log_buffer);
+		    LogMsg (dip, dip->di_ofp, logLevelLog, KeepAliveFlags(dip->di_keepalive),
+			    "%s\n", dip->di_log_buffer);
 		}
 	    }
 	}
@@ -373,7 +432,8 @@ report_stats(struct dinfo *dip, enum stats stats_type)
 		init_stats(dip->di_output_dinfo);
 	    }
 	    if ( FmtKeepAlive(dip, dip->di_tkeepalive, dip->di_log_buffer) ) {
-		LogMsg (dip, dip->di_ofp, logLevelLog, 0, "%s\n", dip->di_log_buffer);
+		LogMsg (dip, dip->di_ofp, logLevelLog, KeepAliveFlags(dip->di_tkeepalive),
+			"%s\n", dip->di_log_buffer);
 	    }
 	}
 	return;
@@ -489,6 +549,7 @@ report_stats(struct dinfo *dip, enum stats stats_type)
 	    Lprintf (dip, DT_FIELD_WIDTH, "Random I/O Parameters");
 	    Lprintf (dip, "offset=" FUF ", ralign=" FUF ", rlimit=" LUF "\n",
 		     dip->di_file_position, dip->di_random_align, dip->di_rdata_limit);
+	    report_random_distribution(dip, &dip->di_rdist);
 	} else if (dip->di_slices) {
 	    Lprintf (dip, DT_FIELD_WIDTH, "Slice Range Parameters");
 	    Lprintf (dip, "offset=" FUF " (lba " LUF "), limit=" LUF "\n",
@@ -513,6 +574,7 @@ report_stats(struct dinfo *dip, enum stats stats_type)
 	    Lprintf(dip, DT_FIELD_WIDTH "Job %u\n",
 		    "Job Information Reported", dip->di_job->ji_job_id);
 	}
+	report_random_distribution(dip, &dip->di_rdist);
     } else {
 	Lprintf(dip, DT_FIELD_WIDTH "Job %u, Thread %u\n",
 		"Job Information Reported", dip->di_job->ji_job_id, dip->di_thread_number);
@@ -760,6 +822,8 @@ report_stats(struct dinfo *dip, enum stats stats_type)
             Lprintf(dip, " (min %.*f%s", precision, scaled_min, suffix);
             scale_timer_value((double)dip->di_max_read_latency, &scaled_max, &suffix, &precision);
             Lprintf(dip, ", max %.*f%s)\n", precision, scaled_max, suffix);
+            report_latency_percentiles(dip, "Read latency percentiles",
+                                       dip->di_read_histogram, NULL);
         }
         if ( dip->di_write_latency_ios ) {
             latency = (double)dip->di_write_latency / (double)dip->di_write_latency_ios;
@@ -770,6 +834,8 @@ report_stats(struct dinfo *dip, enum stats stats_type)
             Lprintf(dip, " (min %.*f%s", precision, scaled_min, suffix);
             scale_timer_value((double)dip->di_max_write_latency, &scaled_max, &suffix, &precision);
             Lprintf(dip, ", max %.*f%s)\n", precision, scaled_max, suffix);
+            report_latency_percentiles(dip, "Write latency percentiles",
+                                       NULL, dip->di_write_histogram);
         }
         if ( dip->di_total_latency_ios ) {
             latency = (double)dip->di_total_latency / (double)dip->di_total_latency_ios;
@@ -780,6 +846,8 @@ report_stats(struct dinfo *dip, enum stats stats_type)
             Lprintf(dip, " (min %.*f%s", precision, scaled_min, suffix);
             scale_timer_value((double)dip->di_max_latency, &scaled_max, &suffix, &precision);
             Lprintf(dip, ", max %.*f%s)\n", precision, scaled_max, suffix);
+            report_latency_percentiles(dip, "Total latency percentiles",
+                                       dip->di_read_histogram, dip->di_write_histogram);
         }
     }
 
@@ -900,6 +968,171 @@ report_stats(struct dinfo *dip, enum stats stats_type)
     Lflush(dip);
 }
 
+/*
+ * json_string() - Format a JSON String (quoted and escaped).
+ */
+static char *
+json_string(char *bp, char *string)
+{
+    *bp++ = '"';
+    for (; string && *string; string++) {
+	unsigned char c = (unsigned char)*string;
+	if ( (c == '"') || (c == '\\') ) {
+	    *bp++ = '\\';
+	    *bp++ = c;
+	} else if (c < ' ') {
+	    bp += sprintf(bp, "\\u%04x", c);
+	} else {
+	    *bp++ = c;
+	}
+    }
+    *bp++ = '"';
+    *bp = '\0';
+    return(bp);
+}
+
+/************************************************************************
+ *									*
+ * FmtJsonStats() - Format Statistics as a JSON Record.			*
+ *									*
+ * Description:								*
+ *	Formats the statistics as a single line JSON object, for the	*
+ * automation parsing our results. The latency statistics are always	*
+ * accumulated (they are not reset each pass).				*
+ *									*
+ * Inputs:								*
+ *	dip = The device information pointer.				*
+ *	buffer = The buffer to format into.				*
+ *	record = The record type (pass type, total, job, or keepalive).	*
+ *	pass_stats = Boolean true for the per pass statistics.		*
+ *	active = Boolean true if I/O is active (keepalive), so the	*
+ *		 current pass is added to the totals, and the elapsed	*
+ *		 time is calculated to now.				*
+ *									*
+ * Return Value:							*
+ *	Returns the number of characters formatted.			*
+ *									*
+ ************************************************************************/
+size_t
+FmtJsonStats(dinfo_t *dip, char *buffer, char *record, hbool_t pass_stats, hbool_t active)
+{
+    char *bp = buffer;
+    large_t bytes_read, bytes_written;
+    large_t records_read, records_written;
+    large_t partial_records;
+    struct timeval now, *end_timer;
+    double elapsed, xfer_bytes, xfer_records;
+    uint64_t usecs;
+    job_info_t *job = dip->di_job;
+
+    if (active == True) {
+	gettimeofday(&now, NULL);
+	end_timer = &now;
+    } else {
+	end_timer = &dip->di_end_timer;
+    }
+    if (pass_stats == True) {
+	usecs = timer_diff(&dip->di_pass_timer, end_timer);
+	bytes_read = dip->di_dbytes_read;
+	bytes_written = dip->di_dbytes_written;
+	records_read = (dip->di_full_reads + dip->di_partial_reads);
+	records_written = (dip->di_full_writes + dip->di_partial_writes);
+	partial_records = (dip->di_partial_reads + dip->di_partial_writes);
+    } else {
+	usecs = timer_diff(&dip->di_start_timer, end_timer);
+	bytes_read = dip->di_total_bytes_read;
+	bytes_written = dip->di_total_bytes_written;
+	records_read = (dip->di_total_records_read + dip->di_total_partial_reads);
+	records_written = (dip->di_total_records_written + dip->di_total_partial_writes);
+	partial_records = dip->di_total_partial;
+	if (active == True) {
+	    bytes_read += dip->di_dbytes_read;
+	    bytes_written += dip->di_dbytes_written;
+	    records_read += (dip->di_full_reads + dip->di_partial_reads);
+	    records_written += (dip->di_full_writes + dip->di_partial_writes);
+	    partial_records += (dip->di_partial_reads + dip->di_partial_writes);
+	}
+    }
+    elapsed = ((double)usecs / (double)uSECS_PER_SEC);
+    xfer_bytes = (double)(bytes_read + bytes_written);
+    xfer_records = (double)(records_read + records_written);
+
+    bp += sprintf(bp, "{\"record\":\"%s\"", record);
+    bp += sprintf(bp, ",\"job\":%u", (job) ? job->ji_job_id : 0);
+    if (job && job->ji_job_tag) {
+	bp += sprintf(bp, ",\"tag\":");
+	bp = json_string(bp, job->ji_job_tag);
+    }
+    if (strcmp(record, json_stats_names[JOB_STATS]) == 0) {
+	bp += sprintf(bp, ",\"threads\":%d", dip->di_threads);
+    } else {
+	bp += sprintf(bp, ",\"thread\":%d", dip->di_thread_number);
+    }
+    bp += sprintf(bp, ",\"pass\":%lu", dip->di_pass_count);
+    bp += sprintf(bp, ",\"device\":");
+    bp = json_string(bp, dip->di_dname);
+    bp += sprintf(bp, ",\"mode\":\"%s\"", (dip->di_mode == READ_MODE) ? "read" : "write");
+    bp += sprintf(bp, ",\"iotype\":\"%s\",\"iodir\":\"%s\"",
+		  (dip->di_io_type == RANDOM_IO) ? "random" : "sequential",
+		  (dip->di_io_dir == FORWARD) ? "forward" : "reverse");
+    if (dip->di_rdist.rd_type != RDIST_UNIFORM) {
+	char rdist[STRING_BUFFER_SIZE];
+	bp += sprintf(bp, ",\"rdist\":\"%s\",\"hot_io_pct\":%.2f",
+		      format_random_distribution(dip, rdist),
+		      random_distribution_hot_io(&dip->di_rdist));
+    }
+    bp += sprintf(bp, ",\"block_size\":%ld", (long)dip->di_block_size);
+    bp += sprintf(bp, ",\"bytes_read\":" LUF ",\"bytes_written\":" LUF,
+		  bytes_read, bytes_written);
+    bp += sprintf(bp, ",\"records_read\":" LUF ",\"records_written\":" LUF ",\"partial_records\":" LUF,
+		  records_read, records_written, partial_records);
+    bp += sprintf(bp, ",\"elapsed_secs\":%.6f", elapsed);
+    bp += sprintf(bp, ",\"iops\":%.3f,\"bytes_per_sec\":%.0f,\"mbytes_per_sec\":%.3f",
+		  (elapsed) ? (xfer_records / elapsed) : 0.0,
+		  (elapsed) ? (xfer_bytes / elapsed) : 0.0,
+		  (elapsed) ? ((xfer_bytes / (double)MBYTE_SIZE) / elapsed) : 0.0);
+    bp += sprintf(bp, ",\"errors\":%lu,\"error_limit\":%lu",
+		  dip->di_error_count, dip->di_error_limit);
+    bp += sprintf(bp, ",\"latency\":{");
+    bp += format_latency_json(bp, "read", dip->di_read_latency_ios, dip->di_read_latency,
+			      dip->di_min_read_latency, dip->di_max_read_latency,
+			      dip->di_read_histogram, NULL);
+    *bp++ = ',';
+    bp += format_latency_json(bp, "write", dip->di_write_latency_ios, dip->di_write_latency,
+			      dip->di_min_write_latency, dip->di_max_write_latency,
+			      NULL, dip->di_write_histogram);
+    *bp++ = ',';
+    bp += format_latency_json(bp, "total", dip->di_total_latency_ios, dip->di_total_latency,
+			      dip->di_min_latency, dip->di_max_latency,
+			      dip->di_read_histogram, dip->di_write_histogram);
+    bp += sprintf(bp, "}}");
+    return( (size_t)(bp - buffer) );
+}
+
+/*
+ * report_json_stats() - Report the Statistics as a JSON Record.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	stats_type = Type of statistics to display.
+ *
+ * Return Value:
+ *	void
+ */
+void
+report_json_stats(dinfo_t *dip, stats_t stats_type)
+{
+    char buffer[LOG_BUFSIZE];
+    hbool_t pass_stats = ( (stats_type != JOB_STATS) && (stats_type != TOTAL_STATS) );
+
+    dip->di_end_time = times(&dip->di_etimes);
+    gettimeofday(&dip->di_end_timer, NULL);
+    (void)FmtJsonStats(dip, buffer, json_stats_names[(int)stats_type], pass_stats, False);
+    /* Note: No message prefix, so each line is a valid JSON object. */
+    LogMsg(dip, dip->di_ofp, logLevelLog, PRT_NOIDENT, "%s\n", buffer);
+    return;
+}
+
 void
 format_buffer_modes(dinfo_t *dip, char *buffer)
 {
@@ -1210,15 +1443,15 @@ gather_thread_stats(dinfo_t *dip, dinfo_t *tdip)
 
     /* Accumulate Latency */
     dip->di_total_latency += tdip->di_total_latency;
-    dip->di_total_latency_ios += dip->di_total_latency_ios;
+    dip->di_total_latency_ios += tdip->di_total_latency_ios;
     if ( tdip->di_min_latency < dip->di_min_latency ) {
         dip->di_min_latency = tdip->di_min_latency;
     }
     if ( tdip->di_max_latency > dip->di_max_latency ) {
         dip->di_max_latency = tdip->di_max_latency;
     }
-   dip->di_read_latency += tdip->di_read_latency;
-    dip->di_read_latency_ios += dip->di_read_latency_ios;
+    dip->di_read_latency += tdip->di_read_latency;
+    dip->di_read_latency_ios += tdip->di_read_latency_ios;
     if ( tdip->di_min_read_latency < dip->di_min_read_latency ) {
         dip->di_min_read_latency = tdip->di_min_read_latency;
     }
@@ -1226,13 +1459,16 @@ gather_thread_stats(dinfo_t *dip, dinfo_t *tdip)
         dip->di_max_read_latency = tdip->di_max_read_latency;
     }
     dip->di_write_latency += tdip->di_write_latency;
-    dip->di_write_latency_ios += dip->di_write_latency_ios;
+    dip->di_write_latency_ios += tdip->di_write_latency_ios;
     if ( tdip->di_min_write_latency < dip->di_min_write_latency ) {
         dip->di_min_write_latency = tdip->di_min_write_latency;
     }
     if ( tdip->di_max_write_latency > dip->di_max_write_latency ) {
         dip->di_max_write_latency = tdip->di_max_write_latency;
     }
+    (void)merge_latency_histogram(dip, &dip->di_read_histogram, tdip->di_read_histogram);
+    (void)merge_latency_histogram(dip, &dip->di_write_histogram, tdip->di_write_histogram);
+    merge_random_distribution(&dip->di_rdist, &tdip->di_rdist);
     return;
 }
 
@@ -31,6 +31,13 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Index the Linux file map by file offset, so offset to LBA lookups
+ * are a binary search rather than a scan of every extent. Within an open,
+ * the map is kept until the file is truncated, or a lookup past the mapped
+ * end finds it extended (no stat per lookup). Added a range translation
+ * for mapping many offsets with a single lookup.
+ * 
  * March 31st, 2021 by Robin T. Miller
  *      For Solaris mount lookups, save the FS type and mount options.
  * 
@@ -1812,6 +1819,44 @@ report_file_extent(dinfo_t *dip, struct fiemap_extent *fep, uint32_t dsize)
 
 /* Note: We are using the file map data structures in: /usr/include/linux/fiemap.h, not our own! */
 
+static int
+compare_file_extents(const void *p1, const void *p2)
+{
+    const struct fiemap_extent *fep1 = p1, *fep2 = p2;
+
+    if (fep1->fe_logical < fep2->fe_logical) return(-1);
+    return( (fep1->fe_logical > fep2->fe_logical) ? 1 : 0 );
+}
+
+/*
+ * find_file_extent() - Find the File Extent for an Offset.
+ *
+ * Description:
+ *	The extents are sorted by file offset, so a binary search finds
+ * the extent containing the offset. When the offset is in a hole (sparse
+ * file), the next extent is returned, so callers can walk a range.
+ *
+ * Return Value:
+ *	Returns the extent index, which is fm_mapped_extents if none follow.
+ */
+static unsigned int
+find_file_extent(struct fiemap *fmp, Offset_t offset)
+{
+    struct fiemap_extent *fep = (struct fiemap_extent *)(fmp + 1);
+    unsigned int low = 0, high = fmp->fm_mapped_extents;
+
+    /* Find the first extent ending after this offset. */
+    while (low < high) {
+	unsigned int mid = low + ((high - low) / 2);
+	if ((__u64)offset >= (fep[mid].fe_logical + fep[mid].fe_length)) {
+	    low = mid + 1;
+	} else {
+	    high = mid;
+	}
+    }
+    return(low);
+}
+
 void *
 os_get_file_map(dinfo_t *dip, HANDLE fd)
 {
@@ -1820,11 +1865,19 @@ os_get_file_map(dinfo_t *dip, HANDLE fd)
     void *fsp = NULL;
     size_t fiedata_size;
     __u32 extent_count;
+    struct stat sb;
+    unsigned int extent;
 
-    /* Caller must free file map to force repopulating! */
+    /*
+     * The map is freed on each open and truncate, and a lookup past the
+     * mapped end (file extended) refreshes it, so no stat is done here.
+     */
     if (dip->di_fsmap) {
 	return(dip->di_fsmap);
     }
+    if (fstat(fd, &sb) == FAILURE) {
+	return(NULL);
+    }
     /*
      * Request the map header, to find the extents mapped.
      */
@@ -1866,7 +1919,16 @@ os_get_file_map(dinfo_t *dip, HANDLE fd)
 	free(fsp);
 	return(NULL);
     }
+    /* The kernel returns extents in file order, but we depend on it! */
+    for (extent = 1; extent < fmp->fm_mapped_extents; extent++) {
+	if (fep[extent].fe_logical < fep[extent - 1].fe_logical) {
+	    qsort(fep, fmp->fm_mapped_extents, sizeof(*fep), compare_file_extents);
+	    break;
+	}
+    }
     dip->di_fsmap = fmp;
+    dip->di_fsmap_fsize = (large_t)sb.st_size;
+    dip->di_fsmap_refreshed = False;
     return(fmp);
 }
 
@@ -1880,6 +1942,45 @@ os_free_file_map(dinfo_t *dip)
     return;
 }
 
+/*
+ * refresh_file_map() - Refresh the File Map after a Lookup Miss.
+ *
+ * Description:
+ *	Writes into a hole allocate blocks without changing the file size,
+ * so the first lookup missing within the file refreshes the map. This is
+ * done only once per map, so sparse files do not rebuild on every miss.
+ *	Lookups past the mapped end refresh the map when the file has been
+ * extended since it was mapped. Only these misses pay for the stat.
+ *
+ * Return Value:
+ *	Returns the new map, or NULL if not refreshed. When the refresh
+ * fails, the old map has been freed, so dip->di_fsmap is NULL.
+ */
+static struct fiemap *
+refresh_file_map(dinfo_t *dip, HANDLE fd, Offset_t offset)
+{
+    hbool_t extended = False;
+
+    if ((large_t)offset >= dip->di_fsmap_fsize) {
+	struct stat sb;
+	if ( (fstat(fd, &sb) == FAILURE) ||
+	     ((large_t)sb.st_size <= dip->di_fsmap_fsize) ) {
+	    return(NULL);
+	}
+	extended = True;
+    } else if (dip->di_fsmap_refreshed) {
+	return(NULL);
+    }
+    os_free_file_map(dip);
+    if (os_get_file_map(dip, fd) == NULL) {
+	return(NULL);
+    }
+    if (extended == False) {
+	dip->di_fsmap_refreshed = True;
+    }
+    return( (struct fiemap *)dip->di_fsmap );
+}
+
 int
 os_report_file_map(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset, int64_t length)
 {
@@ -1896,9 +1997,11 @@ os_report_file_map(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset, int
     if ( (fmp = (struct fiemap *)os_get_file_map(dip, fd)) == NULL) {
 	return(FAILURE);
     }
-    fep = (struct fiemap_extent *)(fmp + 1);
+    /* Start with the extent containing (or following) the offset. */
+    extents = (offset == NO_OFFSET) ? 0 : find_file_extent(fmp, fileOffset);
+    fep = (struct fiemap_extent *)(fmp + 1) + extents;
 
-    for (extents = 0; (extents < fmp->fm_mapped_extents) && (recordLength > 0); extents++, fep++) {
+    for (; (extents < fmp->fm_mapped_extents) && (recordLength > 0); extents++, fep++) {
 	__u64 ending_logical = (fep->fe_logical + fep->fe_length);
         /* Note: This could be simplified like the Windows version. */
         /* The idea here is to use offset as the starting point to report. */
@@ -1933,7 +2036,7 @@ os_report_file_map(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset, int
 uint64_t
 os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset)
 {
-    unsigned int extents;
+    unsigned int extent;
     struct fiemap *fmp;
     struct fiemap_extent *fep;
     uint64_t lba = NO_LBA;
@@ -1941,11 +2044,10 @@ os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset)
     if ( (fmp = (struct fiemap *)os_get_file_map(dip, fd)) == NULL) {
 	return(lba);
     }
-    fep = (struct fiemap_extent *)(fmp + 1);
-
-    for (extents = 0; extents < fmp->fm_mapped_extents; extents++, fep++) {
-	__u64 ending_logical = (fep->fe_logical + fep->fe_length);
-	if ( (offset >= fep->fe_logical) && (offset < ending_logical) ) {
+    do {
+	extent = find_file_extent(fmp, offset);
+	fep = (struct fiemap_extent *)(fmp + 1) + extent;
+	if ( (extent < fmp->fm_mapped_extents) && ((__u64)offset >= fep->fe_logical) ) {
 	    lba = ( (offset - fep->fe_logical) + fep->fe_physical) / dsize;
 	    if (dip->di_fDebugFlag) {
 		Printf(dip, "File offset: "FUF", Physical LBA "LUF"\n", offset, lba);
@@ -1953,13 +2055,72 @@ os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset)
 	    }
 	    break;
 	}
-    }
+    } while ( (fmp = refresh_file_map(dip, fd, offset)) );
+
     if ( (lba == NO_LBA) && dip->di_fDebugFlag ) {
 	Wprintf(dip, "File mapping NOT found for offset "FUF", assuming not written...\n", offset);
     }
     return(lba);
 }
 
+/*
+ * os_map_range_to_lba() - Map a Range of File Offsets to Physical LBAs.
+ *
+ * Description:
+ *	The extent is located once, then the offsets are walked forward
+ * through the extents, so mapping a range is linear rather than one
+ * lookup per offset. Offsets in holes are returned as NO_LBA.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	fd = The file descriptor.
+ *	dsize = The LBA (device) size.
+ *	offset = The starting file offset.
+ *	step = The bytes between each offset.
+ *	lbas = The array to return the LBAs.
+ *	count = The number of offsets to map.
+ *
+ * Return Value:
+ *	Returns SUCCESS/FAILURE = Mapped/No file map.
+ */
+int
+os_map_range_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset,
+		    uint32_t step, uint64_t *lbas, int count)
+{
+    unsigned int extent;
+    struct fiemap *fmp;
+    struct fiemap_extent *fep;
+    Offset_t ending_offset = offset + ((Offset_t)step * (count - 1));
+    int index;
+
+    if ( (fmp = (struct fiemap *)os_get_file_map(dip, fd)) == NULL) {
+	return(FAILURE);
+    }
+    /* Refresh the map when the range goes past the mapped end. */
+    if ((large_t)ending_offset >= dip->di_fsmap_fsize) {
+	if ( (fmp = refresh_file_map(dip, fd, ending_offset)) == NULL) {
+	    if ( (fmp = (struct fiemap *)dip->di_fsmap) == NULL) {
+		return(FAILURE);
+	    }
+	}
+    }
+    extent = find_file_extent(fmp, offset);
+    fep = (struct fiemap_extent *)(fmp + 1) + extent;
+
+    for (index = 0; index < count; index++, offset += step) {
+	while ( (extent < fmp->fm_mapped_extents) &&
+		((__u64)offset >= (fep->fe_logical + fep->fe_length)) ) {
+	    extent++; fep++;
+	}
+	if ( (extent < fmp->fm_mapped_extents) && ((__u64)offset >= fep->fe_logical) ) {
+	    lbas[index] = ( (offset - fep->fe_logical) + fep->fe_physical) / dsize;
+	} else {
+	    lbas[index] = NO_LBA;
+	}
+    }
+    return(SUCCESS);
+}
+
 #else /* !defined(__linux__) */
 
 void
@@ -1982,4 +2143,11 @@ os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset)
     return(lba);
 }
 
+int
+os_map_range_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset,
+		    uint32_t step, uint64_t *lbas, int count)
+{
+    return(FAILURE);
+}
+
 #endif /* defined(__linux__) */
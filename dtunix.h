@@ -226,6 +226,17 @@ extern HANDLE os_open_file(char *name, int oflags, int perm);
 #define os_getDiskFullError()	ENOSPC
 #define os_mapDiskFullError(error) error
 
+/* Atomic add, returning the previous value (GCC/clang builtins). */
+#define os_atomic_fetch_add64(ptr, value) \
+	__atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+/* Atomic compare and swap, returning the previous value. */
+#define os_atomic_cas64(ptr, expected, desired) \
+	__sync_val_compare_and_swap((ptr), (expected), (desired))
+#define os_atomic_load64(ptr) \
+	__atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define os_atomic_store64(ptr, value) \
+	__atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
 #define os_perror		Perror
 #define os_tperror		tPerror
 #define os_get_error()		errno
@@ -0,0 +1,851 @@
+/****************************************************************************
+ *									    *
+ *			  COPYRIGHT (c) 1988 - 2026			    *
+ *			   This Software Provided			    *
+ *				     By					    *
+ *			  Robin's Nest Software Inc.			    *
+ *									    *
+ * Permission to use, copy, modify, distribute and sell this software and   *
+ * its documentation for any purpose and without fee is hereby granted,	    *
+ * provided that the above copyright notice appear in all copies and that   *
+ * both that copyright notice and this permission notice appear in the	    *
+ * supporting documentation, and that the name of the author not be used    *
+ * in advertising or publicity pertaining to distribution of the software   *
+ * without specific, written prior permission.				    *
+ *									    *
+ * THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE, 	    *
+ * INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS, IN	    *
+ * NO EVENT SHALL HE BE LIABLE FOR ANY SPECIAL, INDIRECT OR CONSEQUENTIAL   *
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR    *
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS  *
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF   *
+ * THIS SOFTWARE.							    *
+ *									    *
+ ****************************************************************************/
+/*
+ * Module:	dturing.c
+ * Author:	Robin T. Miller
+ * Date:	October 15th, 2026
+ *
+ * Description:
+ *	Linux io_uring engine for the AIO test functions (see dtaio.c).
+ *
+ *	glibc implements POSIX AIO with helper threads, so only a few of the
+ * queued requests actually reach the device. This engine replaces the
+ * aio_read/aio_write/aio_suspend/aio_return/aio_cancel calls with io_uring,
+ * while the AIO control blocks (aiocb's) and all of the AIO processing in
+ * dtaio.c remain the same (restarts, cancels, completions, verify).
+ * The AIO control block index is used as the io_uring request user data.
+ *
+ *	The raw system calls are used, so liburing is NOT required. Optional
+ * features (see uring_flags= option):
+ *	fixedbufs  - Register the AIO buffers (IORING_OP_{READ|WRITE}_FIXED).
+ *	fixedfiles - Register the device file descriptor (IOSQE_FIXED_FILE).
+ *	sqpoll     - Kernel submission queue polling thread (IORING_SETUP_SQPOLL).
+ *
+ *	When NVMe I/O is enabled (enable=nvme_io), NVMe read and write
+ * commands are passed through via IORING_OP_URING_CMD on the NVMe generic
+ * character device (/dev/ngXnY), bypassing the block layer. This requires
+ * 128 byte SQEs and 32 byte CQEs. The queue depth is set by aios=, and the
+ * data is verified as each request completes, as with normal AIO.
+ *
+ * Modification History:
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Display the NVMe request size with SUF, since it's a size_t.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the NVMe passthrough engine (IORING_OP_URING_CMD).
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add dturing_wait_any() for unordered AIO completion processing.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Initial creation.
+ */
+#if defined(AIO) && defined(URING)
+
+#include "dt.h"
+#include <aio.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#if defined(NVME)
+#  include <linux/nvme_ioctl.h>
+#  if defined(NVME_URING_CMD_IO)
+#    define URING_NVME
+#  endif /* defined(NVME_URING_CMD_IO) */
+#endif /* defined(NVME) */
+
+#define URING_SQPOLL_IDLE	1000		/* SQ thread idle time (ms).	*/
+#define URING_CANCEL_DATA	0		/* User data for cancel requests. */
+
+#define NVME_CMD_WRITE		0x01		/* The NVMe write opcode.	*/
+#define NVME_CMD_READ		0x02		/* The NVMe read opcode.	*/
+#define NVME_MAX_BLOCKS		65536		/* Max blocks (16-bit NLB).	*/
+
+/*
+ * The io_uring information (one ring per thread).
+ */
+typedef struct uring_info {
+    int		ur_fd;			/* The io_uring file descriptor.	*/
+    unsigned	ur_entries;		/* The submission queue entries.	*/
+    unsigned	ur_setup_flags;		/* The ring setup flags.		*/
+    /* Submission Queue: */
+    unsigned	*ur_sq_head;		/* Submission queue head.		*/
+    unsigned	*ur_sq_tail;		/* Submission queue tail.		*/
+    unsigned	*ur_sq_mask;		/* Submission queue ring mask.		*/
+    unsigned	*ur_sq_flags;		/* Submission queue flags (SQPOLL).	*/
+    unsigned	*ur_sq_array;		/* Submission queue index array.	*/
+    struct io_uring_sqe *ur_sqes;	/* The submission queue entries.	*/
+    unsigned	ur_sq_pending;		/* Entries not submitted to kernel.	*/
+    /* Completion Queue: */
+    unsigned	*ur_cq_head;		/* Completion queue head.		*/
+    unsigned	*ur_cq_tail;		/* Completion queue tail.		*/
+    unsigned	*ur_cq_mask;		/* Completion queue ring mask.		*/
+    struct io_uring_cqe *ur_cqes;	/* The completion queue entries.	*/
+    /* Mappings: */
+    void	*ur_sq_ring;		/* The submission ring mapping.		*/
+    size_t	ur_sq_ring_size;	/* The submission ring map size.	*/
+    void	*ur_cq_ring;		/* The completion ring mapping.		*/
+    size_t	ur_cq_ring_size;	/* The completion ring map size.	*/
+    size_t	ur_sqes_size;		/* The submission entries map size.	*/
+    /* Per request state, indexed by the AIO control block index: */
+    int		*ur_results;		/* The completion results.		*/
+    hbool_t	*ur_done;		/* The request completed flags.		*/
+    int		ur_nbufs;		/* The number of registered buffers.	*/
+    hbool_t	ur_fixed_bufs;		/* The buffers are registered.		*/
+    int		ur_fixed_fd;		/* The registered file descriptor.	*/
+    /* NVMe Passthrough: */
+    hbool_t	ur_nvme;		/* NVMe passthrough (uring_cmd).	*/
+    int		ur_nvme_fd;		/* The NVMe generic device descriptor.	*/
+    unsigned	ur_sqe_shift;		/* The SQE size shift (SQE128).		*/
+    unsigned	ur_cqe_shift;		/* The CQE size shift (CQE32).		*/
+} uring_info_t;
+
+/*
+ * Forward References:
+ */
+static int dturing_enter(dinfo_t *dip, uring_info_t *urp, unsigned to_submit,
+			 unsigned min_complete, unsigned flags);
+static void dturing_reap(dinfo_t *dip, uring_info_t *urp);
+static struct io_uring_sqe *dturing_get_sqe(dinfo_t *dip, uring_info_t *urp);
+static int dturing_register_file(dinfo_t *dip, uring_info_t *urp);
+static int dturing_unregister_file(dinfo_t *dip, uring_info_t *urp);
+#if defined(URING_NVME)
+static int dturing_nvme_open(dinfo_t *dip, uring_info_t *urp);
+static int dturing_nvme_check(dinfo_t *dip, struct aiocb *acbp);
+static void dturing_nvme_prep(dinfo_t *dip, uring_info_t *urp, struct io_uring_sqe *sqe,
+			      struct aiocb *acbp, test_mode_t mode, int index);
+#endif /* defined(URING_NVME) */
+
+static int
+io_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return( (int)syscall(__NR_io_uring_setup, entries, p) );
+}
+
+static int
+io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return( (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0) );
+}
+
+static int
+io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+{
+    return( (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args) );
+}
+
+/*
+ * parse_uring_flags() - Parse the io_uring Flags.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	string = Comma separated flags (fixedbufs,fixedfiles,sqpoll or none).
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+int
+parse_uring_flags(dinfo_t *dip, char *string)
+{
+    char *token, *saveptr;
+    char *str = strdup(string);
+    int status = SUCCESS;
+
+    dip->di_uring_flags = 0;
+    token = strtok_r(str, ",", &saveptr);
+    while (token != NULL) {
+	if (EQ(token, "fixedbufs")) {
+	    dip->di_uring_flags |= URING_FIXED_BUFS;
+	} else if (EQ(token, "fixedfiles")) {
+	    dip->di_uring_flags |= URING_FIXED_FILES;
+	} else if (EQ(token, "sqpoll")) {
+	    dip->di_uring_flags |= URING_SQPOLL;
+	} else if (EQ(token, "none")) {
+	    dip->di_uring_flags = 0;
+	} else {
+	    Eprintf(dip, "Valid io_uring flags are: fixedbufs, fixedfiles, sqpoll, or none\n");
+	    status = FAILURE;
+	    break;
+	}
+	token = strtok_r(NULL, ",", &saveptr);
+    }
+    free(str);
+    return(status);
+}
+
+/*
+ * dturing_initialize() - Setup the io_uring for this thread.
+ *
+ * Description:
+ *	The ring is sized for the AIO control blocks, plus entries for
+ * cancel requests. The AIO buffers must be allocated prior to calling
+ * this function, so they can be registered (if requested).
+ *
+ *	Registering buffers may fail due to the locked memory limit, in
+ * which case we continue without registered buffers.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+int
+dturing_initialize(dinfo_t *dip)
+{
+    uring_info_t *urp;
+    struct io_uring_params params;
+    unsigned entries = (unsigned)(dip->di_aio_bufs * 2);
+    int index;
+
+    if (dip->di_uring) {
+	return(SUCCESS);
+    }
+    urp = Malloc(dip, sizeof(*urp));
+    if (urp == NULL) return(FAILURE);
+    urp->ur_fd = NoFd;
+    urp->ur_fixed_fd = NoFd;
+    urp->ur_nvme_fd = NoFd;
+
+    memset(&params, 0, sizeof(params));
+    if (dip->di_uring_flags & URING_SQPOLL) {
+	params.flags |= IORING_SETUP_SQPOLL;
+	params.sq_thread_idle = URING_SQPOLL_IDLE;
+    }
+    if (dip->di_nvme_io_flag == True) {
+#if defined(URING_NVME)
+	if (dturing_nvme_open(dip, urp) == FAILURE) {
+	    Free(dip, urp);
+	    return(FAILURE);
+	}
+	/* The NVMe command is carried in the SQE, the result in the CQE. */
+	params.flags |= (IORING_SETUP_SQE128 | IORING_SETUP_CQE32);
+	urp->ur_sqe_shift = urp->ur_cqe_shift = 1;
+#else /* !defined(URING_NVME) */
+	Eprintf(dip, "NVMe passthrough via io_uring is NOT supported in this build!\n");
+	Free(dip, urp);
+	return(FAILURE);
+#endif /* defined(URING_NVME) */
+    }
+    urp->ur_fd = io_uring_setup(entries, &params);
+    if (urp->ur_fd < 0) {
+	ReportErrorInfo(dip, dip->di_dname, os_get_error(), "io_uring_setup", OTHER_OP, True);
+	if (urp->ur_nvme_fd != NoFd) {
+	    (void)close(urp->ur_nvme_fd);
+	}
+	Free(dip, urp);
+	return(FAILURE);
+    }
+    urp->ur_entries = params.sq_entries;
+    urp->ur_setup_flags = params.flags;
+
+    urp->ur_sq_ring_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    urp->ur_cq_ring_size = params.cq_off.cqes +
+			   ((params.cq_entries * sizeof(struct io_uring_cqe)) << urp->ur_cqe_shift);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+	urp->ur_sq_ring_size = urp->ur_cq_ring_size = MAX(urp->ur_sq_ring_size, urp->ur_cq_ring_size);
+    }
+    urp->ur_sq_ring = mmap(NULL, urp->ur_sq_ring_size, PROT_READ|PROT_WRITE,
+			   MAP_SHARED|MAP_POPULATE, urp->ur_fd, IORING_OFF_SQ_RING);
+    if (urp->ur_sq_ring == MAP_FAILED) {
+	ReportErrorInfo(dip, dip->di_dname, os_get_error(), "mmap SQ ring", OTHER_OP, True);
+	urp->ur_sq_ring = NULL;
+	goto error;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+	urp->ur_cq_ring = urp->ur_sq_ring;
+    } else {
+	urp->ur_cq_ring = mmap(NULL, urp->ur_cq_ring_size, PROT_READ|PROT_WRITE,
+			       MAP_SHARED|MAP_POPULATE, urp->ur_fd, IORING_OFF_CQ_RING);
+	if (urp->ur_cq_ring == MAP_FAILED) {
+	    ReportErrorInfo(dip, dip->di_dname, os_get_error(), "mmap CQ ring", OTHER_OP, True);
+	    urp->ur_cq_ring = NULL;
+	    goto error;
+	}
+    }
+    urp->ur_sqes_size = ((params.sq_entries * sizeof(struct io_uring_sqe)) << urp->ur_sqe_shift);
+    urp->ur_sqes = mmap(NULL, urp->ur_sqes_size, PROT_READ|PROT_WRITE,
+			MAP_SHARED|MAP_POPULATE, urp->ur_fd, IORING_OFF_SQES);
+    if (urp->ur_sqes == MAP_FAILED) {
+	ReportErrorInfo(dip, dip->di_dname, os_get_error(), "mmap SQEs", OTHER_OP, True);
+	urp->ur_sqes = NULL;
+	goto error;
+    }
+    urp->ur_sq_head  = (unsigned *)((char *)urp->ur_sq_ring + params.sq_off.head);
+    urp->ur_sq_tail  = (unsigned *)((char *)urp->ur_sq_ring + params.sq_off.tail);
+    urp->ur_sq_mask  = (unsigned *)((char *)urp->ur_sq_ring + params.sq_off.ring_mask);
+    urp->ur_sq_flags = (unsigned *)((char *)urp->ur_sq_ring + params.sq_off.flags);
+    urp->ur_sq_array = (unsigned *)((char *)urp->ur_sq_ring + params.sq_off.array);
+    urp->ur_cq_head  = (unsigned *)((char *)urp->ur_cq_ring + params.cq_off.head);
+    urp->ur_cq_tail  = (unsigned *)((char *)urp->ur_cq_ring + params.cq_off.tail);
+    urp->ur_cq_mask  = (unsigned *)((char *)urp->ur_cq_ring + params.cq_off.ring_mask);
+    urp->ur_cqes     = (struct io_uring_cqe *)((char *)urp->ur_cq_ring + params.cq_off.cqes);
+
+    urp->ur_results = Malloc(dip, (dip->di_aio_bufs * sizeof(*urp->ur_results)));
+    urp->ur_done = Malloc(dip, (dip->di_aio_bufs * sizeof(*urp->ur_done)));
+    if ( (urp->ur_results == NULL) || (urp->ur_done == NULL) ) goto error;
+    for (index = 0; index < dip->di_aio_bufs; index++) {
+	urp->ur_done[index] = True;
+    }
+
+    if (dip->di_uring_flags & URING_FIXED_BUFS) {
+	struct iovec *iov = Malloc(dip, (dip->di_aio_bufs * sizeof(*iov)));
+	if (iov == NULL) goto error;
+	for (index = 0; index < dip->di_aio_bufs; index++) {
+	    iov[index].iov_base = dip->di_aiobufs[index];
+	    iov[index].iov_len = dip->di_data_alloc_size;
+	}
+	if (io_uring_register(urp->ur_fd, IORING_REGISTER_BUFFERS, iov, dip->di_aio_bufs) < 0) {
+	    Wprintf(dip, "Unable to register io_uring buffers, error = %d, continuing without...\n",
+		    os_get_error());
+	} else {
+	    urp->ur_fixed_bufs = True;
+	    urp->ur_nbufs = dip->di_aio_bufs;
+	}
+	Free(dip, iov);
+    }
+    dip->di_uring = urp;
+    if (dip->di_debug_flag) {
+	Printf(dip, "io_uring setup with %u entries, flags 0x%x, fixed buffers %s, NVMe passthrough %s\n",
+	       urp->ur_entries, urp->ur_setup_flags, (urp->ur_fixed_bufs) ? "yes" : "no",
+	       (urp->ur_nvme) ? "yes" : "no");
+    }
+    return(SUCCESS);
+error:
+    dip->di_uring = urp;
+    dturing_cleanup(dip);
+    return(FAILURE);
+}
+
+/*
+ * dturing_cleanup() - Teardown the io_uring.
+ */
+void
+dturing_cleanup(dinfo_t *dip)
+{
+    uring_info_t *urp = dip->di_uring;
+
+    if (urp == NULL) return;
+    if (urp->ur_sqes) {
+	(void)munmap(urp->ur_sqes, urp->ur_sqes_size);
+    }
+    if (urp->ur_cq_ring && (urp->ur_cq_ring != urp->ur_sq_ring)) {
+	(void)munmap(urp->ur_cq_ring, urp->ur_cq_ring_size);
+    }
+    if (urp->ur_sq_ring) {
+	(void)munmap(urp->ur_sq_ring, urp->ur_sq_ring_size);
+    }
+    /* Note: Closing the ring releases the registered buffers and files. */
+    if (urp->ur_fd != NoFd) {
+	(void)close(urp->ur_fd);
+    }
+    if (urp->ur_nvme_fd != NoFd) {
+	(void)close(urp->ur_nvme_fd);
+    }
+    if (urp->ur_results) {
+	Free(dip, urp->ur_results);
+    }
+    if (urp->ur_done) {
+	Free(dip, urp->ur_done);
+    }
+    Free(dip, urp);
+    dip->di_uring = NULL;
+    return;
+}
+
+static int
+dturing_register_file(dinfo_t *dip, uring_info_t *urp)
+{
+    int fd = (urp->ur_nvme == True) ? urp->ur_nvme_fd : dip->di_fd;
+
+    if (urp->ur_fixed_fd == fd) {
+	return(SUCCESS);
+    }
+    if (urp->ur_fixed_fd != NoFd) {
+	(void)dturing_unregister_file(dip, urp);
+    }
+    if (io_uring_register(urp->ur_fd, IORING_REGISTER_FILES, &fd, 1) < 0) {
+	ReportErrorInfo(dip, dip->di_dname, os_get_error(), "io_uring_register files", OTHER_OP, True);
+	return(FAILURE);
+    }
+    urp->ur_fixed_fd = fd;
+    return(SUCCESS);
+}
+
+static int
+dturing_unregister_file(dinfo_t *dip, uring_info_t *urp)
+{
+    if (urp->ur_fixed_fd == NoFd) {
+	return(SUCCESS);
+    }
+    urp->ur_fixed_fd = NoFd;
+    if (io_uring_register(urp->ur_fd, IORING_UNREGISTER_FILES, NULL, 0) < 0) {
+	ReportErrorInfo(dip, dip->di_dname, os_get_error(), "io_uring_register unregister files", OTHER_OP, True);
+	return(FAILURE);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * dturing_close_file() - Prepare to close the file.
+ *
+ * Description:
+ *	The registered file holds a reference to the open file, so it's
+ * unregistered before closing, to ensure the file is really closed.
+ */
+int
+dturing_close_file(dinfo_t *dip)
+{
+    uring_info_t *urp = dip->di_uring;
+
+    if (urp == NULL) return(SUCCESS);
+    return( dturing_unregister_file(dip, urp) );
+}
+
+static int
+dturing_enter(dinfo_t *dip, uring_info_t *urp, unsigned to_submit,
+	      unsigned min_complete, unsigned flags)
+{
+    int ret;
+
+    if (urp->ur_setup_flags & IORING_SETUP_SQPOLL) {
+	/* The kernel thread consumes the SQ, only wake it if idle. */
+	if ( to_submit &&
+	     (__atomic_load_n(urp->ur_sq_flags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) ) {
+	    flags |= IORING_ENTER_SQ_WAKEUP;
+	}
+	to_submit = 0;
+	if ( (min_complete == 0) && !(flags & IORING_ENTER_SQ_WAKEUP) ) {
+	    urp->ur_sq_pending = 0;
+	    return(SUCCESS);
+	}
+    }
+    do {
+	ret = io_uring_enter(urp->ur_fd, to_submit, min_complete, flags);
+    } while ( (ret < 0) && (errno == EINTR) && (terminating_flag == False) );
+    if (ret < 0) {
+	if (errno != EINTR) {
+	    ReportErrorInfo(dip, dip->di_dname, os_get_error(), "io_uring_enter", OTHER_OP, True);
+	}
+	return(FAILURE);
+    }
+    if ( (urp->ur_setup_flags & IORING_SETUP_SQPOLL) || (ret >= (int)urp->ur_sq_pending) ) {
+	urp->ur_sq_pending = 0;
+    } else {
+	urp->ur_sq_pending -= ret;
+    }
+    return(SUCCESS);
+}
+
+static struct io_uring_sqe *
+dturing_get_sqe(dinfo_t *dip, uring_info_t *urp)
+{
+    unsigned head, tail = *urp->ur_sq_tail;
+    struct io_uring_sqe *sqe;
+
+    head = __atomic_load_n(urp->ur_sq_head, __ATOMIC_ACQUIRE);
+    if ( (tail - head) >= urp->ur_entries ) {
+	/* Queue full, submit pending entries first. */
+	if (dturing_enter(dip, urp, urp->ur_sq_pending, 0, 0) == FAILURE) {
+	    return(NULL);
+	}
+	head = __atomic_load_n(urp->ur_sq_head, __ATOMIC_ACQUIRE);
+	if ( (tail - head) >= urp->ur_entries ) {
+	    Eprintf(dip, "The io_uring submission queue is full!\n");
+	    return(NULL);
+	}
+    }
+    sqe = &urp->ur_sqes[(tail & *urp->ur_sq_mask) << urp->ur_sqe_shift];
+    memset(sqe, 0, (sizeof(*sqe) << urp->ur_sqe_shift));
+    return(sqe);
+}
+
+static void
+dturing_put_sqe(uring_info_t *urp, struct io_uring_sqe *sqe)
+{
+    unsigned tail = *urp->ur_sq_tail;
+
+    urp->ur_sq_array[tail & *urp->ur_sq_mask] = (unsigned)((sqe - urp->ur_sqes) >> urp->ur_sqe_shift);
+    __atomic_store_n(urp->ur_sq_tail, (tail + 1), __ATOMIC_RELEASE);
+    urp->ur_sq_pending++;
+    return;
+}
+
+/*
+ * dturing_queue() - Queue an AIO Read or Write Request.
+ *
+ * Description:
+ *	The request is only placed on the submission queue, and submitted
+ * when we wait for the first request, so all queued requests are submitted
+ * with one system call (or none with SQPOLL).
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	acbp = The AIO control block (buffer, byte count, and offset).
+ *	mode = The test mode (READ_MODE or WRITE_MODE).
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE (errno is set).
+ */
+int
+dturing_queue(dinfo_t *dip, struct aiocb *acbp, test_mode_t mode)
+{
+    uring_info_t *urp = dip->di_uring;
+    struct io_uring_sqe *sqe;
+    int index = (int)(acbp - dip->di_acbs);
+    uint8_t *buffer = (uint8_t *)acbp->aio_buf;
+
+    if (urp == NULL) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    if ( (dip->di_uring_flags & URING_FIXED_FILES) &&
+	 (dturing_register_file(dip, urp) == FAILURE) ) {
+	return(FAILURE);
+    }
+#if defined(URING_NVME)
+    if ( (urp->ur_nvme == True) && (dturing_nvme_check(dip, acbp) == FAILURE) ) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+#endif /* defined(URING_NVME) */
+    if ( (sqe = dturing_get_sqe(dip, urp)) == NULL ) {
+	errno = EAGAIN;
+	return(FAILURE);
+    }
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = (uint32_t)acbp->aio_nbytes;
+    sqe->off = (uint64_t)acbp->aio_offset;
+    sqe->user_data = (uint64_t)(index + 1);
+    if (urp->ur_fixed_fd != NoFd) {
+	sqe->fd = 0;
+	sqe->flags |= IOSQE_FIXED_FILE;
+    } else if (urp->ur_nvme == True) {
+	sqe->fd = urp->ur_nvme_fd;
+    } else {
+	sqe->fd = acbp->aio_fildes;
+    }
+#if defined(URING_NVME)
+    if (urp->ur_nvme == True) {
+	dturing_nvme_prep(dip, urp, sqe, acbp, mode, index);
+    } else
+#endif /* defined(URING_NVME) */
+    /* Note: With the rotate option, the buffer is offset, but still registered. */
+    if ( (urp->ur_fixed_bufs == True) && (index < urp->ur_nbufs) &&
+	 (buffer >= (uint8_t *)dip->di_aiobufs[index]) &&
+	 ((buffer + acbp->aio_nbytes) <= ((uint8_t *)dip->di_aiobufs[index] + dip->di_data_alloc_size)) ) {
+	sqe->opcode = (mode == READ_MODE) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+	sqe->buf_index = (uint16_t)index;
+    } else {
+	sqe->opcode = (mode == READ_MODE) ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+    urp->ur_done[index] = False;
+    dturing_put_sqe(urp, sqe);
+    return(SUCCESS);
+}
+
+/*
+ * dturing_reap() - Reap Completed Requests.
+ *
+ * Description:
+ *	All available completions are saved by AIO control block index,
+ * since requests may complete in any order. Cancel completions are ignored.
+ */
+static void
+dturing_reap(dinfo_t *dip, uring_info_t *urp)
+{
+    unsigned head = *urp->ur_cq_head;
+    unsigned tail = __atomic_load_n(urp->ur_cq_tail, __ATOMIC_ACQUIRE);
+
+    while (head != tail) {
+	struct io_uring_cqe *cqe = &urp->ur_cqes[(head & *urp->ur_cq_mask) << urp->ur_cqe_shift];
+	if (cqe->user_data != URING_CANCEL_DATA) {
+	    int index = (int)(cqe->user_data - 1);
+	    if (index < dip->di_aio_bufs) {
+		int res = cqe->res;
+#if defined(URING_NVME)
+		if (urp->ur_nvme == True) {
+		    /* Passthrough returns zero or the NVMe status, not a byte count. */
+		    if (res == 0) {
+			res = (int)dip->di_acbs[index].aio_nbytes;
+		    } else if (res > 0) {
+			dt_nvme_show_status(dip, "NVMe Passthrough I/O", res);
+			res = -EIO;
+		    }
+		}
+#endif /* defined(URING_NVME) */
+		urp->ur_results[index] = res;
+		urp->ur_done[index] = True;
+	    }
+	}
+	head++;
+    }
+    __atomic_store_n(urp->ur_cq_head, head, __ATOMIC_RELEASE);
+    return;
+}
+
+/*
+ * dturing_wait() - Wait for an AIO Request to Complete.
+ *
+ * Return Value:
+ *	Returns 0 if the request succeeded, an errno if the request failed
+ * (like aio_error), or FAILURE if waiting failed.
+ */
+int
+dturing_wait(dinfo_t *dip, struct aiocb *acbp)
+{
+    uring_info_t *urp = dip->di_uring;
+    int index = (int)(acbp - dip->di_acbs);
+
+    if (urp == NULL) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    dturing_reap(dip, urp);
+    while (urp->ur_done[index] == False) {
+	if (dturing_enter(dip, urp, urp->ur_sq_pending, 1, IORING_ENTER_GETEVENTS) == FAILURE) {
+	    return(FAILURE);
+	}
+	dturing_reap(dip, urp);
+    }
+    return( (urp->ur_results[index] < 0) ? -urp->ur_results[index] : 0 );
+}
+
+/*
+ * dturing_wait_any() - Wait for Any Outstanding AIO Request to Complete.
+ *
+ * Description:
+ *	Used for unordered (completion order) processing. The search for a
+ * completed request begins at the starting index, so the oldest requests
+ * are favored and none are starved by requests completing more quickly.
+ *
+ * Return Value:
+ *	Returns the AIO control block index, or FAILURE if waiting failed
+ * or no requests are outstanding.
+ */
+int
+dturing_wait_any(dinfo_t *dip, int start)
+{
+    uring_info_t *urp = dip->di_uring;
+    int count, index, outstanding;
+
+    if (urp == NULL) {
+	errno = EINVAL;
+	return(FAILURE);
+    }
+    dturing_reap(dip, urp);
+    do {
+	outstanding = 0;
+	for (count = 0, index = start; count < dip->di_aio_bufs; count++) {
+	    if (dip->di_acbs[index].aio_fildes != AIO_NotQed) {
+		if (urp->ur_done[index] == True) {
+		    return(index);
+		}
+		outstanding++;
+	    }
+	    if (++index == dip->di_aio_bufs) index = 0;
+	}
+	if (outstanding == 0) {
+	    errno = EINVAL;
+	    return(FAILURE);
+	}
+	if (dturing_enter(dip, urp, urp->ur_sq_pending, 1, IORING_ENTER_GETEVENTS) == FAILURE) {
+	    return(FAILURE);
+	}
+	dturing_reap(dip, urp);
+    } while (True);
+    /*NOTREACHED*/
+}
+
+/*
+ * dturing_return() - Return the AIO Request Status (like aio_return).
+ *
+ * Return Value:
+ *	Returns the byte count, or FAILURE with errno set.
+ */
+ssize_t
+dturing_return(dinfo_t *dip, struct aiocb *acbp)
+{
+    uring_info_t *urp = dip->di_uring;
+    int index = (int)(acbp - dip->di_acbs);
+
+    if ( (urp == NULL) || (urp->ur_done[index] == False) ) {
+	errno = EINPROGRESS;
+	return(FAILURE);
+    }
+    if (urp->ur_results[index] < 0) {
+	errno = -urp->ur_results[index];
+	return(FAILURE);
+    }
+    return( (ssize_t)urp->ur_results[index] );
+}
+
+/*
+ * dturing_cancel() - Cancel Outstanding Requests.
+ *
+ * Description:
+ *	A cancel request is queued for each outstanding request. Canceled
+ * requests complete with ECANCELED, and are reaped by the waiters.
+ *
+ * Return Value:
+ *	Returns AIO_CANCELED, AIO_ALLDONE, or FAILURE (like aio_cancel).
+ */
+int
+dturing_cancel(dinfo_t *dip)
+{
+    uring_info_t *urp = dip->di_uring;
+    int index, canceled = 0;
+
+    if (urp == NULL) {
+	errno = EBADF;
+	return(FAILURE);
+    }
+    dturing_reap(dip, urp);
+    for (index = 0; index < dip->di_aio_bufs; index++) {
+	struct io_uring_sqe *sqe;
+	if (urp->ur_done[index] == True) continue;
+	if ( (sqe = dturing_get_sqe(dip, urp)) == NULL ) {
+	    return(FAILURE);
+	}
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = (uint64_t)(index + 1);
+	sqe->user_data = URING_CANCEL_DATA;
+	dturing_put_sqe(urp, sqe);
+	canceled++;
+    }
+    if (canceled == 0) {
+	return(AIO_ALLDONE);
+    }
+    if (dturing_enter(dip, urp, urp->ur_sq_pending, 0, 0) == FAILURE) {
+	return(FAILURE);
+    }
+    return(AIO_CANCELED);
+}
+
+
+#if defined(URING_NVME)
+/*
+ * dturing_nvme_open() - Open the NVMe Generic Character Device.
+ *
+ * Description:
+ *	Passthrough commands are issued to the generic device (/dev/ngXnY),
+ * which is derived from the NVMe namespace block device (/dev/nvmeXnY),
+ * unless the generic device was specified directly.
+ *
+ * Return Value:
+ *	Returns SUCCESS / FAILURE.
+ */
+static int
+dturing_nvme_open(dinfo_t *dip, uring_info_t *urp)
+{
+    char *dsf = (dip->di_scsi_dsf) ? dip->di_scsi_dsf : dip->di_dname;
+    char path[PATH_BUFFER_SIZE];
+    char *name = strrchr(dsf, '/');
+    int ctrl, nsid, length = 0;
+    int oflags = (dip->di_output_file) ? O_RDWR : O_RDONLY;
+
+    if ( (dip->di_nvme_flag == False) || (dip->di_nvme_sector_size == 0) ) {
+	Eprintf(dip, "%s is NOT an NVMe namespace, so NVMe passthrough is NOT possible!\n", dsf);
+	return(FAILURE);
+    }
+    name = (name) ? (name + 1) : dsf;
+    if (strncmp(name, "ng", 2) == 0) {
+	(void)strcpy(path, dsf);
+    } else if ( (sscanf(name, "nvme%dn%d%n", &ctrl, &nsid, &length) == 2) &&
+		(name[length] == '\0') ) {
+	(void)sprintf(path, "/dev/ng%dn%d", ctrl, nsid);
+    } else {
+	Eprintf(dip, "Unable to determine the NVMe generic device for %s, please specify /dev/ngXnY!\n", dsf);
+	return(FAILURE);
+    }
+    urp->ur_nvme_fd = open(path, oflags);
+    if (urp->ur_nvme_fd == NoFd) {
+	ReportErrorInfo(dip, path, os_get_error(), OS_OPEN_FILE_OP, OPEN_OP, True);
+	return(FAILURE);
+    }
+    urp->ur_nvme = True;
+    if (dip->di_debug_flag) {
+	Printf(dip, "Using NVMe generic device %s, namespace %u, sector size %u\n",
+	       path, dip->di_namespace_id, dip->di_nvme_sector_size);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * dturing_nvme_check() - Check the Request is Valid for an NVMe Command.
+ */
+static int
+dturing_nvme_check(dinfo_t *dip, struct aiocb *acbp)
+{
+    uint32_t sector_size = dip->di_nvme_sector_size;
+
+    if ( (acbp->aio_offset % sector_size) || (acbp->aio_nbytes % sector_size) ||
+	 (acbp->aio_nbytes == 0) || ((acbp->aio_nbytes / sector_size) > NVME_MAX_BLOCKS) ) {
+	Eprintf(dip, "NVMe request of "SUF" bytes at offset "FUF" is NOT valid for sector size %u!\n",
+		acbp->aio_nbytes, acbp->aio_offset, sector_size);
+	return(FAILURE);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * dturing_nvme_prep() - Prepare an NVMe Read or Write Command.
+ *
+ * Description:
+ *	The NVMe command is placed in the big SQE command area. The block
+ * count is zero based, as with the synchronous NVMe I/O (see dtnvme.c).
+ */
+static void
+dturing_nvme_prep(dinfo_t *dip, uring_info_t *urp, struct io_uring_sqe *sqe,
+		  struct aiocb *acbp, test_mode_t mode, int index)
+{
+    struct nvme_uring_cmd *cmd = (struct nvme_uring_cmd *)sqe->cmd;
+    uint8_t *buffer = (uint8_t *)acbp->aio_buf;
+    uint64_t slba = (uint64_t)(acbp->aio_offset / dip->di_nvme_sector_size);
+    uint32_t nblocks = (uint32_t)(acbp->aio_nbytes / dip->di_nvme_sector_size);
+
+    sqe->opcode = IORING_OP_URING_CMD;
+    sqe->off = 0;
+    sqe->addr = 0;
+    sqe->len = 0;
+    sqe->cmd_op = NVME_URING_CMD_IO;
+    cmd->opcode = (mode == READ_MODE) ? NVME_CMD_READ : NVME_CMD_WRITE;
+    cmd->nsid = dip->di_namespace_id;
+    cmd->addr = (uint64_t)(uintptr_t)buffer;
+    cmd->data_len = (uint32_t)acbp->aio_nbytes;
+    cmd->cdw10 = (uint32_t)(slba & 0xffffffff);
+    cmd->cdw11 = (uint32_t)(slba >> 32);
+    cmd->cdw12 = (nblocks - 1);
+    if ( (urp->ur_fixed_bufs == True) && (index < urp->ur_nbufs) &&
+	 (buffer >= (uint8_t *)dip->di_aiobufs[index]) &&
+	 ((buffer + acbp->aio_nbytes) <= ((uint8_t *)dip->di_aiobufs[index] + dip->di_data_alloc_size)) ) {
+	sqe->uring_cmd_flags = IORING_URING_CMD_FIXED;
+	sqe->buf_index = (uint16_t)index;
+    }
+    return;
+}
+#endif /* defined(URING_NVME) */
+
+#endif /* defined(AIO) && defined(URING) */
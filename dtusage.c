@@ -31,6 +31,48 @@
  *
  * Modification History:
  *
+ * October 16th, 2026 by Robin T. Miller
+ *      Note the %json keepalives have no message prefix.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add the time series tsfile= and tsinterval= options.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add history_file= (hfile=) and showhistory= options.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add the asynclog flag.
+ *
+ * October 16th, 2026 by Robin T. Miller
+ *      Add the bufhuge flag.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Note the io_uring NVMe passthrough (enable=uring,nvme_io).
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add the pfmap and pfhuge flags.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add rdist= option and the random distributions.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add stats=json and the %json keepalive keyword.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add iochunk= option.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add iotformula enable/disable flag.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add aiounordered enable/disable flag.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add uring enable/disable flag and uring_flags= option.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add simd enable/disable flag.
+ *
  * October 25th, 2025 by Robin T. Miller
  *      Add options and keepalive format control strings for latency support.
  * 
@@ -99,6 +141,8 @@ dthelp(dinfo_t *dip)
     P (dip, "\tibs=value             The read block size. (overrides bs=)\n");
     P (dip, "\tobs=value             The write block size. (overrides bs=)\n");
     P (dip, "\tjob_log=filename      The job log file name. (alias: jlog=)\n");
+    P (dip, "\ttsfile=filename       The job time series (CSV) file name.\n");
+    P (dip, "\ttsinterval=value      The time series interval. (D: %ums)\n", DEFAULT_TS_INTERVAL);
     P (dip, "\tlogdir=filename       The log directory name.\n");
     P (dip, "\tlog[atu]=filename     The thread log file name to write.\n");
     P (dip, "\t                      a=append, t=truncate, u=unique (w/tid)\n");
@@ -109,6 +153,10 @@ dthelp(dinfo_t *dip)
 #if defined(AIO)
     P (dip, "\taios=value            Set number of AIO's to queue.\n");
 #endif /* defined(AIO) */
+#if defined(AIO) && defined(URING)
+    P (dip, "\turing_flags=flags     The io_uring flags (fixedbufs,fixedfiles,sqpoll,none).\n");
+    P (dip, "\t                      With enable=nvme_io, NVMe passthrough via /dev/ngXnY.\n");
+#endif /* defined(AIO) && defined(URING) */
 #if !defined(_QNX_SOURCE)
     P (dip, "\talarm=time            The keepalive alarm time.\n");
     P (dip, "\tkeepalive=string      The keepalive message string.\n");
@@ -144,6 +192,7 @@ dthelp(dinfo_t *dip)
     P (dip, "\tincr=value            Set number of record bytes to increment.\n");
     P (dip, "    or\tincr=variable         Enables variable I/O request sizes.\n");
     P (dip, "\tiops=value            Set I/O per second (this is per thread).\n");
+    P (dip, "\tiochunk=value         Set the records claimed per thread (iolock).\n");
     P (dip, "\tiodir=direction       Set I/O direction to: {forward, reverse, or vary}.\n");
     P (dip, "\tiomode=mode           Set I/O mode to: {copy, mirror, test, or verify}.\n");
     P (dip, "\tiotype=type           Set I/O type to: {random, sequential, or vary}.\n");
@@ -154,6 +203,7 @@ dthelp(dinfo_t *dip)
     P (dip, "\thistory_bufs=value    Set the history data buffers (per request).(or hbufs)\n");
     P (dip, "\thistory_bsize=value   Set the history block data size increment. (or hbsize)\n");
     P (dip, "\thistory_data=value    Set the history data size (bytes to save). (or hdsize)\n");
+    P (dip, "\thistory_file=file     Keep the history in a mapped file.         (or hfile)\n");
     P (dip, "\tmin=value             Set the minumum record size to transfer.\n");
     P (dip, "\tmax=value             Set the maximum record size to transfer.\n");
     P (dip, "\tlba=value             Set starting block used w/lbdata option.\n");
@@ -199,6 +249,7 @@ dthelp(dinfo_t *dip)
     P (dip, "\tqdepth=value          Set the queue depth to specified value.\n");
 #endif /* defined(HP_UX) */
     P (dip, "\tralign=value          The random I/O offset alignment.\n");
+    P (dip, "\trdist=type            The random access distribution. (see below)\n");
     P (dip, "\trlimit=value          The random I/O data byte limit.\n");
     P (dip, "\trseed=value           The random number generator seed.\n");
     P (dip, "\trecords=value         The number of records to process.\n");
@@ -216,7 +267,7 @@ dthelp(dinfo_t *dip)
     P (dip, "\tskip=value            The number of records to skip past.\n");
     P (dip, "\tseek=value            The number of records to seek past.\n");
     P (dip, "\tstep=value            The number of bytes seeked after I/O.\n");
-    P (dip, "\tstats=level           The stats level: {brief, full, or none}\n");
+    P (dip, "\tstats=level           The stats level: {brief, full, json, or none}\n");
     P (dip, "\tstopon=filename       Watch for file existence, then stop.\n");
     P (dip, "\tsleep=time            The sleep time (in seconds).\n");
     P (dip, "\tmsleep=value          The msleep time (in milliseconds).\n");
@@ -224,6 +275,7 @@ dthelp(dinfo_t *dip)
     P (dip, "\tshowbtags opts...     Show block tags and btag data.\n");
     P (dip, "\tshowfslba             Show file system offset to physical LBA.\n");
     P (dip, "\tshowfsmap             Show file system map extent information.\n");
+    P (dip, "\tshowhistory=file      Show (decode) a history file.\n");
     P (dip, "\tshowtime=value        Show time value in ctime() format.\n");
     P (dip, "\tshowvflags=value      Show block tag verify flags set.\n");
     P (dip, "\tthreads=value         The number of threads to execute.\n");
@@ -259,6 +311,15 @@ dthelp(dinfo_t *dip)
     P (dip, "\tlatmin=value          The minimum latency (in microseconds).\n");
     P (dip, "\tlatmax=value          The maximum latency (in microseconds).\n");
 
+    P (dip, "\n    Random Distributions: (rdist=type)\n");
+    P (dip, "\tuniform               Uniform random offsets (the default).\n");
+    P (dip, "\tzipf[:theta]          Zipf, where theta is the skew (default 0.99).\n");
+    P (dip, "\tpareto[:h]            Pareto, h of the blocks get 1-h of I/O (default 0.2).\n");
+    P (dip, "\thotcold[:hot[:io]]    The hot %% of blocks get io %% of I/O (default 20:80).\n");
+    P (dip, "\tnormal[:stddev]       Normal, centered, stddev %% of range (default 10).\n");
+    P (dip, "\t                      Note: Hot blocks are at the start of the range,\n");
+    P (dip, "\t                      and the hot set coverage is reported in stats.\n");
+
 #if defined(Nimble)
     P (dip, "\n    DSD Core Actions:\n");
     P (dip, "\tcore                  Restart DSD with core.\n");
@@ -419,7 +480,13 @@ dthelp(dinfo_t *dip)
 #if defined(AIO)
     P (dip, "\taio              POSIX Asynchronous I/O.    (Default: %s)\n",
 				(dip->di_aio_flag) ? enabled_str : disabled_str);
+    P (dip, "\taiounordered     AIO completion order.      (Default: %s)\n",
+				(dip->di_aio_unordered) ? enabled_str : disabled_str);
 #endif /* defined(AIO) */
+#if defined(AIO) && defined(URING)
+    P (dip, "\turing            Linux io_uring AIO engine. (Default: %s)\n",
+				(dip->di_uring_flag) ? enabled_str : disabled_str);
+#endif /* defined(AIO) && defined(URING) */
     P (dip, "\tasync            Asynchronous job control.  (Default: %s)\n",
 				(dip->di_async_job) ? enabled_str : disabled_str);
     P (dip, "\tbtags            Block tag control flag.    (Default: %s)\n",
@@ -509,6 +576,8 @@ dthelp(dinfo_t *dip)
 			 	(dip->di_image_copy) ? enabled_str : disabled_str);
     P (dip, "\tiolock           I/O lock control.          (Default: %s)\n",
 			 	(dip->di_iolock) ? enabled_str : disabled_str);
+    P (dip, "\tiotformula       IOT verify by formula.     (Default: %s)\n",
+			 	(dip->di_iot_formula) ? enabled_str : disabled_str);
     P (dip, "\tlbdata           Logical block data.        (Default: %s)\n",
 				(dip->di_lbdata_flag) ? enabled_str : disabled_str);
     P (dip, "\tlogpid           Log process ID.            (Default: %s)\n",
@@ -533,6 +602,14 @@ dthelp(dinfo_t *dip)
 				(dip->di_multi_flag) ? enabled_str : disabled_str);
     P (dip, "\tnoprog           No progress check.         (Default: %s)\n",
 				(dip->di_noprog_flag) ? enabled_str : disabled_str);
+    P (dip, "\tasynclog         Asynchronous thread logs.  (Default: %s)\n",
+				(dip->di_async_log) ? enabled_str : disabled_str);
+    P (dip, "\tbufhuge          Data buffer huge pages.    (Default: %s)\n",
+				(dip->di_bufhuge_flag) ? enabled_str : disabled_str);
+    P (dip, "\tpfhuge           Pattern file huge pages.   (Default: %s)\n",
+				(dip->di_pfhuge_flag) ? enabled_str : disabled_str);
+    P (dip, "\tpfmap            Map pattern files shared.  (Default: %s)\n",
+				(dip->di_pfmap_flag) ? enabled_str : disabled_str);
     P (dip, "\tpipes            Pipe mode control flag.    (Default: %s)\n",
 				(PipeModeFlag) ? enabled_str : disabled_str);
     P (dip, "\tpoison           Poison read buffer flag.   (Default: %s)\n",
@@ -568,6 +645,9 @@ dthelp(dinfo_t *dip)
 				(dip->di_script_verify) ? enabled_str : disabled_str);   
     P (dip, "\tsighup           Hangup signal control.     (Default: %s)\n",
 				(sighup_flag) ? enabled_str : disabled_str);   
+    P (dip, "\tsimd             SIMD data patterns (%-4s). (Default: %s)\n",
+				simd_type_name(simd_type),
+				(dip->di_simd_flag) ? enabled_str : disabled_str);
 #if defined(WIN32)
     P (dip, "\tsparse           Sparse file attribute.     (Default: %s)\n",
 				(dip->di_sparse_flag) ? enabled_str : disabled_str);   
@@ -765,6 +845,8 @@ dthelp(dinfo_t *dip)
     P (dip, "\t    %%kbps = Kilobytes per second.     %%mbps = The megabytes per second.\n");
     P (dip, "\t    %%iops = The I/O's per second.     %%spio = The seconds per I/O.\n");
     P (dip, "\n");
+    P (dip, "\t    %%json = The statistics as a JSON object (bytes, records, IOPS, latency, errors).\n");
+    P (dip, "\t    JSON keepalives are printed without the message prefix, one object per line.\n");
     P (dip, "\t    Lowercase means per pass stats, while uppercase means total stats.\n");
     P (dip, "\n    I/O Keywords:\n");
     P (dip, "\t    %%iodir = The I/O direction.       %%iotype = The I/O type.\n");
@@ -891,7 +973,8 @@ dthelp(dinfo_t *dip)
 			(dip->di_io_mode == COPY_MODE) ? "copy" : "verify");
     P (dip, ", iotype=%s", (dip->di_io_type == RANDOM_IO) ? "random" : "sequential");
     P (dip, ", stats=%s\n", (dip->di_stats_level == STATS_BRIEF) ? "brief" :
-                       (dip->di_stats_level == STATS_FULL) ? "full" : "none");
+                       (dip->di_stats_level == STATS_FULL) ? "full" :
+                       (dip->di_stats_level == STATS_JSON) ? "json" : "none");
     P (dip, "\tiotseed=0x%08x, hdsize=%d", dip->di_iot_seed, dip->di_history_data_size);
     P (dip, ", maxbad=%u\n", dip->di_max_bad_blocks);
     P (dip, "\n    --> %s <--\n", version_str);
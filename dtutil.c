@@ -31,6 +31,29 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      The pattern file map lock is now initialized once at startup.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Map pattern files read-only once per process and share the mapping
+ * across threads and jobs (enable=pfmap), with optional huge pages via
+ * enable=pfhuge. The read path remains the fallback.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Select the random offset from the random distribution (rdist=),
+ * when one is specified, in alignment units within the random limit.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Clear the deferred IOT data state in setup_pattern().
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add compare_buffer(), the vector compare fast path for verify.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Replace the byte at a time fill_buffer() loops with a fill engine,
+ * which copies from a replicated pattern span (or vector stores), and with
+ * btags or a prefix, stamps each lbdata block from a prebuilt template.
+ *
  * April 29th, 2026 by Robin T. Miller
  *      Fix issue with setting END_OF_FILE (254) exit status, so enable=eof
  * will exit with EOF status for those desiring to detect an EOF condition.
@@ -123,6 +146,7 @@
 #  include <strings.h>
 #  include <sys/param.h>
 #  include <netdb.h>		/* for MAXHOSTNAMELEN */
+#  include <sys/mman.h>
 #  include <sys/time.h>		/* for gettimeofday() */
 #  include <sys/wait.h>
 #endif /* !defined(WIN32) */
@@ -308,6 +332,259 @@ timer_now(struct timeval *timer)
     return (((uint64_t)delta.tv_sec * (uint64_t)1000000) + (uint64_t)delta.tv_usec);
 }
 
+/*
+ * fill_engine_span() - Setup the Replicated Pattern Span.
+ *
+ * Description:
+ *	The pattern is replicated, so from any pattern phase (offset) we
+ * can copy up to FILL_SPAN_SIZE bytes contiguously. Large patterns (IOT,
+ * pattern files) are not replicated, since they are copied directly.
+ * Note: The pattern content is compared, since the pattern buffer is
+ * often reused with a new pattern (per pass patterns), or replaced.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *
+ * Return Value:
+ *	Returns the fill engine pointer, or NULL on allocation failure.
+ */
+static fill_engine_t *
+fill_engine_span(dinfo_t *dip)
+{
+    fill_engine_t *fep = dip->di_fill_engine;
+    size_t psize = dip->di_pattern_bufsize;
+    uint8_t *sptr;
+    size_t scount;
+
+    if (fep == NULL) {
+	fep = dip->di_fill_engine = Malloc(dip, sizeof(*fep));
+	if (fep == NULL) return(NULL);
+    }
+    if (psize >= FILL_SPAN_SIZE) {
+	fep->fe_pattern_size = psize;
+	return(fep);
+    }
+    if ( fep->fe_span && (fep->fe_pattern_size == psize) &&
+	 (memcmp(fep->fe_span, dip->di_pattern_buffer, psize) == 0) ) {
+	return(fep);
+    }
+    if (fep->fe_span == NULL) {
+	fep->fe_span_size = (FILL_SPAN_SIZE * 2);
+	fep->fe_span = malloc_palign(dip, fep->fe_span_size, 0);
+	if (fep->fe_span == NULL) return(NULL);
+    }
+    fep->fe_pattern_size = psize;
+    for (sptr = fep->fe_span, scount = fep->fe_span_size; scount; ) {
+	size_t count = MIN(psize, scount);
+	memcpy(sptr, dip->di_pattern_buffer, count);
+	sptr += count;
+	scount -= count;
+    }
+    /* New pattern, so the template must be rebuilt too. */
+    fep->fe_template_size = 0;
+    return(fep);
+}
+
+/*
+ * fill_pattern_bytes() - Copy Pattern Bytes at a Pattern Phase.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	fep = The fill engine pointer.
+ *	bptr = The buffer to fill.
+ *	count = The number of pattern bytes.
+ *	phase = The starting pattern phase (offset into pattern).
+ *
+ * Return Value:
+ *	Returns the updated pattern phase.
+ */
+static size_t
+fill_pattern_bytes(dinfo_t *dip, fill_engine_t *fep, uint8_t *bptr, size_t count, size_t phase)
+{
+    size_t psize = fep->fe_pattern_size;
+
+    if (psize < FILL_SPAN_SIZE) {
+	if ((SIMD_PATTERN_SPAN % psize) == 0) {
+	    simd_fill_periodic(dip, bptr, count, fep->fe_span + phase);
+	    return( (phase + count) % psize );
+	}
+	while (count) {
+	    size_t chunk = MIN(count, FILL_SPAN_SIZE);
+	    memcpy(bptr, fep->fe_span + phase, chunk);
+	    bptr += chunk;
+	    count -= chunk;
+	    phase = (phase + chunk) % psize;
+	}
+    } else {
+	/* Large patterns are copied directly, wrapping at the end. */
+	while (count) {
+	    size_t chunk = MIN(count, (psize - phase));
+	    memcpy(bptr, (dip->di_pattern_buffer + phase), chunk);
+	    bptr += chunk;
+	    count -= chunk;
+	    phase += chunk;
+	    if (phase == psize) phase = 0;
+	}
+    }
+    return(phase);
+}
+
+/*
+ * compare_pattern_bytes() - Compare Pattern Bytes at a Pattern Phase.
+ *
+ * Return Value:
+ *	Returns True if the data matches (phase updated), else False.
+ */
+static hbool_t
+compare_pattern_bytes(dinfo_t *dip, fill_engine_t *fep, uint8_t *bptr, size_t count, size_t *phasep)
+{
+    size_t psize = fep->fe_pattern_size;
+    size_t phase = *phasep;
+
+    if (psize < FILL_SPAN_SIZE) {
+	if ((SIMD_PATTERN_SPAN % psize) == 0) {
+	    if (simd_compare_periodic(dip, bptr, count, fep->fe_span + phase) == False) {
+		return(False);
+	    }
+	    *phasep = (phase + count) % psize;
+	    return(True);
+	}
+	while (count) {
+	    size_t chunk = MIN(count, FILL_SPAN_SIZE);
+	    if (simd_compare_buffers(dip, bptr, fep->fe_span + phase, chunk) == False) {
+		return(False);
+	    }
+	    bptr += chunk;
+	    count -= chunk;
+	    phase = (phase + chunk) % psize;
+	}
+    } else {
+	while (count) {
+	    size_t chunk = MIN(count, (psize - phase));
+	    if (simd_compare_buffers(dip, bptr, (dip->di_pattern_buffer + phase), chunk) == False) {
+		return(False);
+	    }
+	    bptr += chunk;
+	    count -= chunk;
+	    phase += chunk;
+	    if (phase == psize) phase = 0;
+	}
+    }
+    *phasep = phase;
+    return(True);
+}
+
+/*
+ * fill_engine_template() - Setup the lbdata Block Template.
+ *
+ * Description:
+ *	The template is used only when the pattern bytes per block are a
+ * multiple of the pattern size, since then every block is identical.
+ * The btag hole is left as zeros, since it's never copied to the buffer.
+ *
+ * Return Value:
+ *	Returns True if the template is valid, else False.
+ */
+static hbool_t
+fill_engine_template(dinfo_t *dip, fill_engine_t *fep,
+		     size_t hole_size, size_t prefix_size, size_t phase)
+{
+    size_t lbdata_size = dip->di_lbdata_size;
+    size_t pattern_bytes = (lbdata_size - hole_size - prefix_size);
+
+    if ( (fep->fe_pattern_size > pattern_bytes) ||
+	 (pattern_bytes % fep->fe_pattern_size) ) {
+	return(False);
+    }
+    if ( (fep->fe_template_size == lbdata_size) &&
+	 (fep->fe_template_phase == phase) &&
+	 (fep->fe_hole_size == hole_size) &&
+	 (fep->fe_prefix_size == prefix_size) &&
+	 ( (prefix_size == 0) ||
+	   (memcmp(fep->fe_template + hole_size, dip->di_fprefix_string, prefix_size) == 0) ) ) {
+	return(True);
+    }
+    if ( fep->fe_template && (fep->fe_template_size != lbdata_size) ) {
+	free_palign(dip, fep->fe_template);
+	fep->fe_template = NULL;
+    }
+    if (fep->fe_template == NULL) {
+	fep->fe_template = malloc_palign(dip, lbdata_size, 0);
+	if (fep->fe_template == NULL) return(False);
+    }
+    fep->fe_template_size = lbdata_size;
+    fep->fe_template_phase = phase;
+    fep->fe_hole_size = hole_size;
+    fep->fe_prefix_size = prefix_size;
+    memset(fep->fe_template, '\0', hole_size);
+    if (prefix_size) {
+	memcpy(fep->fe_template + hole_size, dip->di_fprefix_string, prefix_size);
+    }
+    (void)fill_pattern_bytes(dip, fep, (fep->fe_template + hole_size + prefix_size),
+			     pattern_bytes, phase);
+    return(True);
+}
+
+void
+free_fill_engine(dinfo_t *dip)
+{
+    fill_engine_t *fep = dip->di_fill_engine;
+
+    if (fep == NULL) return;
+    if (fep->fe_span) {
+	free_palign(dip, fep->fe_span);
+    }
+    if (fep->fe_template) {
+	free_palign(dip, fep->fe_template);
+    }
+    Free(dip, fep);
+    dip->di_fill_engine = NULL;
+    return;
+}
+
+/*
+ * fill_buffer_bytes() - Fill Buffer a Byte at a Time.
+ *
+ * Note: This is only used when the lbdata size is too small to hold the
+ * block tag and prefix string, which is not a sensible configuration.
+ */
+static void
+fill_buffer_bytes(dinfo_t *dip, void *buffer, size_t byte_count)
+{
+    register unsigned char *bptr = buffer;
+    register unsigned char *pptr, *pend;
+    register size_t bcount = byte_count;
+    register lbdata_t lbdata_size = dip->di_lbdata_size;
+    register size_t i;
+
+    pptr = dip->di_pattern_bufptr;
+    pend = dip->di_pattern_bufend;
+
+    for (i = 0; i < bcount; ) {
+	if ((i % lbdata_size) == 0) {
+	    size_t pcount;
+	    if (dip->di_btag) {
+		i += getBtagSize(dip->di_btag);
+		bptr += getBtagSize(dip->di_btag);
+		if (i >= bcount) break;
+	    }
+	    if (dip->di_fprefix_string) {
+		pcount = copy_prefix(dip, bptr, (bcount - i));
+		i += pcount;
+		bptr += pcount;
+		continue;
+	    }
+	    if (dip->di_btag) continue;
+	}
+	*bptr++ = *pptr++; i++;
+	if (pptr == pend) {
+	    pptr = dip->di_pattern_buffer;
+	}
+    }
+    dip->di_pattern_bufptr = pptr;
+    return;
+}
+
 /************************************************************************
  *									*
  * fill_buffer() - Fill Buffer with a Data Pattern.			*
@@ -316,6 +593,11 @@ timer_now(struct timeval *timer)
  *	If a pattern_buffer exists, then this data is used to fill the	*
  * buffer instead of the data pattern specified.			*
  *									*
+ *	The pattern is copied from a replicated span (or stamped with	*
+ * vector stores), and with btags or a prefix, each lbdata block is	*
+ * stamped from a prebuilt template. The pattern stream is continuous	*
+ * across blocks, skipping the btag and prefix, as it has always been.	*
+ *									*
  * Inputs:							        * 
  *	dip = The device information pointer.				*
  * 	buffer = Pointer to buffer to fill.				*
@@ -332,74 +614,183 @@ fill_buffer (   dinfo_t     *dip,
 		size_t      byte_count,
 		u_int32     pattern)
 {
-    register unsigned char *bptr = buffer;
-    register unsigned char *pptr, *pend;
-    register size_t bcount = byte_count;
-    register lbdata_t lbdata_size = dip->di_lbdata_size;
-    register size_t i;
+    uint8_t *bptr = buffer;
+    size_t bcount = byte_count;
+    size_t lbdata_size = dip->di_lbdata_size;
+    size_t hole_size = 0, prefix_size = 0;
+    size_t phase;
+    fill_engine_t *fep;
 
-    pptr = dip->di_pattern_bufptr;
-    pend = dip->di_pattern_bufend;
+    if ( (fep = fill_engine_span(dip)) == NULL ) {
+	return;
+    }
+    phase = (size_t)(dip->di_pattern_bufptr - dip->di_pattern_buffer);
+
+    if ( (dip->di_btag_flag == False) && (dip->di_fprefix_string == NULL) ) {
+	phase = fill_pattern_bytes(dip, fep, bptr, bcount, phase);
+	dip->di_pattern_bufptr = (dip->di_pattern_buffer + phase);
+	return;
+    }
+    if (dip->di_btag) {
+	hole_size = getBtagSize(dip->di_btag);
+    }
+    if (dip->di_fprefix_string) {
+	prefix_size = (size_t)dip->di_fprefix_size;
+    }
+    if ( (lbdata_size == 0) || ((hole_size + prefix_size) >= lbdata_size) ) {
+	fill_buffer_bytes(dip, buffer, byte_count);
+	return;
+    }
 
     /*
-     * Initialize the buffer with a data pattern and optional prefix.
+     * Fill each lbdata block, leaving a hole for the block tag (if any),
+     * followed by the prefix string (if any), then the data pattern.
      */
-    if ( dip->di_btag_flag && (dip->di_fprefix_string == NULL) ) {
-	size_t btag_size = getBtagSize(dip->di_btag);
-	for (i = 0; i < bcount; ) {
-	    if ((i % lbdata_size) == 0) {
-		i += btag_size;
-		bptr += btag_size;
-		continue;
-	    }
-	    *bptr++ = *pptr++; i++;
-	    if (pptr == pend) {
-		pptr = dip->di_pattern_buffer;
+    if ( fill_engine_template(dip, fep, hole_size, prefix_size, phase) == True ) {
+	size_t tsize = (lbdata_size - hole_size);
+	uint8_t *tptr = (fep->fe_template + hole_size);
+	/* Note: Full blocks do not change the phase, by definition. */
+	while (bcount >= lbdata_size) {
+	    memcpy(bptr + hole_size, tptr, tsize);
+	    bptr += lbdata_size;
+	    bcount -= lbdata_size;
+	}
+	if (bcount > hole_size) {
+	    size_t count = (bcount - hole_size);
+	    memcpy(bptr + hole_size, tptr, count);
+	    if (count > prefix_size) {
+		phase = (phase + (count - prefix_size)) % fep->fe_pattern_size;
 	    }
 	}
-    } else if (dip->di_fprefix_string == NULL) {
-	while (bcount--) {
-            *bptr++ = *pptr++;
-            if (pptr == pend) {
-                pptr = dip->di_pattern_buffer;
-            }
-        }
     } else {
-	/*
-	 * Fill the buffer with a prefix and a data pattern.
-	 */
-	for (i = 0; i < bcount; ) {
-	    /*
-	     * Please Note: This code is a major performance bottleneck! ;(
-	     * Also Note: 64-bit Linux binary is slower than 32-bit version!
-	     * Note: The IOT loops are faster due to aligned 32-bit copies.
-	     * Optimizing is for another day, but a block tag is preferred!
-	     * Obviously, optimized compiled code also make a big difference.
-	     * FWIW: Inlining the prefix copy, made very little difference.
-	     */
-	    if ((i % lbdata_size) == 0) {
+	while (bcount) {
+	    size_t count = MIN(bcount, lbdata_size);
+	    size_t remaining = count;
+	    uint8_t *ptr = bptr;
+	    if (remaining > hole_size) {
 		size_t pcount;
-		if (dip->di_btag) {
-		    btag_t *btag = dip->di_btag;
-		    size_t btag_size = sizeof(*btag) + btag->btag_opaque_data_size;
-		    i += btag_size;
-		    bptr += btag_size;
+		ptr += hole_size;
+		remaining -= hole_size;
+		pcount = MIN(prefix_size, remaining);
+		if (pcount) {
+		    memcpy(ptr, dip->di_fprefix_string, pcount);
+		    ptr += pcount;
+		    remaining -= pcount;
+		}
+		if (remaining) {
+		    phase = fill_pattern_bytes(dip, fep, ptr, remaining, phase);
 		}
-		pcount = copy_prefix(dip, bptr, (bcount - i));
-		i += pcount;
-		bptr += pcount;
-		continue;
-	    }
-	    *bptr++ = *pptr++; i++;
-	    if (pptr == pend) {
-		pptr = dip->di_pattern_buffer;
 	    }
+	    bptr += count;
+	    bcount -= count;
 	}
     }
-    dip->di_pattern_bufptr = pptr;
+    dip->di_pattern_bufptr = (dip->di_pattern_buffer + phase);
     return;
 }
 
+/*
+ * compare_buffer() - Compare Buffer with the Data Pattern (fast path).
+ *
+ * Description:
+ *	This is the inverse of fill_buffer(), comparing whole lbdata blocks
+ * with vector compares, against the replicated pattern or block template.
+ * The prefix string (if any) is compared, and with lbdata, the encoded
+ * lba following the prefix is checked (the pattern stream includes the
+ * lba bytes, since init_lbdata() overwrites the pattern).
+ *
+ *	Nothing is reported here! On a mismatch, the caller falls back to
+ * its byte by byte compare, to report the exact failing offset.
+ *
+ * Inputs:
+ *	dip = The device information pointer.
+ *	buffer = The buffer to compare.
+ *	byte_count = The number of bytes to compare.
+ *	lba = Pointer to the starting lba for lbdata, else NULL.
+ *
+ * Return Value:
+ *	Returns True if the data is correct, and the pattern buffer pointer
+ * (and lba) are updated, else False with nothing updated.
+ */
+hbool_t
+compare_buffer(dinfo_t *dip, void *buffer, size_t byte_count, lbdata_t *lba)
+{
+    uint8_t *bptr = buffer;
+    size_t bcount = byte_count;
+    size_t lbdata_size = dip->di_lbdata_size;
+    size_t prefix_size = 0;
+    size_t lba_size = (lba) ? sizeof(*lba) : 0;
+    lbdata_t vlbn = (lba) ? *lba : 0;
+    size_t phase;
+    fill_engine_t *fep;
+
+    if ( (fep = fill_engine_span(dip)) == NULL ) {
+	return(False);
+    }
+    phase = (size_t)(dip->di_pattern_bufptr - dip->di_pattern_buffer);
+    if (dip->di_fprefix_string) {
+	prefix_size = (size_t)dip->di_fprefix_size;
+    }
+    if ( (prefix_size == 0) && (lba == NULL) ) {
+	if (compare_pattern_bytes(dip, fep, bptr, bcount, &phase) == False) {
+	    return(False);
+	}
+	dip->di_pattern_bufptr = (dip->di_pattern_buffer + phase);
+	return(True);
+    }
+    if ( (lbdata_size == 0) || ((prefix_size + lba_size) >= lbdata_size) ) {
+	return(False);
+    }
+
+    if ( (lba == NULL) && (fill_engine_template(dip, fep, 0, prefix_size, phase) == True) ) {
+	while (bcount >= lbdata_size) {
+	    if (simd_compare_buffers(dip, bptr, fep->fe_template, lbdata_size) == False) {
+		return(False);
+	    }
+	    bptr += lbdata_size;
+	    bcount -= lbdata_size;
+	}
+	if (bcount) {
+	    if (simd_compare_buffers(dip, bptr, fep->fe_template, bcount) == False) {
+		return(False);
+	    }
+	    if (bcount > prefix_size) {
+		phase = (phase + (bcount - prefix_size)) % fep->fe_pattern_size;
+	    }
+	}
+    } else {
+	while (bcount) {
+	    size_t count = MIN(bcount, lbdata_size);
+	    size_t remaining = count;
+	    uint8_t *ptr = bptr;
+	    size_t pcount = MIN(prefix_size, remaining);
+	    if ( pcount && (memcmp(ptr, dip->di_fprefix_string, pcount) != 0) ) {
+		return(False);
+	    }
+	    ptr += pcount;
+	    remaining -= pcount;
+	    /* Note: A partial lba (at the end) is compared as pattern bytes. */
+	    if ( lba_size && (remaining >= lba_size) ) {
+		if ((lbdata_t)stoh(ptr, lba_size) != vlbn) {
+		    return(False);
+		}
+		vlbn++;
+		ptr += lba_size;
+		remaining -= lba_size;
+		phase = (phase + lba_size) % fep->fe_pattern_size;
+	    }
+	    if ( remaining && (compare_pattern_bytes(dip, fep, ptr, remaining, &phase) == False) ) {
+		return(False);
+	    }
+	    bptr += count;
+	    bcount -= count;
+	}
+    }
+    dip->di_pattern_bufptr = (dip->di_pattern_buffer + phase);
+    if (lba) *lba = vlbn;
+    return(True);
+}
+
 /************************************************************************
  *									*
  * init_buffer() - Initialize Buffer with a Data Pattern.		*
@@ -812,6 +1203,241 @@ copy_prefix( dinfo_t *dip, u_char *buffer, size_t bcount )
     return(pcount);
 }
 
+#if !defined(WIN32)
+/*
+ * Pattern File Mappings:
+ *
+ * Pattern files are mapped read-only once per process, and the mapping is
+ * shared by every thread and job referencing the same file, rather than each
+ * thread reading its own private copy. The fill and verify functions use the
+ * mapping directly. Mappings are reference counted, and get unmapped when the
+ * last user resets its pattern buffer.
+ */
+typedef struct pfile_map {
+    struct pfile_map *pm_next;	/* Next pattern file mapping.	*/
+    dev_t	pm_dev;		/* The pattern file device.	*/
+    ino_t	pm_ino;		/* The pattern file inode.	*/
+    time_t	pm_mtime;	/* The file modification time.	*/
+    size_t	pm_size;	/* The pattern file size.	*/
+    size_t	pm_map_size;	/* The size actually mapped.	*/
+    uint8_t	*pm_buffer;	/* The mapped pattern buffer.	*/
+    int		pm_refs;	/* The number of references.	*/
+} pfile_map_t;
+
+#define PFILE_HUGE_PAGE_SIZE	(2 * MBYTE_SIZE)
+
+static pfile_map_t *pfile_maps = NULL;
+
+static void
+acquire_pfile_map_lock(dinfo_t *dip)
+{
+    int error;
+
+    if ( (error = pthread_mutex_lock(&pfile_map_lock)) != SUCCESS) {
+	tPerror(dip, error, "Failed to acquire pattern file map lock!");
+    }
+    return;
+}
+
+static void
+release_pfile_map_lock(dinfo_t *dip)
+{
+    int error;
+
+    if ( (error = pthread_mutex_unlock(&pfile_map_lock)) != SUCCESS) {
+	tPerror(dip, error, "Failed to release pattern file map lock!");
+    }
+    return;
+}
+
+/*
+ * map_pattern_huge() - Copy the pattern file into huge page memory.
+ *
+ * Huge pages are not available for regular file mappings, so an anonymous
+ * huge page mapping is populated from the file, then made read-only.
+ *
+ * Return Value:
+ *	The huge page buffer or NULL if huge pages are not available.
+ */
+static uint8_t *
+map_pattern_huge(dinfo_t *dip, int fd, size_t size, size_t *map_size)
+{
+#if defined(MAP_HUGETLB)
+    size_t msize = roundup(size, PFILE_HUGE_PAGE_SIZE);
+    uint8_t *buffer;
+    size_t offset = 0;
+    ssize_t count;
+
+    buffer = mmap(NULL, msize, (PROT_READ | PROT_WRITE),
+		  (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
+    if (buffer == MAP_FAILED) {
+	if (dip->di_debug_flag) {
+	    Printf(dip, "Huge pages are not available for %u bytes, errno = %d\n", msize, errno);
+	}
+	return(NULL);
+    }
+    while (offset < size) {
+	count = pread(fd, (buffer + offset), (size - offset), (off_t)offset);
+	if (count <= 0) {
+	    (void)munmap(buffer, msize);
+	    return(NULL);
+	}
+	offset += count;
+    }
+    (void)mprotect(buffer, msize, PROT_READ);
+    *map_size = msize;
+    return(buffer);
+#else /* !defined(MAP_HUGETLB) */
+    return(NULL);
+#endif /* defined(MAP_HUGETLB) */
+}
+
+/*
+ * map_pattern_file() - Map a pattern file read-only (shared).
+ *
+ * Inputs:
+ * 	dip = The device information pointer.
+ *	file = Pointer to pattern file name.
+ *	size = The pattern file size.
+ *
+ * Return Value:
+ *	The mapped pattern buffer, or NULL if the file could not be mapped,
+ * in which case the caller should read the pattern file instead.
+ */
+uint8_t *
+map_pattern_file(dinfo_t *dip, char *file, size_t size)
+{
+    pfile_map_t *pmp;
+    struct stat sb;
+    uint8_t *buffer = NULL;
+    size_t map_size = size;
+    int fd, flags = MAP_SHARED;
+
+    if ( (size == 0) || (stat(file, &sb) == FAILURE) || !S_ISREG(sb.st_mode) ) {
+	return(NULL);
+    }
+    acquire_pfile_map_lock(dip);
+    for (pmp = pfile_maps; pmp; pmp = pmp->pm_next) {
+	if ( (pmp->pm_dev == sb.st_dev) && (pmp->pm_ino == sb.st_ino) &&
+	     (pmp->pm_mtime == sb.st_mtime) && (pmp->pm_size == size) ) {
+	    pmp->pm_refs++;
+	    release_pfile_map_lock(dip);
+	    return(pmp->pm_buffer);
+	}
+    }
+    if ( (fd = open(file, O_RDONLY)) == FAILURE) {
+	release_pfile_map_lock(dip);
+	return(NULL);
+    }
+    if (dip->di_pfhuge_flag == True) {
+	buffer = map_pattern_huge(dip, fd, size, &map_size);
+    }
+    if (buffer == NULL) {
+	map_size = size;
+#if defined(MAP_POPULATE)
+	flags |= MAP_POPULATE;		/* Prefault, avoid faults during I/O. */
+#endif /* defined(MAP_POPULATE) */
+	buffer = mmap(NULL, size, PROT_READ, flags, fd, (off_t)0);
+	if (buffer == MAP_FAILED) {
+	    if (dip->di_debug_flag) {
+		Printf(dip, "Failed to map pattern file %s, errno = %d\n", file, errno);
+	    }
+	    buffer = NULL;
+	}
+#if defined(MADV_HUGEPAGE)
+	else if (dip->di_pfhuge_flag == True) {
+	    (void)madvise(buffer, size, MADV_HUGEPAGE);
+	}
+#endif /* defined(MADV_HUGEPAGE) */
+    }
+    (void)close(fd);
+    if (buffer) {
+	pmp = Malloc(dip, sizeof(*pmp));
+	if (pmp == NULL) {
+	    (void)munmap(buffer, map_size);
+	    release_pfile_map_lock(dip);
+	    return(NULL);
+	}
+	pmp->pm_dev = sb.st_dev;
+	pmp->pm_ino = sb.st_ino;
+	pmp->pm_mtime = sb.st_mtime;
+	pmp->pm_size = size;
+	pmp->pm_map_size = map_size;
+	pmp->pm_buffer = buffer;
+	pmp->pm_refs = 1;
+	pmp->pm_next = pfile_maps;
+	pfile_maps = pmp;
+    }
+    release_pfile_map_lock(dip);
+    return(buffer);
+}
+
+/*
+ * hold_pattern_file() - Add a reference to a mapped pattern file.
+ */
+void
+hold_pattern_file(dinfo_t *dip, uint8_t *buffer)
+{
+    pfile_map_t *pmp;
+
+    acquire_pfile_map_lock(dip);
+    for (pmp = pfile_maps; pmp; pmp = pmp->pm_next) {
+	if (pmp->pm_buffer == buffer) {
+	    pmp->pm_refs++;
+	    break;
+	}
+    }
+    release_pfile_map_lock(dip);
+    return;
+}
+
+/*
+ * unmap_pattern_file() - Release a reference to a mapped pattern file.
+ *
+ * The pattern file is unmapped when the last reference is released.
+ */
+void
+unmap_pattern_file(dinfo_t *dip, uint8_t *buffer)
+{
+    pfile_map_t *pmp, **pmpp;
+
+    acquire_pfile_map_lock(dip);
+    for (pmpp = &pfile_maps; (pmp = *pmpp); pmpp = &pmp->pm_next) {
+	if (pmp->pm_buffer == buffer) {
+	    if (--pmp->pm_refs == 0) {
+		*pmpp = pmp->pm_next;
+		(void)munmap(pmp->pm_buffer, pmp->pm_map_size);
+		Free(dip, pmp);
+	    }
+	    break;
+	}
+    }
+    release_pfile_map_lock(dip);
+    return;
+}
+
+#else /* defined(WIN32) */
+
+uint8_t *
+map_pattern_file(dinfo_t *dip, char *file, size_t size)
+{
+    return(NULL);
+}
+
+void
+hold_pattern_file(dinfo_t *dip, uint8_t *buffer)
+{
+    return;
+}
+
+void
+unmap_pattern_file(dinfo_t *dip, uint8_t *buffer)
+{
+    return;
+}
+
+#endif /* !defined(WIN32) */
+
 /************************************************************************
  *									*
  * process_pfile() - Process a pattern file.				*
@@ -825,6 +1451,9 @@ copy_prefix( dinfo_t *dip, u_char *buffer, size_t bcount )
  * Return Value:							*
  *		Returns SUCCESS / FAILURE				*
  *									*
+ * Note: The pattern file is mapped shared (read-only) when possible,	*
+ *	 otherwise it's read into a private pattern buffer.		*
+ *									*
  ************************************************************************/
 int
 process_pfile(dinfo_t *dip, char *file)
@@ -842,6 +1471,13 @@ process_pfile(dinfo_t *dip, char *file)
     }
     size = (size_t)filesize;
 
+    if (dip->di_pfmap_flag == True) {
+	if ( (buffer = map_pattern_file(dip, file, size)) ) {
+	    setup_pattern(dip, buffer, size, True);
+	    dip->di_pattern_mapped = True;
+	    return(SUCCESS);
+	}
+    }
     fd = dt_open_file(dip, file, oflags, 0, NULL, NULL, True, False);
     if (fd == NoFd) {
 	return(FAILURE);
@@ -946,6 +1582,7 @@ setup_pattern(dinfo_t *dip, uint8_t *buffer, size_t size, hbool_t init_pattern)
     dip->di_pattern_bufptr = buffer;
     dip->di_pattern_bufend = (buffer + size);
     dip->di_pattern_bufsize = size;
+    dip->di_iot_deferred = False;	/* The deferred IOT data is gone. */
 
     if (init_pattern == False) return;
 
@@ -978,7 +1615,12 @@ void
 reset_pattern(dinfo_t *dip)
 {
     if (dip->di_pattern_buffer) {
-	free_palign(dip, dip->di_pattern_buffer);
+	if (dip->di_pattern_mapped == True) {
+	    unmap_pattern_file(dip, dip->di_pattern_buffer);
+	    dip->di_pattern_mapped = False;
+	} else {
+	    free_palign(dip, dip->di_pattern_buffer);
+	}
 	dip->di_pattern_buffer = NULL;
 	dip->di_pattern_bufptr = NULL;
 	dip->di_pattern_bufend = NULL;
@@ -1574,14 +2216,20 @@ do_random(struct dinfo *dip, hbool_t doseek, size_t xfer_size)
     /* The user alignment cannot be less than the required alignment! */
     ralign = roundup(ralign, align);
 
-    randum = get_random64(dip);
-
     /*
      * Set position so that the I/O is in the range from file_position to the
      * random data limit and is aligned to device, pattern, or user alignment.
      */
-    if (rlimit) {		/* This will be zero for a single block! */
-	pos = (Offset_t)(randum % rlimit);
+    if (dip->di_rdist.rd_type != RDIST_UNIFORM) {
+	/* Skewed distributions select an alignment unit within the limit. */
+	if (rlimit) {
+	    pos = (Offset_t)(random_distribution_index(dip, howmany(rlimit, ralign)) * ralign);
+	}
+    } else {
+	randum = get_random64(dip);
+	if (rlimit) {		/* This will be zero for a single block! */
+	    pos = (Offset_t)(randum % rlimit);
+	}
     }
     /* Round down, instead of up, to avoid end of file/media issues. */
     pos = rounddown(pos, ralign);
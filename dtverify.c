@@ -32,6 +32,19 @@
  *
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Always free the file system map after read-after-write errors, since
+ * overwrites (copy-on-write) may move extents without changing the size.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      For IOT, verify using the IOT formula when the expected data was
+ * deferred by init_iotdata(), generating the pattern only on mismatches.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Add vector compare fast paths to the normal, prefix, and lbdata
+ * verify functions. The byte by byte compares are now only used to locate
+ * and report the mismatch, so ReportCompareError() offsets are unchanged.
+ * 
  * March 8th, 2021 by Robin T. Miller
  *      When corruptions occur, if onerr=stop is enabled, stop other threads,
  * thereby reducing I/O in traces and expediting trigger(s) execution.
@@ -1585,6 +1598,15 @@ verify_data_normal(
     int status = SUCCESS;
 
     dip->di_saved_pattern_ptr = pptr;
+    /*
+     * Vector compare the buffer first, the byte by byte compare below
+     * is only used to locate and report the mismatch (if any).
+     */
+    if ( (dip->di_timestamp_flag == False) && (dip->di_pattern_in_buffer == False) ) {
+	if (compare_buffer(dip, buffer, count, NULL) == True) {
+	    return(status);
+	}
+    }
 
     while ( (i < count) ) {
 #if defined(TIMESTAMP)
@@ -1661,6 +1683,12 @@ verify_data_prefix(
     int status = SUCCESS;
 
     dip->di_saved_pattern_ptr = pptr;
+    /* Vector compare fast path, see verify_data_normal(). */
+    if ( (dip->di_timestamp_flag == False) && (dip->di_pattern_in_buffer == False) ) {
+	if (compare_buffer(dip, buffer, count, NULL) == True) {
+	    return(status);
+	}
+    }
 
     while ( (i < count) ) {
 	/*
@@ -1757,10 +1785,22 @@ verify_data_with_lba(
      * data which is incorrect. Timestamps always cause a mismatch!
      */
     if ( dip->di_iot_pattern && (dip->di_timestamp_flag == False) ) {
-        if (memcmp(pptr, vptr, count) == 0) {
+	if (dip->di_iot_deferred == True) {
+	    /* Compare against the IOT formula, else generate the expected data. */
+	    if ( (pptr == dip->di_pattern_buffer) && (verify_iotdata(dip, vptr, count) == True) ) {
+		*lba += (lbdata_t)(count / dip->di_lbdata_size);
+		return (status);
+	    }
+	    expand_iotdata(dip);
+	} else if (simd_compare_buffers(dip, pptr, vptr, count) == True) {
 	    *lba += (lbdata_t)(count / dip->di_lbdata_size);
 	    return (status);
 	}
+    } else if ( (dip->di_timestamp_flag == False) && (dip->di_pattern_in_buffer == False) ) {
+	/* Vector compare the prefix, lba, and pattern for lbdata too. */
+	if (compare_buffer(dip, buffer, count, lba) == True) {
+	    return(status);
+	}
     }
 
     /* Note: This is overloaded, and needs cleaned up via rewrite! */
@@ -31,6 +31,12 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Add pthread_cond_timedwait() and pthread_cond_destroy().
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Added os_map_range_to_lba() to map a range of file offsets.
+ * 
  * October 8th, 2025 by Robin T. Miller
  *      If trying to open the volume handle fails, disable file system mapping.
  * 
@@ -481,6 +487,42 @@ pthread_cond_wait(pthread_cond_t *cv, pthread_mutex_t *lock)
     return ret;
 }
 
+/*
+ * Like pthread_cond_wait(), but give up at the absolute time specified.
+ */
+int
+pthread_cond_timedwait(pthread_cond_t *cv, pthread_mutex_t *lock, const struct timespec *abstime)
+{
+    struct timeval now;
+    int64_t msecs;
+    DWORD dwRes;
+    int ret = 0;
+
+    (void)highresolutiontime(&now, NULL);
+    msecs = ((int64_t)(abstime->tv_sec - now.tv_sec) * MSECS) +
+	    ((abstime->tv_nsec / 1000000) - (now.tv_usec / 1000));
+    if (msecs < 0) msecs = 0;
+
+    dwRes = SignalObjectAndWait(*lock, cv->events_[SIGNAL], (DWORD)msecs, True);
+    if (dwRes == WAIT_TIMEOUT) {
+	ret = ETIMEDOUT;
+    } else if ( (dwRes == WAIT_ABANDONED) || (dwRes == 0xFFFFFFFF) ) {
+	return -1;
+    }
+    /* reacquire the lock */
+    WaitForSingleObject(*lock, INFINITE);
+
+    return ret;
+}
+
+int
+pthread_cond_destroy(pthread_cond_t *cv)
+{
+    (void)CloseHandle(cv->events_[SIGNAL]);
+    (void)CloseHandle(cv->events_[BROADCAST]);
+    return( PTHREAD_NORMAL_EXIT );
+}
+
 /* 
  * Try to release one waiting thread. 
  */
@@ -4082,3 +4124,18 @@ os_map_offset_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset)
     }
     return(lba);
 }
+
+int
+os_map_range_to_lba(dinfo_t *dip, HANDLE fd, uint32_t dsize, Offset_t offset,
+		    uint32_t step, uint64_t *lbas, int count)
+{
+    int index;
+
+    if (os_get_file_map(dip, fd) == NULL) {
+	return(FAILURE);
+    }
+    for (index = 0; index < count; index++, offset += step) {
+	lbas[index] = os_map_offset_to_lba(dip, fd, dsize, offset);
+    }
+    return(SUCCESS);
+}
@@ -177,6 +177,8 @@ extern int pthread_cond_init(pthread_cond_t *cv, const void *dummy);
 extern int pthread_cond_broadcast(pthread_cond_t *cv);
 extern int pthread_cond_signal(pthread_cond_t *cv);
 extern int pthread_cond_wait(pthread_cond_t *cv, pthread_mutex_t *lock);
+extern int pthread_cond_timedwait(pthread_cond_t *cv, pthread_mutex_t *lock, const struct timespec *abstime);
+extern int pthread_cond_destroy(pthread_cond_t *cv);
 extern int pthread_join(pthread_t thread, void **exit_value);
 extern os_tid_t pthread_self(void);
 
@@ -435,6 +437,17 @@ extern char *FindScsiDevice(char *device);
 #define os_mapDiskFullError(error) ENOSPC
 #define os_isStreamsUnsupported(error) ( ((error == ERROR_INVALID_NAME) || (error == ERROR_FILE_NOT_FOUND)) ? True : False)
 
+/* Atomic add, returning the previous value. */
+#define os_atomic_fetch_add64(ptr, value) \
+	(large_t)InterlockedExchangeAdd64((volatile LONG64 *)(ptr), (LONG64)(value))
+/* Atomic compare and swap, returning the previous value. */
+#define os_atomic_cas64(ptr, expected, desired) \
+	(large_t)InterlockedCompareExchange64((volatile LONG64 *)(ptr), (LONG64)(desired), (LONG64)(expected))
+#define os_atomic_load64(ptr) \
+	(uint64_t)InterlockedCompareExchange64((volatile LONG64 *)(ptr), 0, 0)
+#define os_atomic_store64(ptr, value) \
+	(void)InterlockedExchange64((volatile LONG64 *)(ptr), (LONG64)(value))
+
 #define os_tperror		tPerror
 #define os_get_error()		GetLastError()
 #define os_set_error(error)	SetLastError(error)
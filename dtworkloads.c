@@ -124,7 +124,6 @@ workload_entry_t predefined_workloads[] =
 	"Create incrementing file sizes (requires ~1.36g space)",
 	"files=256 min=b max=1m limit=64m prefix=%d@%h pattern=iot enable=fsincr dispose=keep"
     },
-    /* Note: Percentages is NOT implemented for AIO at this time! */
     {	"file_percentages",
 	"Single file with read/write and random/sequential percentages",
 	"bs=random limit=1g enable=btags flags=direct onerr=abort slices=10 readp=-1 randp=50 dispose=keep"
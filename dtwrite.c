@@ -31,6 +31,19 @@
  * 
  * Modification History:
  * 
+ * October 16th, 2026 by Robin T. Miller
+ *      With iolock threads, stop all threads as soon as end of file or file
+ * system full is seen, rather than after their claimed records (iochunk=).
+ * 
+ * October 16th, 2026 by Robin T. Miller
+ *      Pass the bytes transferred to update_latency_stats() for time series.
+ * 
+ * October 15th, 2026 by Robin T. Miller
+ *      Use update_latency_stats(), which also records the latency histogram.
+ *
+ * October 15th, 2026 by Robin T. Miller
+ *      Claim forward fixed size records without the I/O lock (atomics).
+ *
  * January 8th, 2026 by Robin T. Miller
  *      Minor updates for MacOS without SCSI support.
  *
@@ -827,7 +840,7 @@ write_data_iolock(struct dinfo *dip)
     struct dtfuncs *dtf = dip->di_funcs;
     io_global_data_t *iogp = dip->di_job->ji_opaque;
     register ssize_t count;
-    register size_t bsize, dsize;
+    size_t bsize, dsize;
     large_t data_limit;
     int status = SUCCESS;
     Offset_t lock_offset = 0;
@@ -840,6 +853,7 @@ write_data_iolock(struct dinfo *dip)
     int random_percentage = dip->di_random_percentage;
     hbool_t compare_flag = dip->di_compare_flag;
     hbool_t percentages_flag = False;
+    hbool_t lockfree_flag = False;
     hbool_t read_after_write_flag = dip->di_raw_flag;
     uint64_t loop_usecs;
     u_long io_record = 0;
@@ -903,13 +917,23 @@ write_data_iolock(struct dinfo *dip)
         }
     }
 
+    /*
+     * Forward fixed size records are claimed without the I/O lock.
+     */
+    if ( (percentages_flag == False) && (dip->di_io_dir == FORWARD) &&
+	 (dip->di_step_offset == 0) && (dip->di_min_size == 0) ) {
+	lockfree_flag = True;
+	dip->di_iochunk_next = dip->di_iochunk_end = 0;
+    }
+
     /*
      * Now write the specifed number of records.
      */
-    while ( (iogp->io_end_of_file == False) &&
-	    (dip->di_error_count < dip->di_error_limit) &&
-	    (iogp->io_bytes_written < data_limit) &&
-	    (iogp->io_records_written < dip->di_record_limit) ) {
+    while ( (dip->di_error_count < dip->di_error_limit) &&
+	    (iogp->io_end_of_file == False) &&
+	    ( ((lockfree_flag == True) && (dip->di_iochunk_next < dip->di_iochunk_end)) ||
+	      ((iogp->io_bytes_written < data_limit) &&
+	       (iogp->io_records_written < dip->di_record_limit)) ) ) {
 
 	PAUSE_THREAD(dip);
 	if ( THREAD_TERMINATING(dip) ) break;
@@ -933,148 +957,156 @@ write_data_iolock(struct dinfo *dip)
 	    break;
 	}
 
-	(void)dt_acquire_iolock(dip, iogp);
-	/*
-	 * With multiple threads, we must check limits after unlocking.
-	 */
-	if ( (iogp->io_end_of_file == True) ||
-	     (iogp->io_bytes_written >= data_limit) ||
-	     (iogp->io_records_written >= dip->di_record_limit) ) {
-	    set_Eof(dip);
-	    iogp->io_end_of_file = dip->di_end_of_file;
-	    (void)dt_release_iolock(dip, iogp);
-	    break;
-	}
-
-	/*
-	 * Setup for read/write and/or random/sequential percentages (if enabled).
-	 */
-	if (percentages_flag) {
-	    int read_percentage = dip->di_read_percentage;
-
-	    if ( ((iogp->io_bytes_read + iogp->io_bytes_written) >= data_limit) ||
-		 ((iogp->io_records_read + iogp->io_records_written) >= dip->di_record_limit) ) {
+	if (lockfree_flag == True) {
+	    if (dt_claim_iorange(dip, iogp, &iogp->io_bytes_written, &iogp->io_records_written,
+				 dsize, data_limit, &bsize, &io_record) == False) {
+		set_Eof(dip);
+		break;
+	    }
+	} else {
+	    (void)dt_acquire_iolock(dip, iogp);
+	    /*
+	     * With multiple threads, we must check limits after unlocking.
+	     */
+	    if ( (iogp->io_end_of_file == True) ||
+		 (iogp->io_bytes_written >= data_limit) ||
+		 (iogp->io_records_written >= dip->di_record_limit) ) {
 		set_Eof(dip);
 		iogp->io_end_of_file = dip->di_end_of_file;
 		(void)dt_release_iolock(dip, iogp);
 		break;
 	    }
-	    if (read_percentage == -1) {
-		read_percentage = (int)(get_random(dip) % 100);
-	    }
-	    if (read_percentage) {
-		probability_reads  = (int)(get_random(dip) % 100);
-	    }
-	    probability_random = (int)(get_random(dip) % 100);
 
-	    if (probability_reads < read_percentage) {
-		optype = READ_OP;
-		dip->di_mode = READ_MODE;
-		compare_flag = False;
-		read_after_write_flag = False;
-		if (dip->di_min_size == 0) {
-		    dsize = get_data_size(dip, optype);
+	    /*
+	     * Setup for read/write and/or random/sequential percentages (if enabled).
+	     */
+	    if (percentages_flag) {
+		int read_percentage = dip->di_read_percentage;
+
+		if ( ((iogp->io_bytes_read + iogp->io_bytes_written) >= data_limit) ||
+		     ((iogp->io_records_read + iogp->io_records_written) >= dip->di_record_limit) ) {
+		    set_Eof(dip);
+		    iogp->io_end_of_file = dip->di_end_of_file;
+		    (void)dt_release_iolock(dip, iogp);
+		    break;
 		}
-	    } else {
-		optype = WRITE_OP;
-		dip->di_mode = WRITE_MODE;
-		compare_flag = dip->di_compare_flag;
-		if (dip->di_verify_flag == True) {
-		    read_after_write_flag = dip->di_raw_flag;
-		} else {
-		    /* Writing only, no reading/verifying! */
+		if (read_percentage == -1) {
+		    read_percentage = (int)(get_random(dip) % 100);
+		}
+		if (read_percentage) {
+		    probability_reads  = (int)(get_random(dip) % 100);
+		}
+		probability_random = (int)(get_random(dip) % 100);
+
+		if (probability_reads < read_percentage) {
+		    optype = READ_OP;
+		    dip->di_mode = READ_MODE;
+		    compare_flag = False;
 		    read_after_write_flag = False;
+		    if (dip->di_min_size == 0) {
+			dsize = get_data_size(dip, optype);
+		    }
+		} else {
+		    optype = WRITE_OP;
+		    dip->di_mode = WRITE_MODE;
+		    compare_flag = dip->di_compare_flag;
+		    if (dip->di_verify_flag == True) {
+			read_after_write_flag = dip->di_raw_flag;
+		    } else {
+			/* Writing only, no reading/verifying! */
+			read_after_write_flag = False;
+		    }
+		    if (dip->di_min_size == 0) {
+			dsize = get_data_size(dip, optype);
+		    }
 		}
-		if (dip->di_min_size == 0) {
-		    dsize = get_data_size(dip, optype);
+		if ( (optype == READ_OP) && dip->di_random_rpercentage) {
+		    random_percentage = dip->di_random_rpercentage;
+		} else if ((optype == WRITE_OP) && dip->di_random_wpercentage) {
+		    random_percentage = dip->di_random_wpercentage;
+		} else {
+		    random_percentage = dip->di_random_percentage;
 		}
-	    }
-	    if ( (optype == READ_OP) && dip->di_random_rpercentage) {
-		random_percentage = dip->di_random_rpercentage;
-	    } else if ((optype == WRITE_OP) && dip->di_random_wpercentage) {
-		random_percentage = dip->di_random_wpercentage;
-	    } else {
-		random_percentage = dip->di_random_percentage;
-	    }
-	    if ( (iogp->io_bytes_read + iogp->io_bytes_written + dsize) > data_limit) {
-		bsize = (size_t)(data_limit - (iogp->io_bytes_read + iogp->io_bytes_written));
-	    } else {
-		bsize = dsize;
-	    }
-	    if (probability_random < random_percentage) {
-		iotype = RANDOM_IO;
-	    } else {
-		iotype = SEQUENTIAL_IO;
-		dip->di_offset = iogp->io_sequential_offset;
-		if (dip->di_io_dir == REVERSE) {
-		    bsize = MIN((size_t)(iogp->io_sequential_offset - dip->di_file_position), bsize);
-		    dip->di_offset = set_position(dip, (Offset_t)(iogp->io_sequential_offset - bsize), False);
-		    iogp->io_sequential_offset = dip->di_offset;
+		if ( (iogp->io_bytes_read + iogp->io_bytes_written + dsize) > data_limit) {
+		    bsize = (size_t)(data_limit - (iogp->io_bytes_read + iogp->io_bytes_written));
 		} else {
-		    iogp->io_sequential_offset += bsize;
+		    bsize = dsize;
 		}
-	    }
-	    if (optype == READ_OP) {
-		iogp->io_bytes_read += bsize;
-		iogp->io_records_read++;
-		io_record = iogp->io_records_read;
-	    } else {
-		iogp->io_bytes_written += bsize;
-		iogp->io_records_written++;
-		io_record = iogp->io_records_written;
-	    }
-	} else { /* percentages_flag is False */
-	    if ( (iogp->io_bytes_written + dsize) > data_limit) {
-		bsize = (size_t)(data_limit - iogp->io_bytes_written);
-	    } else {
-		bsize = dsize;
-	    }
-	    if (iotype == SEQUENTIAL_IO) {
-		dip->di_offset = iogp->io_sequential_offset;
-		if (dip->di_io_dir == REVERSE) {
-		    bsize = MIN((size_t)(dip->di_offset - dip->di_file_position), bsize);
-		    dip->di_offset = set_position(dip, (Offset_t)(dip->di_offset - bsize), False);
-		    iogp->io_sequential_offset = dip->di_offset;
+		if (probability_random < random_percentage) {
+		    iotype = RANDOM_IO;
 		} else {
-		    iogp->io_sequential_offset += bsize;
+		    iotype = SEQUENTIAL_IO;
+		    dip->di_offset = iogp->io_sequential_offset;
+		    if (dip->di_io_dir == REVERSE) {
+			bsize = MIN((size_t)(iogp->io_sequential_offset - dip->di_file_position), bsize);
+			dip->di_offset = set_position(dip, (Offset_t)(iogp->io_sequential_offset - bsize), False);
+			iogp->io_sequential_offset = dip->di_offset;
+		    } else {
+			iogp->io_sequential_offset += bsize;
+		    }
 		}
-	    }
-	    /* Note: Must set these before I/O for other threads! */
-	    iogp->io_bytes_written += bsize;
-	    iogp->io_records_written++;
-	    io_record = iogp->io_records_written;
-	} /* end of percentages_flag */
-
-	if ( (iotype == SEQUENTIAL_IO) && dip->di_step_offset) {
-	    Offset_t offset = iogp->io_sequential_offset;
-	    if (dip->di_io_dir == FORWARD) {
-		/* Note: Useful for debug, but we don't need to set position! */
-		offset = set_position(dip, (offset + dip->di_step_offset), True);
-		/* Linux returns EINVAL when seeking too far! */
-		if (offset == (Offset_t)-1) {
-		    set_Eof(dip);
-		    break;
+		if (optype == READ_OP) {
+		    iogp->io_bytes_read += bsize;
+		    iogp->io_records_read++;
+		    io_record = iogp->io_records_read;
+		} else {
+		    iogp->io_bytes_written += bsize;
+		    iogp->io_records_written++;
+		    io_record = iogp->io_records_written;
 		}
-		/* 
-		 * This check prevents us from writing past the end of a slice.
-		 * Note: Without slices, we expect to encounter end of file/media.
-		 */ 
-		if ( dip->di_slices &&
-		     ((offset + (Offset_t)dsize) >= dip->di_end_position) ) {
-		    set_Eof(dip);
-		    break;
+	    } else { /* percentages_flag is False */
+		if ( (iogp->io_bytes_written + dsize) > data_limit) {
+		    bsize = (size_t)(data_limit - iogp->io_bytes_written);
+		} else {
+		    bsize = dsize;
 		}
-	    } else { /* io_dir = REVERSE */
-		offset -= dip->di_step_offset;
-		if (offset <= (Offset_t)dip->di_file_position) {
-		    set_Eof(dip);
-		    dip->di_beginning_of_file = True;
-		    break;
+		if (iotype == SEQUENTIAL_IO) {
+		    dip->di_offset = iogp->io_sequential_offset;
+		    if (dip->di_io_dir == REVERSE) {
+			bsize = MIN((size_t)(dip->di_offset - dip->di_file_position), bsize);
+			dip->di_offset = set_position(dip, (Offset_t)(dip->di_offset - bsize), False);
+			iogp->io_sequential_offset = dip->di_offset;
+		    } else {
+			iogp->io_sequential_offset += bsize;
+		    }
 		}
+		/* Note: Must set these before I/O for other threads! */
+		iogp->io_bytes_written += bsize;
+		iogp->io_records_written++;
+		io_record = iogp->io_records_written;
+	    } /* end of percentages_flag */
+
+	    if ( (iotype == SEQUENTIAL_IO) && dip->di_step_offset) {
+		Offset_t offset = iogp->io_sequential_offset;
+		if (dip->di_io_dir == FORWARD) {
+		    /* Note: Useful for debug, but we don't need to set position! */
+		    offset = set_position(dip, (offset + dip->di_step_offset), True);
+		    /* Linux returns EINVAL when seeking too far! */
+		    if (offset == (Offset_t)-1) {
+			set_Eof(dip);
+			break;
+		    }
+		    /* 
+		     * This check prevents us from writing past the end of a slice.
+		     * Note: Without slices, we expect to encounter end of file/media.
+		     */ 
+		    if ( dip->di_slices &&
+			 ((offset + (Offset_t)dsize) >= dip->di_end_position) ) {
+			set_Eof(dip);
+			break;
+		    }
+		} else { /* io_dir = REVERSE */
+		    offset -= dip->di_step_offset;
+		    if (offset <= (Offset_t)dip->di_file_position) {
+			set_Eof(dip);
+			dip->di_beginning_of_file = True;
+			break;
+		    }
+		}
+		iogp->io_sequential_offset = offset;
 	    }
-	    iogp->io_sequential_offset = offset;
+	    (void)dt_release_iolock(dip, iogp);
 	}
-	(void)dt_release_iolock(dip, iogp);
 
 	if (dip->di_write_delay) {
 	    mySleep(dip, dip->di_write_delay);
@@ -1161,7 +1193,11 @@ write_data_iolock(struct dinfo *dip)
 	    }
 	} while (status == RETRYABLE);
 
-	if (dip->di_end_of_file) break;
+	/* Stop the other threads now, rather than after their claims. */
+	if (dip->di_end_of_file) {
+	    iogp->io_end_of_file = True;
+	    break;
+	}
 
 	if (status == FAILURE) {
 	    if (dip->di_error_count >= dip->di_error_limit) break;
@@ -1244,6 +1280,7 @@ write_data_iolock(struct dinfo *dip)
 	    dip->di_no_space_left = True;
 	    dip->di_file_system_full = True;
 	    set_Eof(dip);
+	    iogp->io_end_of_file = True;
 	    break;
 	}
 
@@ -1293,7 +1330,16 @@ write_data_iolock(struct dinfo *dip)
     if (dip->di_end_of_file == False) {
 	set_Eof(dip);
     }
-    iogp->io_end_of_file = dip->di_end_of_file;
+    /*
+     * Once the limits are claimed, other threads must finish their claims,
+     * so only propagate end of file when stopping early (error, EOF, etc).
+     */
+    if ( (lockfree_flag == False) ||
+	 (dip->di_iochunk_next < dip->di_iochunk_end) ||
+	 ( (iogp->io_bytes_written < data_limit) &&
+	   (iogp->io_records_written < dip->di_record_limit) ) ) {
+	iogp->io_end_of_file = dip->di_end_of_file;
+    }
 
     if (lock_full_range == True) {
 	int rc = dt_lock_unlock(dip, dip->di_dname, &dip->di_fd,
@@ -1514,22 +1560,7 @@ retry:
 	*status = check_write(dip, count, bsize, offset);
     }
     /* Latency */
-    if ( latency < dip->di_min_latency ) {
-        dip->di_min_latency = latency;
-    }
-    if ( latency > dip->di_max_latency ) {
-        dip->di_max_latency = latency;
-    }
-    dip->di_total_latency_ios++;
-    dip->di_total_latency += latency;
-    dip->di_write_latency_ios++;
-    dip->di_write_latency += latency;
-    if ( latency < dip->di_min_write_latency ) {
-        dip->di_min_write_latency = latency;
-    }
-    if ( latency > dip->di_max_write_latency ) {
-        dip->di_max_write_latency = latency;
-    }
+    update_latency_stats(dip, WRITE_OP, latency, count);
     if ( dip->di_latency_frequency || dip->di_latency_minimum || dip->di_latency_maximum ) {
         char *text;
         if ( dip->di_latency_minimum && (latency < dip->di_latency_minimum) ) {
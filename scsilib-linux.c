@@ -32,6 +32,11 @@
  *
  * Modification History:
  *
+ * October 15th, 2026 by Robin T. Miller
+ *      Add os_spt_submit() and os_spt_reap(), for asynchronous SCSI I/O via
+ * the sg driver write()/read() interface, sharing the request setup and
+ * completion status with os_spt().
+ *
  * May 13th, 2020 by Robin T. Miller
  *      Fix parameters for sending SG_SCSI_RESET_TARGET (device reset) ioctl().
  * 
@@ -516,27 +521,15 @@ os_set_qdepth(scsi_generic_t *sgp, unsigned int qdepth)
 }
 
 /*
- * os_spt() - OS Specific SCSI Pass-Through (spt).
- *
- * Description:
- *  This function takes a high level SCSI command, converts it
- * into the format necessary for this OS, then executes it and
- * returns an OS independent format to the caller.
+ * linux_setup_sgio() - Setup the SCSI Generic I/O Header.
  *
  * Inputs:
  *      sgp = Pointer to the SCSI generic data structure.
- *
- * Return Value:
- *      Returns the status from the SCSI request which is:
- *        0 = Success, -1 = Failure
+ *      siop = Pointer to the SCSI generic I/O header.
  */
-int
-os_spt(scsi_generic_t *sgp)
+static void
+linux_setup_sgio(scsi_generic_t *sgp, sg_io_hdr_t *siop)
 {
-    sg_io_hdr_t sgio;
-    sg_io_hdr_t *siop = &sgio;
-    int error;
-
     memset(siop, 0, sizeof(*siop));
 
     siop->interface_id = 'S';
@@ -563,23 +556,23 @@ os_spt(scsi_generic_t *sgp)
     }
     siop->mx_sb_len = sgp->sense_length;
     siop->timeout   = sgp->timeout;    /* Timeout in milliseconds. */
+    return;
+}
 
-    /*
-     * Finally, execute the SCSI command:
-     */
-    error = ioctl(sgp->fd, SG_IO, siop);
-
-    /*
-     * Handle errors, and send pertinent data back to the caller.
-     */
-    if (error < 0) {
-	sgp->os_error = errno;
-	if (sgp->errlog == True) {
-	    os_perror(sgp->opaque, "SCSI request (SG_IO) failed on %s!", sgp->dsf);
-	}
-	sgp->error = True;
-	goto error;
-    }
+/*
+ * linux_complete_sgio() - Complete the SCSI Generic I/O Request.
+ *
+ * Description:
+ *  Send the pertinent status from the SCSI generic I/O header back
+ * to the caller, in the OS independent format.
+ *
+ * Inputs:
+ *      sgp = Pointer to the SCSI generic data structure.
+ *      siop = Pointer to the completed SCSI generic I/O header.
+ */
+static void
+linux_complete_sgio(scsi_generic_t *sgp, sg_io_hdr_t *siop)
+{
     if (siop->status == SCSI_GOOD) {
 	sgp->error = False; /* Show SCSI command was successful. */
     } else {
@@ -611,6 +604,50 @@ os_spt(scsi_generic_t *sgp)
     sgp->duration      = siop->duration;
     sgp->host_status   = siop->host_status;
     sgp->driver_status = siop->driver_status;
+    return;
+}
+
+/*
+ * os_spt() - OS Specific SCSI Pass-Through (spt).
+ *
+ * Description:
+ *  This function takes a high level SCSI command, converts it
+ * into the format necessary for this OS, then executes it and
+ * returns an OS independent format to the caller.
+ *
+ * Inputs:
+ *      sgp = Pointer to the SCSI generic data structure.
+ *
+ * Return Value:
+ *      Returns the status from the SCSI request which is:
+ *        0 = Success, -1 = Failure
+ */
+int
+os_spt(scsi_generic_t *sgp)
+{
+    sg_io_hdr_t sgio;
+    sg_io_hdr_t *siop = &sgio;
+    int error;
+
+    linux_setup_sgio(sgp, siop);
+
+    /*
+     * Finally, execute the SCSI command:
+     */
+    error = ioctl(sgp->fd, SG_IO, siop);
+
+    /*
+     * Handle errors, and send pertinent data back to the caller.
+     */
+    if (error < 0) {
+	sgp->os_error = errno;
+	if (sgp->errlog == True) {
+	    os_perror(sgp->opaque, "SCSI request (SG_IO) failed on %s!", sgp->dsf);
+	}
+	sgp->error = True;
+	goto error;
+    }
+    linux_complete_sgio(sgp, siop);
 error:
     if (sgp->debug == True) {
 	DumpScsiCmd(sgp, siop);
@@ -618,6 +655,109 @@ error:
     return(error);
 }
 
+/*
+ * os_spt_async_supported() - Asynchronous SCSI Pass-Through Supported?
+ *
+ * Description:
+ *  Only the sg driver supports the asynchronous write()/read() interface.
+ * Please Note: Writing the SCSI generic header to a block device (/dev/sdX)
+ * would write the header as data, so this check is *very* important!
+ *
+ * Return Value:
+ *      Returns True if supported, otherwise False.
+ */
+hbool_t
+os_spt_async_supported(scsi_generic_t *sgp)
+{
+    return( (strncmp(sgp->dsf, SG_PATH_PREFIX, SG_PATH_SIZE) == 0) ? True : False );
+}
+
+/*
+ * os_spt_submit() - Submit an Asynchronous SCSI Pass-Through Request.
+ *
+ * Description:
+ *  The request is written to the sg device, and completes in the background.
+ * The SCSI generic pointer is saved in the request, so os_spt_reap() can
+ * return the status to the caller, when the request completes.
+ *
+ * Inputs:
+ *      sgp = Pointer to the SCSI generic data structure.
+ *      pack_id = The caller's request identifier.
+ *
+ * Return Value:
+ *      Returns 0 = Success, -1 = Failure
+ */
+int
+os_spt_submit(scsi_generic_t *sgp, int pack_id)
+{
+    sg_io_hdr_t sgio;
+    sg_io_hdr_t *siop = &sgio;
+    ssize_t count;
+
+    if (os_spt_async_supported(sgp) == False) {
+	sgp->os_error = errno = EINVAL;
+	sgp->error = True;
+	return(FAILURE);
+    }
+    linux_setup_sgio(sgp, siop);
+    siop->pack_id = pack_id;
+    siop->usr_ptr = sgp;
+
+    do {
+	count = write(sgp->fd, siop, sizeof(*siop));
+    } while ( (count < 0) && (errno == EINTR) );
+
+    if (count < 0) {
+	sgp->os_error = errno;
+	if (sgp->errlog == True) {
+	    os_perror(sgp->opaque, "SCSI request (sg write) failed on %s!", sgp->dsf);
+	}
+	sgp->error = True;
+	return(FAILURE);
+    }
+    return(SUCCESS);
+}
+
+/*
+ * os_spt_reap() - Reap a Completed Asynchronous SCSI Pass-Through Request.
+ *
+ * Description:
+ *  Any completed request is returned, since requests may complete in
+ * any order. The device is opened non-blocking, so EAGAIN is returned
+ * when no requests have completed (poll for POLLIN to wait).
+ *
+ * Inputs:
+ *      fd = The sg device file descriptor.
+ *      error = Pointer to return the errno (on failure).
+ *
+ * Return Value:
+ *      Returns the completed SCSI generic pointer, or NULL on failure.
+ */
+scsi_generic_t *
+os_spt_reap(HANDLE fd, int *error)
+{
+    sg_io_hdr_t sgio;
+    sg_io_hdr_t *siop = &sgio;
+    scsi_generic_t *sgp;
+    ssize_t count;
+
+    memset(siop, 0, sizeof(*siop));
+    siop->interface_id = 'S';
+    siop->pack_id = -1;			/* Return any completed request. */
+
+    count = read(fd, siop, sizeof(*siop));
+    if (count < 0) {
+	*error = errno;
+	return(NULL);
+    }
+    sgp = (scsi_generic_t *)siop->usr_ptr;
+    linux_complete_sgio(sgp, siop);
+    if (sgp->debug == True) {
+	DumpScsiCmd(sgp, siop);
+    }
+    return(sgp);
+}
+
 /*
  * Defines snarf'ed from src/linux/drivers/scsi/scsi.h since
  * they are not (currently) exported to user space :-)
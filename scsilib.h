@@ -46,6 +46,11 @@ extern int os_spt(scsi_generic_t *sgp);
 #if defined(_AIX)
 extern int os_spta(scsi_generic_t *sgp);
 #endif /* defined(_AIX) */
+#if defined(__linux__)
+extern hbool_t os_spt_async_supported(scsi_generic_t *sgp);
+extern int os_spt_submit(scsi_generic_t *sgp, int pack_id);
+extern scsi_generic_t *os_spt_reap(HANDLE fd, int *error);
+#endif /* defined(__linux__) */
 extern hbool_t os_is_retriable(scsi_generic_t *sgp);
 extern char *os_host_status_msg(scsi_generic_t *sgp);
 extern char *os_driver_status_msg(scsi_generic_t *sgp);